@@ -0,0 +1,100 @@
+// Compare how cluster spreads connections over workers: one accept queue
+// shared by all workers, master round-robin, or SO_REUSEPORT per worker.
+// Every request uses a new connection so each one is scheduled. Reports
+// requests/sec and prints the p99 latency and per-worker request counts.
+var common = require('../common.js');
+var PORT = common.PORT;
+
+var cluster = require('cluster');
+var http = require('http');
+
+if (cluster.isMaster) {
+  var bench = common.createBenchmark(main, {
+    sched: ['shared', 'rr', 'reuseport'],
+    workers: [2, 4],
+    c: [50, 200],
+    dur: [5]
+  });
+} else {
+  http.createServer(function(req, res) {
+    res.writeHead(200, {
+      'Content-Type': 'text/plain',
+      'Content-Length': 2,
+      'X-Worker': cluster.worker.id
+    });
+    res.end('ok');
+  }).listen(PORT);
+}
+
+function main(conf) {
+  cluster.setupMaster({
+    roundRobin: conf.sched === 'rr',
+    reusePort: conf.sched === 'reuseport'
+  });
+
+  var listening = 0;
+  for (var i = 0; i < conf.workers; i++)
+    cluster.fork();
+
+  cluster.on('listening', function() {
+    if (++listening === conf.workers)
+      setTimeout(run, 100);
+  });
+
+  function run() {
+    var latencies = [];
+    var perWorker = {};
+    var running = true;
+    var inflight = 0;
+
+    for (var i = 0; i < conf.c; i++)
+      request();
+
+    bench.start();
+    setTimeout(function() {
+      running = false;
+    }, conf.dur * 1000);
+
+    function request() {
+      var start = process.hrtime();
+      inflight++;
+      var req = http.get({
+        port: PORT,
+        path: '/',
+        agent: false
+      }, function(res) {
+        var id = res.headers['x-worker'];
+        perWorker[id] = (perWorker[id] || 0) + 1;
+        res.resume();
+        res.on('end', function() {
+          var t = process.hrtime(start);
+          latencies.push(t[0] * 1e3 + t[1] / 1e6);
+          done();
+        });
+      });
+      req.on('error', done);
+    }
+
+    function done() {
+      inflight--;
+      if (running)
+        return request();
+      if (inflight === 0)
+        finish();
+    }
+
+    function finish() {
+      latencies.sort(function(a, b) { return a - b; });
+      var p99 = latencies[Math.floor(latencies.length * 0.99)] || 0;
+      var dist = Object.keys(perWorker).map(function(id) {
+        return id + '=' + perWorker[id];
+      }).join(' ');
+      console.log('  p99 latency: %s ms, requests per worker: %s',
+                  p99.toFixed(2), dist);
+      Object.keys(cluster.workers).forEach(function(id) {
+        cluster.workers[id].destroy();
+      });
+      bench.end(latencies.length);
+    }
+  }
+}
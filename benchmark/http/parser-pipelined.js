@@ -0,0 +1,57 @@
+// Parse a buffer of pipelined requests, either through the per-event
+// callbacks that lib/http.js uses, or with executeBatch(), which returns
+// every message in one go. Reports requests per second.
+
+var common = require('../common.js');
+var HTTPParser = process.binding('http_parser').HTTPParser;
+
+var bench = common.createBenchmark(main, {
+  mode: ['callback', 'batch'],
+  pipeline: [1, 16, 64],
+  body: [0, 64],
+  n: [1e5]
+});
+
+function buildRequests(count, bodyLength) {
+  var body = new Array(bodyLength + 1).join('x');
+  var request = (bodyLength ? 'POST' : 'GET') + ' /hello/world HTTP/1.1\r\n' +
+                'Host: localhost:8000\r\n' +
+                'User-Agent: benchmark\r\n' +
+                'Accept: */*\r\n' +
+                'Connection: keep-alive\r\n' +
+                'Content-Length: ' + bodyLength + '\r\n' +
+                '\r\n' +
+                body;
+  return new Buffer(new Array(count + 1).join(request));
+}
+
+function main(conf) {
+  var pipeline = +conf.pipeline;
+  var n = +conf.n;
+  var buf = buildRequests(pipeline, +conf.body);
+  var rounds = Math.ceil(n / pipeline);
+  var parser = new HTTPParser(HTTPParser.REQUEST);
+  var seen = 0;
+
+  if (conf.mode === 'callback') {
+    parser.onHeadersComplete = function(info) {
+      return false;
+    };
+    parser.onBody = function(b, start, len) {
+    };
+    parser.onMessageComplete = function() {
+      seen++;
+    };
+  }
+
+  bench.start();
+  for (var i = 0; i < rounds; i++) {
+    if (conf.mode === 'batch') {
+      var messages = parser.executeBatch(buf, 0, buf.length).messages;
+      seen += messages.length;
+    } else {
+      parser.execute(buf, 0, buf.length);
+    }
+  }
+  bench.end(seen);
+}
@@ -2,10 +2,11 @@ var common = require('../common.js');
 var bench = common.createBenchmark(main, {
   dur: [5],
   type: ['buf', 'asc', 'utf'],
-  size: [2, 1024, 1024 * 1024]
+  size: [2, 1024, 1024 * 1024],
+  native: [0, 1]
 });
 
-var dur, type, encoding, size;
+var dur, type, encoding, size, nativeTLS;
 var server;
 
 var path = require('path');
@@ -18,6 +19,7 @@ function main(conf) {
   dur = +conf.dur;
   type = conf.type;
   size = +conf.size;
+  nativeTLS = !!+conf.native;
 
   var chunk;
   switch (type) {
@@ -39,12 +41,14 @@ function main(conf) {
 
   options = { key: fs.readFileSync(cert_dir + '/test_key.pem'),
               cert: fs.readFileSync(cert_dir + '/test_cert.pem'),
-              ca: [ fs.readFileSync(cert_dir + '/test_ca.pem') ] };
+              ca: [ fs.readFileSync(cert_dir + '/test_ca.pem') ],
+              nativeTLS: nativeTLS };
 
   server = tls.createServer(options, onConnection);
   setTimeout(done, dur * 1000);
   server.listen(common.PORT, function() {
-    var opt = { port: common.PORT, rejectUnauthorized: false };
+    var opt = { port: common.PORT, rejectUnauthorized: false,
+                nativeTLS: nativeTLS };
     var conn = tls.connect(opt, function() {
       bench.start();
       conn.on('drain', write);
@@ -56,6 +56,7 @@ OBJS += src/unix/udp.o
 OBJS += src/fs-poll.o
 OBJS += src/uv-common.o
 OBJS += src/inet.o
+OBJS += src/timer-wheel.o
 OBJS += src/version.o
 
 ifeq (sunos,$(PLATFORM))
@@ -102,6 +103,7 @@ LDFLAGS+=-ldl -lrt
 RUNNER_CFLAGS += -D_GNU_SOURCE
 OBJS += src/unix/linux-core.o \
         src/unix/linux-inotify.o \
+        src/unix/linux-iouring.o \
         src/unix/linux-syscalls.o \
         src/unix/proctitle.o
 endif
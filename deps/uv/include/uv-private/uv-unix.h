@@ -95,6 +95,8 @@ struct uv__work {
   void (*done)(struct uv__work *w, int status);
   struct uv_loop_s* loop;
   ngx_queue_t wq;
+  int work_class;
+  uint64_t queued_at;
 };
 
 #ifndef UV_PLATFORM_SEM_T
@@ -204,6 +206,14 @@ typedef struct {
   int bufcnt;                                                                 \
   int error;                                                                  \
   uv_buf_t bufsml[4];                                                         \
+  int sendfile_fd;                                                            \
+  int64_t sendfile_off;                                                       \
+
+#define UV_SPLICE_PRIVATE_FIELDS                                              \
+  uv_write_t write_req;                                                       \
+  size_t pending;                                                             \
+  int fds[2];                                                                 \
+  char* buf;                                                                  \
 
 #define UV_CONNECT_PRIVATE_FIELDS                                             \
   ngx_queue_t queue;                                                          \
@@ -232,13 +242,17 @@ typedef struct {
   uv_connection_cb connection_cb;                                             \
   int delayed_error;                                                          \
   int accepted_fd;                                                            \
+  uv_splice_t* splice_src;                                                    \
+  uv_splice_t* splice_dst;                                                    \
   UV_STREAM_PRIVATE_PLATFORM_FIELDS                                           \
 
-#define UV_TCP_PRIVATE_FIELDS /* empty */
+#define UV_TCP_PRIVATE_FIELDS                                                 \
+  struct uv__accept_batch_s* accept_batch;                                    \
 
 #define UV_UDP_PRIVATE_FIELDS                                                 \
   uv_alloc_cb alloc_cb;                                                       \
   uv_udp_recv_cb recv_cb;                                                     \
+  unsigned int recv_batch;                                                    \
   uv__io_t io_watcher;                                                        \
   ngx_queue_t write_queue;                                                    \
   ngx_queue_t write_completed_queue;                                          \
@@ -333,6 +333,9 @@ RB_HEAD(uv_timer_tree_s, uv_timer_s);
   HANDLE event_handle;                                                        \
   HANDLE wait_handle;
 
+#define UV_SPLICE_PRIVATE_FIELDS                                              \
+  /* empty */
+
 #define UV_CONNECT_PRIVATE_FIELDS                                             \
   /* empty */
 
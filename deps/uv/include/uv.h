@@ -211,6 +211,7 @@ typedef struct uv_req_s uv_req_t;
 typedef struct uv_getaddrinfo_s uv_getaddrinfo_t;
 typedef struct uv_shutdown_s uv_shutdown_t;
 typedef struct uv_write_s uv_write_t;
+typedef struct uv_splice_s uv_splice_t;
 typedef struct uv_connect_s uv_connect_t;
 typedef struct uv_udp_send_s uv_udp_send_t;
 typedef struct uv_fs_s uv_fs_t;
@@ -368,6 +369,8 @@ typedef void (*uv_write_cb)(uv_write_t* req, int status);
 typedef void (*uv_connect_cb)(uv_connect_t* req, int status);
 typedef void (*uv_shutdown_cb)(uv_shutdown_t* req, int status);
 typedef void (*uv_connection_cb)(uv_stream_t* server, int status);
+typedef void (*uv_connection_batch_cb)(uv_tcp_t* server, int count,
+    int pending);
 typedef void (*uv_close_cb)(uv_handle_t* handle);
 typedef void (*uv_poll_cb)(uv_poll_t* handle, int status, int events);
 typedef void (*uv_timer_cb)(uv_timer_t* handle, int status);
@@ -637,6 +640,22 @@ UV_EXTERN int uv_write(uv_write_t* req, uv_stream_t* handle,
 UV_EXTERN int uv_write2(uv_write_t* req, uv_stream_t* handle, uv_buf_t bufs[],
     int bufcnt, uv_stream_t* send_handle, uv_write_cb cb);
 
+/*
+ * Write `length` bytes of file `fd`, starting at `offset`, to the stream.
+ * The request is queued in order with uv_write() requests and is written
+ * with non-blocking sendfile() calls whenever the stream is writable, so
+ * the data doesn't pass through user space. `cb` is called when all the
+ * bytes have been sent, or with an error if the file ended early.
+ *
+ * sendfile() reads from the file on the loop thread, so this is meant for
+ * files that are mostly in the page cache. Where the platform has no
+ * usable sendfile() the data is copied through a small buffer instead.
+ *
+ * Not supported on Windows.
+ */
+UV_EXTERN int uv_write_sendfile(uv_write_t* req, uv_stream_t* handle,
+    uv_file fd, int64_t offset, size_t length, uv_write_cb cb);
+
 /* uv_write_t is a subclass of uv_req_t */
 struct uv_write_s {
   UV_REQ_FIELDS
@@ -647,6 +666,43 @@ struct uv_write_s {
 };
 
 
+typedef void (*uv_splice_cb)(uv_splice_t* req, int status);
+
+/*
+ * Move everything read from `src` to `dst` until `src` reaches EOF, without
+ * handing the data to the user. On Linux the data goes through a pipe with
+ * splice() and never leaves the kernel; elsewhere, or when splice() rejects
+ * the fds, it is copied through a fixed 64KB buffer.
+ *
+ * Only one chunk is in flight at a time: `src` isn't read again until the
+ * previous chunk has been written to `dst`, so a slow `dst` slows down `src`.
+ * The writes are queued in order with uv_write() requests on `dst`.
+ *
+ * `cb` is called once, with status 0 when `src` reached EOF and all the data
+ * has been written, or with -1 on a read or write error. Closing either
+ * stream cancels the request with UV_ECANCELED. `dst` is not shut down; the
+ * caller decides how to propagate the EOF. `req->nbytes` is the number of
+ * bytes moved so far.
+ *
+ * `src` must not be reading. A stream can be the source of one splice and the
+ * destination of another at the same time, which is how a two-way proxy is
+ * set up.
+ *
+ * Not supported on Windows.
+ */
+UV_EXTERN int uv_splice_start(uv_splice_t* req, uv_stream_t* src,
+    uv_stream_t* dst, uv_splice_cb cb);
+
+struct uv_splice_s {
+  void* data;
+  uv_stream_t* src;
+  uv_stream_t* dst;
+  uv_splice_cb cb;
+  uint64_t nbytes;
+  UV_SPLICE_PRIVATE_FIELDS
+};
+
+
 /*
  * Used to determine whether a stream is readable or writable.
  */
@@ -704,6 +760,37 @@ UV_EXTERN int uv_tcp_keepalive(uv_tcp_t* handle,
  */
 UV_EXTERN int uv_tcp_simultaneous_accepts(uv_tcp_t* handle, int enable);
 
+/*
+ * Enable/disable SO_REUSEPORT on the socket. Must be called before
+ * uv_tcp_bind() or uv_tcp_bind6() to have any effect. With SO_REUSEPORT
+ * several processes can each bind and listen on the same address and port;
+ * the kernel then spreads incoming connections over their accept queues.
+ *
+ * Returns -1 and sets the error to UV_ENOTSUP on platforms that don't
+ * support the option.
+ */
+UV_EXTERN int uv_tcp_reuseport(uv_tcp_t* handle, int enable);
+
+/* Upper bound on the batch argument of uv_tcp_listen_batch(). */
+#define UV_TCP_ACCEPT_BATCH_MAX 1024
+
+/*
+ * Like uv_listen() but with batched accept. Every time the socket becomes
+ * readable up to `batch` connections are accepted and reported with a single
+ * call to `cb`:
+ *
+ *  count     Number of connections accepted. Call uv_accept() up to `count`
+ *            times from the callback to take them. Connections that are
+ *            left when the callback returns are closed. -1 on error, use
+ *            uv_last_error() to find out what went wrong.
+ *  pending   Number of connections still waiting in the kernel's accept
+ *            queue after this batch, or -1 if the platform can't tell.
+ *
+ * Not supported on Windows.
+ */
+UV_EXTERN int uv_tcp_listen_batch(uv_tcp_t* handle, int backlog,
+    unsigned int batch, uv_connection_batch_cb cb);
+
 UV_EXTERN int uv_tcp_bind(uv_tcp_t* handle, struct sockaddr_in);
 UV_EXTERN int uv_tcp_bind6(uv_tcp_t* handle, struct sockaddr_in6);
 UV_EXTERN int uv_tcp_getsockname(uv_tcp_t* handle, struct sockaddr* name,
@@ -742,9 +829,17 @@ enum uv_udp_flags {
    * Indicates message was truncated because read buffer was too small. The
    * remainder was discarded by the OS. Used in uv_udp_recv_cb.
    */
-  UV_UDP_PARTIAL = 2
+  UV_UDP_PARTIAL = 2,
+  /*
+   * Marks the last uv_udp_recv_cb call of a batch. Only used with
+   * uv_udp_recv_batch_start().
+   */
+  UV_UDP_BATCH_END = 4
 };
 
+/* Upper bound on the count argument of uv_udp_recv_batch_start(). */
+#define UV_UDP_BATCH_MAX 64
+
 /*
  * Called after a uv_udp_send() or uv_udp_send6(). status 0 indicates
  * success otherwise error.
@@ -763,7 +858,7 @@ typedef void (*uv_udp_send_cb)(uv_udp_send_t* req, int status);
  *  addr    struct sockaddr_in or struct sockaddr_in6.
  *          Valid for the duration of the callback only.
  *  flags   One or more OR'ed UV_UDP_* constants.
- *          Right now only UV_UDP_PARTIAL is used.
+ *          UV_UDP_PARTIAL and UV_UDP_BATCH_END are used.
  */
 typedef void (*uv_udp_recv_cb)(uv_udp_t* handle, ssize_t nread, uv_buf_t buf,
     struct sockaddr* addr, unsigned flags);
@@ -948,6 +1043,29 @@ UV_EXTERN int uv_udp_send6(uv_udp_send_t* req, uv_udp_t* handle,
 UV_EXTERN int uv_udp_recv_start(uv_udp_t* handle, uv_alloc_cb alloc_cb,
     uv_udp_recv_cb recv_cb);
 
+/*
+ * Receive data in batches of up to `count` datagrams per system call. Uses
+ * recvmmsg() on Linux and falls back to a recvmsg() loop elsewhere.
+ *
+ * alloc_cb is called `count` times before every batch, once per slot. recv_cb
+ * is then called exactly `count` times: with the datagrams that were read
+ * followed by nread == 0 for every unused slot, so that all buffers are
+ * handed back. The last call of a batch has UV_UDP_BATCH_END set in flags.
+ *
+ * Not supported on Windows.
+ *
+ * Arguments:
+ *  handle    UDP handle. Should have been initialized with `uv_udp_init`.
+ *  count     Slots per batch, between 1 and UV_UDP_BATCH_MAX.
+ *  alloc_cb  Callback to invoke when temporary storage is needed.
+ *  recv_cb   Callback to invoke with received data.
+ *
+ * Returns:
+ *  0 on success, -1 on error.
+ */
+UV_EXTERN int uv_udp_recv_batch_start(uv_udp_t* handle, unsigned int count,
+    uv_alloc_cb alloc_cb, uv_udp_recv_cb recv_cb);
+
 /*
  * Stop listening for incoming datagrams.
  *
@@ -1239,6 +1357,70 @@ UV_EXTERN void uv_timer_set_repeat(uv_timer_t* handle, uint64_t repeat);
 UV_EXTERN uint64_t uv_timer_get_repeat(const uv_timer_t* handle);
 
 
+/*
+ * uv_timer_wheel_t is a hierarchical timing wheel for large numbers of
+ * coarse timers, like the idle timeouts of many sockets. Starting, stopping
+ * and restarting a uv_wheel_timer_t is O(1). A wheel timer never fires early
+ * but may fire up to one `resolution` late.
+ *
+ * The wheel is driven by a single uv_timer_t, `timer`, which only runs while
+ * wheel timers are active. It can be unref'd with uv_unref() so that pending
+ * wheel timers don't keep the loop alive.
+ */
+#define UV_WHEEL_LEVELS 4
+#define UV_WHEEL_SLOTS 64
+
+typedef struct uv_timer_wheel_s uv_timer_wheel_t;
+typedef struct uv_wheel_timer_s uv_wheel_timer_t;
+typedef void (*uv_wheel_timer_cb)(uv_wheel_timer_t* timer);
+
+struct uv_timer_wheel_s {
+  void* data;
+  uv_timer_t timer;
+  /* read-only */
+  uv_loop_t* loop;
+  uint64_t resolution;
+  unsigned int count;
+  /* private */
+  uint64_t now;
+  uint64_t next;
+  ngx_queue_t slots[UV_WHEEL_LEVELS][UV_WHEEL_SLOTS];
+};
+
+struct uv_wheel_timer_s {
+  void* data;
+  /* read-only */
+  uv_timer_wheel_t* wheel;
+  /* private */
+  uv_wheel_timer_cb cb;
+  uint64_t expires;
+  ngx_queue_t queue;
+};
+
+/*
+ * Initializes a wheel that ticks every `resolution` milliseconds. Close it
+ * with uv_close((uv_handle_t*) &wheel->timer, cb) once all of its timers
+ * have been stopped.
+ */
+UV_EXTERN int uv_timer_wheel_init(uv_loop_t* loop, uv_timer_wheel_t* wheel,
+    uint64_t resolution);
+
+UV_EXTERN void uv_wheel_timer_init(uv_timer_wheel_t* wheel,
+    uv_wheel_timer_t* timer);
+
+/*
+ * Starts the timer. `cb` is called once, `timeout` milliseconds from now.
+ * Restarting an active timer just moves its deadline. Pushing the deadline
+ * back is a single store, which makes it cheap to call on every read.
+ */
+UV_EXTERN int uv_wheel_timer_start(uv_wheel_timer_t* timer,
+    uv_wheel_timer_cb cb, uint64_t timeout);
+
+UV_EXTERN int uv_wheel_timer_stop(uv_wheel_timer_t* timer);
+
+UV_EXTERN int uv_wheel_timer_is_active(const uv_wheel_timer_t* timer);
+
+
 /*
  * uv_getaddrinfo_t is a subclass of uv_req_t
  *
@@ -1428,10 +1610,76 @@ struct uv_work_s {
   UV_WORK_PRIVATE_FIELDS
 };
 
+/*
+ * Work classes of the thread pool. Every class has its own queue and the
+ * workers take turns between the classes, so a backlog in one class cannot
+ * starve the others. uv_fs_* requests run as UV_WORK_FS, uv_getaddrinfo()
+ * as UV_WORK_DNS and uv_queue_work() as UV_WORK_USER.
+ */
+typedef enum {
+  UV_WORK_FS = 0,
+  UV_WORK_DNS,
+  UV_WORK_CPU,
+  UV_WORK_USER,
+  UV_WORK_CLASS_MAX
+} uv_work_class_t;
+
+#define UV_THREADPOOL_HIST_BUCKETS 24
+
+/*
+ * Counters of a work class. Histogram bucket i counts the jobs that took
+ * between 2^i and 2^(i+1) microseconds. The first bucket also holds the
+ * faster jobs and the last bucket the slower ones.
+ */
+typedef struct uv_threadpool_stats_s {
+  unsigned int limit;  /* Max. number of jobs running at once, 0 if none. */
+  unsigned int running;
+  unsigned int queued;
+  uint64_t submitted;
+  uint64_t completed;
+  uint64_t wait_hist[UV_THREADPOOL_HIST_BUCKETS];  /* Time in the queue. */
+  uint64_t run_hist[UV_THREADPOOL_HIST_BUCKETS];  /* Time on a worker. */
+} uv_threadpool_stats_t;
+
 /* Queues a work request to execute asynchronously on the thread pool. */
 UV_EXTERN int uv_queue_work(uv_loop_t* loop, uv_work_t* req,
     uv_work_cb work_cb, uv_after_work_cb after_work_cb);
 
+/* Like uv_queue_work() but queues the request in the given work class. */
+UV_EXTERN int uv_queue_work_class(uv_loop_t* loop, uv_work_t* req,
+    uv_work_class_t work_class, uv_work_cb work_cb,
+    uv_after_work_cb after_work_cb);
+
+/*
+ * Sets the number of jobs of a class that may run at the same time. 0 lifts
+ * the limit. Jobs that are already running are not affected.
+ *
+ * Not supported on Windows.
+ */
+UV_EXTERN uv_err_t uv_threadpool_set_limit(uv_work_class_t work_class,
+    unsigned int limit);
+
+/*
+ * Grows or shrinks the thread pool to `nthreads` threads, at most 128. The
+ * initial size comes from the UV_THREADPOOL_SIZE environment variable and
+ * defaults to 4. Surplus threads exit once they have finished their current
+ * job.
+ *
+ * Not supported on Windows.
+ */
+UV_EXTERN uv_err_t uv_threadpool_resize(unsigned int nthreads);
+
+/* Returns the number of threads the pool is sized to, 0 on Windows. */
+UV_EXTERN unsigned int uv_threadpool_size(void);
+
+/*
+ * Fills `stats` with a snapshot of the counters of a work class.
+ *
+ * Not supported on Windows.
+ */
+UV_EXTERN uv_err_t uv_threadpool_get_stats(uv_work_class_t work_class,
+    uv_threadpool_stats_t* stats);
+
 /* Cancel a pending request. Fails if the request is executing or has finished
  * executing.
  *
@@ -1986,6 +2234,7 @@ struct uv_loop_s {
 #undef UV_REQ_TYPE_PRIVATE
 #undef UV_REQ_PRIVATE_FIELDS
 #undef UV_STREAM_PRIVATE_FIELDS
+#undef UV_SPLICE_PRIVATE_FIELDS
 #undef UV_TCP_PRIVATE_FIELDS
 #undef UV_PREPARE_PRIVATE_FIELDS
 #undef UV_CHECK_PRIVATE_FIELDS
@@ -0,0 +1,328 @@
+/* Copyright Joyent, Inc. and other Node contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "uv.h"
+#include "uv-common.h"
+
+#include <assert.h>
+
+/* A hierarchical timing wheel in the style of the classic BSD and Linux
+ * kernel timer wheels. Level 0 has one slot per tick, every level above it
+ * covers 64 times the span of the one below. Timers are cascaded down one
+ * level whenever the slot index of the level below wraps around.
+ */
+
+#define WHEEL_BITS 6
+#define WHEEL_MASK (UV_WHEEL_SLOTS - 1)
+#define WHEEL_SPAN ((uint64_t) 1 << (WHEEL_BITS * UV_WHEEL_LEVELS))
+#define NO_TICK ((uint64_t) -1)
+
+static void wheel_timer_cb(uv_timer_t* handle, int status);
+
+
+/* The loop time is only updated once per loop iteration and can be well
+ * behind when a timer is started, which would make it fire early. The wheel
+ * reads the clock itself instead.
+ */
+static uint64_t wheel_time(void) {
+  return uv_hrtime() / 1000000;
+}
+
+
+static void wheel_add(uv_timer_wheel_t* wheel, uv_wheel_timer_t* timer) {
+  unsigned int level;
+  uint64_t expires;
+  uint64_t delta;
+
+  expires = timer->expires;
+  if (expires < wheel->now)
+    expires = wheel->now;
+
+  delta = expires - wheel->now;
+
+  /* Out of reach. Park it at the far end of the top level, it's put back in
+   * the right place when that slot is cascaded.
+   */
+  if (delta >= WHEEL_SPAN)
+    expires = wheel->now + WHEEL_SPAN - 1;
+
+  for (level = 0; level < UV_WHEEL_LEVELS - 1; level++)
+    if (delta < ((uint64_t) 1 << (WHEEL_BITS * (level + 1))))
+      break;
+
+  ngx_queue_insert_tail(
+      &wheel->slots[level][(expires >> (WHEEL_BITS * level)) & WHEEL_MASK],
+      &timer->queue);
+}
+
+
+static void wheel_cascade(uv_timer_wheel_t* wheel, unsigned int level) {
+  uv_wheel_timer_t* timer;
+  ngx_queue_t* slot;
+  ngx_queue_t list;
+  ngx_queue_t* q;
+
+  slot = &wheel->slots[level][(wheel->now >> (WHEEL_BITS * level)) &
+                              WHEEL_MASK];
+  if (ngx_queue_empty(slot))
+    return;
+
+  ngx_queue_init(&list);
+  ngx_queue_add(&list, slot);
+  ngx_queue_init(slot);
+
+  while (!ngx_queue_empty(&list)) {
+    q = ngx_queue_head(&list);
+    ngx_queue_remove(q);
+    timer = ngx_queue_data(q, uv_wheel_timer_t, queue);
+    wheel_add(wheel, timer);
+  }
+}
+
+
+static void wheel_tick(uv_timer_wheel_t* wheel) {
+  uv_wheel_timer_t* timer;
+  unsigned int level;
+  ngx_queue_t* slot;
+  ngx_queue_t list;
+  ngx_queue_t* q;
+  uint64_t tick;
+
+  tick = wheel->now;
+
+  for (level = 1; level < UV_WHEEL_LEVELS; level++) {
+    if ((tick >> (WHEEL_BITS * (level - 1))) & WHEEL_MASK)
+      break;
+    wheel_cascade(wheel, level);
+  }
+
+  ngx_queue_init(&list);
+  slot = &wheel->slots[0][tick & WHEEL_MASK];
+  if (!ngx_queue_empty(slot)) {
+    ngx_queue_add(&list, slot);
+    ngx_queue_init(slot);
+  }
+
+  /* Timers started from the callbacks below go into later ticks. */
+  wheel->now = tick + 1;
+
+  while (!ngx_queue_empty(&list)) {
+    q = ngx_queue_head(&list);
+    ngx_queue_remove(q);
+    timer = ngx_queue_data(q, uv_wheel_timer_t, queue);
+
+    /* Deadline was pushed back after the timer was filed. */
+    if (timer->expires > tick) {
+      wheel_add(wheel, timer);
+      continue;
+    }
+
+    ngx_queue_init(q);
+    wheel->count--;
+    timer->cb(timer);
+  }
+}
+
+
+static void wheel_arm(uv_timer_wheel_t* wheel, uint64_t tick) {
+  uint64_t due;
+  uint64_t now;
+
+  due = tick * wheel->resolution;
+  now = wheel_time();
+
+  uv_timer_start(&wheel->timer, wheel_timer_cb, due > now ? due - now : 0, 0);
+  wheel->next = tick;
+}
+
+
+/* Returns the first tick from now on at which a timer may expire or a
+ * non-empty slot has to be cascaded, NO_TICK if the wheel is empty.
+ */
+static uint64_t wheel_next_event(const uv_timer_wheel_t* wheel) {
+  unsigned int level;
+  unsigned int i;
+  uint64_t span;
+  uint64_t best;
+  uint64_t tick;
+
+  best = NO_TICK;
+
+  for (i = 0; i < UV_WHEEL_SLOTS; i++) {
+    tick = wheel->now + i;
+    if (!ngx_queue_empty(&wheel->slots[0][tick & WHEEL_MASK])) {
+      best = tick;
+      break;
+    }
+  }
+
+  /* A slot of level n is cascaded at multiples of 64^n ticks. */
+  for (level = 1; level < UV_WHEEL_LEVELS; level++) {
+    span = (uint64_t) 1 << (WHEEL_BITS * level);
+    tick = (wheel->now + span - 1) & ~(span - 1);
+
+    for (i = 0; i < UV_WHEEL_SLOTS && tick < best; i++, tick += span) {
+      if (!ngx_queue_empty(
+              &wheel->slots[level][(tick >> (WHEEL_BITS * level)) &
+                                   WHEEL_MASK])) {
+        best = tick;
+        break;
+      }
+    }
+  }
+
+  return best;
+}
+
+
+static void wheel_schedule(uv_timer_wheel_t* wheel) {
+  if (wheel->count == 0) {
+    uv_timer_stop(&wheel->timer);
+    wheel->next = NO_TICK;
+    return;
+  }
+
+  wheel_arm(wheel, wheel_next_event(wheel));
+}
+
+
+static void wheel_timer_cb(uv_timer_t* handle, int status) {
+  uv_timer_wheel_t* wheel;
+  uint64_t target;
+  uint64_t tick;
+
+  wheel = container_of(handle, uv_timer_wheel_t, timer);
+  target = wheel_time() / wheel->resolution;
+  wheel->next = NO_TICK;
+
+  /* Jump straight to the ticks where something happens. Skipping the ones
+   * in between is safe, they'd find nothing to expire or cascade.
+   */
+  while (wheel->count > 0) {
+    tick = wheel_next_event(wheel);
+    if (tick > target)
+      break;
+
+    wheel->now = tick;
+    wheel_tick(wheel);
+  }
+
+  wheel_schedule(wheel);
+}
+
+
+int uv_timer_wheel_init(uv_loop_t* loop,
+                        uv_timer_wheel_t* wheel,
+                        uint64_t resolution) {
+  unsigned int level;
+  unsigned int slot;
+
+  if (uv_timer_init(loop, &wheel->timer))
+    return -1;
+
+  if (resolution == 0)
+    resolution = 1;
+
+  wheel->loop = loop;
+  wheel->resolution = resolution;
+  wheel->count = 0;
+  wheel->now = wheel_time() / resolution;
+  wheel->next = NO_TICK;
+
+  for (level = 0; level < UV_WHEEL_LEVELS; level++)
+    for (slot = 0; slot < UV_WHEEL_SLOTS; slot++)
+      ngx_queue_init(&wheel->slots[level][slot]);
+
+  return 0;
+}
+
+
+void uv_wheel_timer_init(uv_timer_wheel_t* wheel, uv_wheel_timer_t* timer) {
+  timer->wheel = wheel;
+  timer->cb = NULL;
+  timer->expires = 0;
+  ngx_queue_init(&timer->queue);
+}
+
+
+int uv_wheel_timer_start(uv_wheel_timer_t* timer,
+                         uv_wheel_timer_cb cb,
+                         uint64_t timeout) {
+  uv_timer_wheel_t* wheel;
+  uint64_t deadline;
+  uint64_t expires;
+  uint64_t now;
+
+  wheel = timer->wheel;
+  now = wheel_time();
+
+  /* An empty wheel may have fallen behind, skip ahead to the present. */
+  if (wheel->count == 0 && wheel->now < now / wheel->resolution)
+    wheel->now = now / wheel->resolution;
+
+  deadline = now + timeout;
+  if (deadline < timeout)
+    deadline = (uint64_t) -1 - wheel->resolution;
+
+  /* Round up, a timer must not fire early. */
+  expires = (deadline + wheel->resolution - 1) / wheel->resolution;
+  timer->cb = cb;
+
+  if (uv_wheel_timer_is_active(timer)) {
+    if (expires >= timer->expires) {
+      timer->expires = expires;
+      return 0;
+    }
+
+    ngx_queue_remove(&timer->queue);
+  }
+  else {
+    wheel->count++;
+  }
+
+  timer->expires = expires;
+  wheel_add(wheel, timer);
+
+  if (expires < wheel->next)
+    wheel_arm(wheel, expires < wheel->now ? wheel->now : expires);
+
+  return 0;
+}
+
+
+int uv_wheel_timer_stop(uv_wheel_timer_t* timer) {
+  if (!uv_wheel_timer_is_active(timer))
+    return 0;
+
+  ngx_queue_remove(&timer->queue);
+  ngx_queue_init(&timer->queue);
+  timer->wheel->count--;
+
+  /* The driver is left armed, it stops itself when it finds the wheel
+   * empty. Stopping it here would cost more than the spurious wakeup.
+   */
+  return 0;
+}
+
+
+int uv_wheel_timer_is_active(const uv_wheel_timer_t* timer) {
+  return !ngx_queue_empty(&timer->queue);
+}
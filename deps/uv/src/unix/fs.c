@@ -85,7 +85,10 @@
 #define POST                                                                  \
   do {                                                                        \
     if ((cb) != NULL) {                                                       \
-      uv__work_submit((loop), &(req)->work_req, uv__fs_work, uv__fs_done);    \
+      if (uv__fs_submit_ring((loop), (req)) == 0)                             \
+        return 0;                                                             \
+      uv__work_submit((loop), &(req)->work_req, UV_WORK_FS, uv__fs_work,      \
+                      uv__fs_done);                                           \
       return 0;                                                               \
     }                                                                         \
     else {                                                                    \
@@ -97,6 +100,19 @@
   while (0)
 
 
+static void uv__fs_done(struct uv__work* w, int status);
+
+
+/* Queues the request on the loop's io_uring when possible. */
+static int uv__fs_submit_ring(uv_loop_t* loop, uv_fs_t* req) {
+#if defined(__linux__)
+  return uv__iou_fs_submit(loop, req, uv__fs_done);
+#else
+  return -1;
+#endif
+}
+
+
 static ssize_t uv__fs_fdatasync(uv_fs_t* req) {
 #if defined(__linux__) || defined(__sun) || defined(__NetBSD__)
   return fdatasync(req->file);
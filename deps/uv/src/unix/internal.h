@@ -108,7 +108,20 @@ enum {
   UV_STREAM_BLOCKING  = 0x80,   /* Synchronous writes. */
   UV_TCP_NODELAY      = 0x100,  /* Disable Nagle. */
   UV_TCP_KEEPALIVE    = 0x200,  /* Turn on keep-alive. */
-  UV_TCP_SINGLE_ACCEPT = 0x400  /* Only accept() when idle. */
+  UV_TCP_SINGLE_ACCEPT = 0x400, /* Only accept() when idle. */
+  UV_TCP_REUSEPORT    = 0x800   /* Set SO_REUSEPORT on bind. */
+};
+
+/* Connections accepted by uv__server_batch_io(), see uv_tcp_listen_batch().
+ * fds[0..next) have been handed out through accepted_fd, fds[next..count)
+ * are still waiting for uv_accept().
+ */
+struct uv__accept_batch_s {
+  uv_connection_batch_cb cb;
+  unsigned int size;
+  unsigned int count;
+  unsigned int next;
+  int fds[1];
 };
 
 /* core */
@@ -152,6 +165,8 @@ void uv__stream_destroy(uv_stream_t* stream);
 int uv__stream_try_select(uv_stream_t* stream, int* fd);
 #endif /* defined(__APPLE__) */
 void uv__server_io(uv_loop_t* loop, uv__io_t* w, unsigned int events);
+void uv__server_batch_io(uv_loop_t* loop, uv__io_t* w, unsigned int events);
+void uv__server_batch_close(uv_tcp_t* tcp);
 int uv__accept(int sockfd);
 
 /* tcp */
@@ -174,6 +189,7 @@ void uv__signal_loop_cleanup(uv_loop_t* loop);
 /* thread pool */
 void uv__work_submit(uv_loop_t* loop,
                      struct uv__work *w,
+                     uv_work_class_t work_class,
                      void (*work)(struct uv__work *w),
                      void (*done)(struct uv__work *w, int status));
 void uv__work_done(uv_async_t* handle, int status);
@@ -184,6 +200,15 @@ int uv__kqueue_init(uv_loop_t* loop);
 int uv__platform_loop_init(uv_loop_t* loop, int default_loop);
 void uv__platform_loop_delete(uv_loop_t* loop);
 
+#if defined(__linux__)
+/* io_uring */
+int uv__iou_fs_submit(uv_loop_t* loop,
+                      uv_fs_t* req,
+                      void (*done)(struct uv__work *w, int status));
+void uv__iou_flush(uv_loop_t* loop);
+void uv__iou_delete(uv_loop_t* loop);
+#endif
+
 /* various */
 void uv__async_close(uv_async_t* handle);
 void uv__check_close(uv_check_t* handle);
@@ -81,6 +81,7 @@ int uv__platform_loop_init(uv_loop_t* loop, int default_loop) {
   loop->backend_fd = fd;
   loop->inotify_fd = -1;
   loop->inotify_watchers = NULL;
+  loop->iou = NULL;
 
   if (fd == -1)
     return -1;
@@ -90,6 +91,8 @@ int uv__platform_loop_init(uv_loop_t* loop, int default_loop) {
 
 
 void uv__platform_loop_delete(uv_loop_t* loop) {
+  uv__iou_delete(loop);
+
   if (loop->inotify_fd == -1) return;
   uv__io_stop(loop, &loop->inotify_read_watcher, UV__POLLIN);
   close(loop->inotify_fd);
@@ -112,6 +115,9 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
   int op;
   int i;
 
+  /* File system requests queued on the io_uring since the last poll. */
+  uv__iou_flush(loop);
+
   if (loop->nfds == 0) {
     assert(ngx_queue_empty(&loop->watcher_queue));
     return;
@@ -0,0 +1,466 @@
+/* Copyright Joyent, Inc. and other Node contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/* io_uring submission path for file system requests.
+ *
+ * Asynchronous uv_fs_read(), uv_fs_write(), uv_fs_open(), uv_fs_close(),
+ * uv_fs_stat(), uv_fs_lstat(), uv_fs_fstat(), uv_fs_fsync() and
+ * uv_fs_fdatasync() requests are turned into submission queue entries instead
+ * of threadpool jobs. Entries are handed to the kernel in one io_uring_enter()
+ * call at the start of uv__io_poll(), so a burst of requests costs a single
+ * syscall. The ring fd is watched like any other fd; when it becomes readable
+ * the completions are reaped and the requests finish through the same done
+ * callback as threadpool requests.
+ *
+ * The ring is set up on first use. When the kernel doesn't have io_uring, or
+ * lacks the features this needs (5.6 and up), or UV_USE_IO_URING=0 is set in
+ * the environment, every request goes to the threadpool as before. A full
+ * ring falls back to the threadpool too.
+ */
+
+#include "uv.h"
+#include "internal.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+
+#define UV__IOU_ENTRIES 256
+
+struct uv__iou {
+  int fd;
+  uv__io_t watcher;
+  uint32_t* sqhead;
+  uint32_t* sqtail;
+  uint32_t* sqarray;
+  uint32_t sqmask;
+  uint32_t sqentries;
+  uint32_t* cqhead;
+  uint32_t* cqtail;
+  uint32_t cqmask;
+  struct uv__io_uring_sqe* sqe;
+  struct uv__io_uring_cqe* cqe;
+  void* sq;
+  size_t sqlen;
+  size_t sqelen;
+  unsigned int unsubmitted;
+  unsigned int in_flight;
+  unsigned int max_in_flight;
+};
+
+static void uv__iou_io(uv_loop_t* loop, uv__io_t* w, unsigned int events);
+
+
+static int uv__iou_init(struct uv__iou* iou) {
+  struct uv__io_uring_params params;
+  const char* val;
+  size_t sqlen;
+  size_t cqlen;
+  size_t sqelen;
+  void* sq;
+  void* sqe;
+  int fd;
+
+  val = getenv("UV_USE_IO_URING");
+  if (val != NULL && atoi(val) == 0)
+    return -1;
+
+  memset(&params, 0, sizeof(params));
+
+  fd = uv__io_uring_setup(UV__IOU_ENTRIES, &params);
+  if (fd == -1)
+    return -1;
+
+  /* Needs openat, close, statx and reads at the file position: Linux 5.6. */
+  if (!(params.features & UV__IORING_FEAT_SINGLE_MMAP) ||
+      !(params.features & UV__IORING_FEAT_NODROP) ||
+      !(params.features & UV__IORING_FEAT_RW_CUR_POS)) {
+    close(fd);
+    return -1;
+  }
+
+  sqlen = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cqlen = params.cq_off.cqes +
+          params.cq_entries * sizeof(struct uv__io_uring_cqe);
+  sqelen = params.sq_entries * sizeof(struct uv__io_uring_sqe);
+
+  /* With FEAT_SINGLE_MMAP both rings live in one mapping. */
+  if (cqlen > sqlen)
+    sqlen = cqlen;
+
+  sq = mmap(NULL,
+            sqlen,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE,
+            fd,
+            UV__IORING_OFF_SQ_RING);
+  if (sq == MAP_FAILED) {
+    close(fd);
+    return -1;
+  }
+
+  sqe = mmap(NULL,
+             sqelen,
+             PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE,
+             fd,
+             UV__IORING_OFF_SQES);
+  if (sqe == MAP_FAILED) {
+    munmap(sq, sqlen);
+    close(fd);
+    return -1;
+  }
+
+  iou->fd = fd;
+  iou->sq = sq;
+  iou->sqlen = sqlen;
+  iou->sqelen = sqelen;
+  iou->sqe = sqe;
+  iou->sqhead = (uint32_t*) ((char*) sq + params.sq_off.head);
+  iou->sqtail = (uint32_t*) ((char*) sq + params.sq_off.tail);
+  iou->sqarray = (uint32_t*) ((char*) sq + params.sq_off.array);
+  iou->sqmask = *(uint32_t*) ((char*) sq + params.sq_off.ring_mask);
+  iou->sqentries = *(uint32_t*) ((char*) sq + params.sq_off.ring_entries);
+  iou->cqhead = (uint32_t*) ((char*) sq + params.cq_off.head);
+  iou->cqtail = (uint32_t*) ((char*) sq + params.cq_off.tail);
+  iou->cqmask = *(uint32_t*) ((char*) sq + params.cq_off.ring_mask);
+  iou->cqe = (struct uv__io_uring_cqe*) ((char*) sq + params.cq_off.cqes);
+  iou->unsubmitted = 0;
+  iou->in_flight = 0;
+  iou->max_in_flight = params.cq_entries;
+
+  uv__io_init(&iou->watcher, uv__iou_io, fd);
+
+  return 0;
+}
+
+
+static struct uv__iou* uv__iou_get(uv_loop_t* loop) {
+  struct uv__iou* iou;
+
+  iou = loop->iou;
+  if (iou != NULL)
+    return iou->fd == -1 ? NULL : iou;
+
+  iou = malloc(sizeof(*iou));
+  if (iou == NULL)
+    return NULL;
+
+  loop->iou = iou;
+
+  if (uv__iou_init(iou)) {
+    iou->fd = -1;
+    return NULL;
+  }
+
+  return iou;
+}
+
+
+/* Hands the queued entries to the kernel. Called before the loop blocks. */
+void uv__iou_flush(uv_loop_t* loop) {
+  struct uv__iou* iou;
+  int n;
+
+  iou = loop->iou;
+  if (iou == NULL || iou->unsubmitted == 0)
+    return;
+
+  do
+    n = uv__io_uring_enter(iou->fd, iou->unsubmitted, 0, 0);
+  while (n == -1 && errno == EINTR);
+
+  /* EAGAIN and EBUSY mean the kernel is short on resources right now. The
+   * entries stay queued and go out on the next call.
+   */
+  if (n > 0)
+    iou->unsubmitted -= n;
+}
+
+
+/* Returns the next free submission queue entry, or NULL if the ring is full
+ * or too many requests are in flight for the completion queue.
+ */
+static struct uv__io_uring_sqe* uv__iou_get_sqe(uv_loop_t* loop,
+                                                struct uv__iou* iou) {
+  struct uv__io_uring_sqe* sqe;
+  uint32_t head;
+  uint32_t tail;
+
+  if (iou->in_flight >= iou->max_in_flight)
+    return NULL;
+
+  head = __atomic_load_n(iou->sqhead, __ATOMIC_ACQUIRE);
+  tail = *iou->sqtail;
+
+  if (tail - head >= iou->sqentries) {
+    uv__iou_flush(loop);
+    head = __atomic_load_n(iou->sqhead, __ATOMIC_ACQUIRE);
+    if (tail - head >= iou->sqentries)
+      return NULL;
+  }
+
+  sqe = &iou->sqe[tail & iou->sqmask];
+  memset(sqe, 0, sizeof(*sqe));
+
+  return sqe;
+}
+
+
+static void uv__iou_submit(struct uv__iou* iou) {
+  uint32_t tail;
+
+  tail = *iou->sqtail;
+  iou->sqarray[tail & iou->sqmask] = tail & iou->sqmask;
+  __atomic_store_n(iou->sqtail, tail + 1, __ATOMIC_RELEASE);
+  iou->unsubmitted++;
+  iou->in_flight++;
+}
+
+
+int uv__iou_fs_submit(uv_loop_t* loop,
+                      uv_fs_t* req,
+                      void (*done)(struct uv__work *w, int status)) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__statx* statxbuf;
+  struct uv__iou* iou;
+
+  switch (req->fs_type) {
+  case UV_FS_CLOSE:
+  case UV_FS_FDATASYNC:
+  case UV_FS_FSTAT:
+  case UV_FS_FSYNC:
+  case UV_FS_LSTAT:
+  case UV_FS_OPEN:
+  case UV_FS_READ:
+  case UV_FS_STAT:
+  case UV_FS_WRITE:
+    break;
+  default:
+    return -1;
+  }
+
+  iou = uv__iou_get(loop);
+  if (iou == NULL)
+    return -1;
+
+  statxbuf = NULL;
+  if (req->fs_type == UV_FS_STAT ||
+      req->fs_type == UV_FS_LSTAT ||
+      req->fs_type == UV_FS_FSTAT) {
+    statxbuf = malloc(sizeof(*statxbuf));
+    if (statxbuf == NULL)
+      return -1;
+  }
+
+  sqe = uv__iou_get_sqe(loop, iou);
+  if (sqe == NULL) {
+    free(statxbuf);
+    return -1;
+  }
+
+  switch (req->fs_type) {
+  case UV_FS_CLOSE:
+    sqe->opcode = UV__IORING_OP_CLOSE;
+    sqe->fd = req->file;
+    break;
+
+  case UV_FS_FDATASYNC:
+  case UV_FS_FSYNC:
+    sqe->opcode = UV__IORING_OP_FSYNC;
+    sqe->fd = req->file;
+    if (req->fs_type == UV_FS_FDATASYNC)
+      sqe->rw_flags = UV__IORING_FSYNC_DATASYNC;
+    break;
+
+  case UV_FS_OPEN:
+    sqe->opcode = UV__IORING_OP_OPENAT;
+    sqe->fd = AT_FDCWD;
+    sqe->addr = (uintptr_t) req->path;
+    sqe->len = req->mode;
+    sqe->rw_flags = req->flags;
+    break;
+
+  case UV_FS_READ:
+  case UV_FS_WRITE:
+    if (req->fs_type == UV_FS_READ)
+      sqe->opcode = UV__IORING_OP_READ;
+    else
+      sqe->opcode = UV__IORING_OP_WRITE;
+    sqe->fd = req->file;
+    sqe->addr = (uintptr_t) req->buf;
+    sqe->len = req->len;
+    /* -1 reads or writes at the file position, like read() and write(). */
+    sqe->off = req->off < 0 ? (uint64_t) -1 : (uint64_t) req->off;
+    break;
+
+  case UV_FS_FSTAT:
+    sqe->opcode = UV__IORING_OP_STATX;
+    sqe->fd = req->file;
+    sqe->addr = (uintptr_t) "";
+    sqe->rw_flags = AT_EMPTY_PATH;
+    break;
+
+  case UV_FS_LSTAT:
+  case UV_FS_STAT:
+    sqe->opcode = UV__IORING_OP_STATX;
+    sqe->fd = AT_FDCWD;
+    sqe->addr = (uintptr_t) req->path;
+    if (req->fs_type == UV_FS_LSTAT)
+      sqe->rw_flags = AT_SYMLINK_NOFOLLOW;
+    break;
+
+  default:
+    abort();
+  }
+
+  if (statxbuf != NULL) {
+    sqe->len = UV__STATX_BASIC_STATS;
+    sqe->off = (uintptr_t) statxbuf;
+    req->ptr = statxbuf;
+  }
+
+  sqe->user_data = (uintptr_t) req;
+
+  /* Looks like a threadpool request that has already been picked up, so that
+   * uv_cancel() reports it as busy.
+   */
+  req->work_req.loop = loop;
+  req->work_req.work = NULL;
+  req->work_req.done = done;
+  ngx_queue_init(&req->work_req.wq);
+
+  uv__iou_submit(iou);
+  uv__io_start(loop, &iou->watcher, UV__POLLIN);
+
+  return 0;
+}
+
+
+static void uv__iou_statx_to_stat(const struct uv__statx* stx,
+                                  uv_statbuf_t* st) {
+  memset(st, 0, sizeof(*st));
+  st->st_dev = makedev(stx->stx_dev_major, stx->stx_dev_minor);
+  st->st_ino = stx->stx_ino;
+  st->st_mode = stx->stx_mode;
+  st->st_nlink = stx->stx_nlink;
+  st->st_uid = stx->stx_uid;
+  st->st_gid = stx->stx_gid;
+  st->st_rdev = makedev(stx->stx_rdev_major, stx->stx_rdev_minor);
+  st->st_size = stx->stx_size;
+  st->st_blksize = stx->stx_blksize;
+  st->st_blocks = stx->stx_blocks;
+  st->st_atim.tv_sec = stx->stx_atime.tv_sec;
+  st->st_atim.tv_nsec = stx->stx_atime.tv_nsec;
+  st->st_mtim.tv_sec = stx->stx_mtime.tv_sec;
+  st->st_mtim.tv_nsec = stx->stx_mtime.tv_nsec;
+  st->st_ctim.tv_sec = stx->stx_ctime.tv_sec;
+  st->st_ctim.tv_nsec = stx->stx_ctime.tv_nsec;
+}
+
+
+/* Same result and error conventions as uv__fs_work(). */
+static void uv__iou_fs_complete(uv_fs_t* req, int res) {
+  struct uv__statx* statxbuf;
+
+  if (res < 0) {
+    req->result = -1;
+    req->errorno = -res;
+  } else {
+    req->result = res;
+    req->errorno = 0;
+  }
+
+  if (req->fs_type == UV_FS_STAT ||
+      req->fs_type == UV_FS_LSTAT ||
+      req->fs_type == UV_FS_FSTAT) {
+    statxbuf = req->ptr;
+    req->ptr = NULL;
+
+    if (res == 0) {
+      uv__iou_statx_to_stat(statxbuf, &req->statbuf);
+      req->ptr = &req->statbuf;
+    }
+
+    free(statxbuf);
+  }
+
+  req->work_req.done(&req->work_req, 0);
+}
+
+
+static void uv__iou_io(uv_loop_t* loop, uv__io_t* w, unsigned int events) {
+  struct uv__io_uring_cqe* cqe;
+  struct uv__iou* iou;
+  uv_fs_t* req;
+  uint32_t head;
+  uint32_t tail;
+  int res;
+
+  iou = container_of(w, struct uv__iou, watcher);
+
+  for (;;) {
+    head = *iou->cqhead;
+    tail = __atomic_load_n(iou->cqtail, __ATOMIC_ACQUIRE);
+
+    if (head == tail)
+      break;
+
+    cqe = &iou->cqe[head & iou->cqmask];
+    req = (uv_fs_t*) (uintptr_t) cqe->user_data;
+    res = cqe->res;
+
+    /* Free the slot before the callback, which may queue new requests. */
+    __atomic_store_n(iou->cqhead, head + 1, __ATOMIC_RELEASE);
+    assert(iou->in_flight > 0);
+    iou->in_flight--;
+
+    uv__iou_fs_complete(req, res);
+  }
+
+  if (iou->in_flight == 0)
+    uv__io_stop(loop, &iou->watcher, UV__POLLIN);
+}
+
+
+void uv__iou_delete(uv_loop_t* loop) {
+  struct uv__iou* iou;
+
+  iou = loop->iou;
+  if (iou == NULL)
+    return;
+
+  if (iou->fd != -1) {
+    uv__io_stop(loop, &iou->watcher, UV__POLLIN);
+    munmap(iou->sqe, iou->sqelen);
+    munmap(iou->sq, iou->sqlen);
+    close(iou->fd);
+  }
+
+  free(iou);
+  loop->iou = NULL;
+}
@@ -35,6 +35,19 @@
 #include <unistd.h>
 #include <limits.h> /* IOV_MAX */
 
+#if defined(__linux__)
+# include <netinet/in.h>
+# include <netinet/tcp.h> /* TCP_INFO */
+#endif
+
+#if defined(__linux__) || defined(__sun)
+# include <sys/sendfile.h>
+#endif
+
+#if defined(__linux__)
+# include <fcntl.h> /* splice() */
+#endif
+
 #if defined(__APPLE__)
 # include <sys/event.h>
 # include <sys/time.h>
@@ -64,6 +77,8 @@ static void uv__stream_connect(uv_stream_t*);
 static void uv__write(uv_stream_t* stream);
 static void uv__read(uv_stream_t* stream);
 static void uv__stream_io(uv_loop_t* loop, uv__io_t* w, unsigned int events);
+static void uv__splice_read(uv_stream_t* stream);
+static void uv__splice_cancel(uv_splice_t* req, uv_stream_t* stream);
 static size_t uv__write_req_size(uv_write_t* req);
 
 
@@ -115,6 +130,8 @@ void uv__stream_init(uv_loop_t* loop,
   stream->shutdown_req = NULL;
   stream->accepted_fd = -1;
   stream->delayed_error = 0;
+  stream->splice_src = NULL;
+  stream->splice_dst = NULL;
   ngx_queue_init(&stream->write_queue);
   ngx_queue_init(&stream->write_completed_queue);
   stream->write_queue_size = 0;
@@ -395,6 +412,9 @@ void uv__stream_destroy(uv_stream_t* stream) {
     stream->connect_req = NULL;
   }
 
+  if (stream->splice_src)
+    uv__splice_cancel(stream->splice_src, stream);
+
   while (!ngx_queue_empty(&stream->write_queue)) {
     q = ngx_queue_head(&stream->write_queue);
     ngx_queue_remove(q);
@@ -432,6 +452,12 @@ void uv__stream_destroy(uv_stream_t* stream) {
     }
   }
 
+  /* A splice write that was in flight has been cancelled above, which
+   * finished the splice.
+   */
+  if (stream->splice_dst)
+    uv__splice_cancel(stream->splice_dst, stream);
+
   if (stream->shutdown_req) {
     /* The UV_ECANCELED error code is a lie, the shutdown(2) syscall is a
      * fait accompli at this point. Maybe we should revisit this in v0.11.
@@ -551,6 +577,131 @@ void uv__server_io(uv_loop_t* loop, uv__io_t* w, unsigned int events) {
 }
 
 
+/* Hand out the next connection of the current accept batch, if any. */
+static void uv__accept_batch_next(uv_stream_t* stream) {
+  struct uv__accept_batch_s* batch;
+
+  if (stream->type != UV_TCP)
+    return;
+
+  batch = ((uv_tcp_t*) stream)->accept_batch;
+  if (batch != NULL && batch->next < batch->count)
+    stream->accepted_fd = batch->fds[batch->next++];
+}
+
+
+/* Close the connections of the current batch that were not taken. */
+static void uv__accept_batch_flush(uv_tcp_t* tcp) {
+  struct uv__accept_batch_s* batch;
+
+  batch = tcp->accept_batch;
+
+  if (tcp->accepted_fd != -1) {
+    close(tcp->accepted_fd);
+    tcp->accepted_fd = -1;
+  }
+
+  while (batch->next < batch->count)
+    close(batch->fds[batch->next++]);
+
+  batch->count = 0;
+  batch->next = 0;
+}
+
+
+/* Number of connections left in the accept queue of a listen socket. */
+static int uv__accept_pending(uv__io_t* w) {
+#if defined(__linux__) && defined(TCP_INFO)
+  struct tcp_info info;
+  socklen_t len;
+
+  /* For listen sockets Linux reports the accept queue length in unacked. */
+  len = sizeof(info);
+  if (getsockopt(w->fd, IPPROTO_TCP, TCP_INFO, &info, &len) == 0)
+    return info.tcpi_unacked;
+
+  return -1;
+#elif defined(UV_HAVE_KQUEUE)
+  return w->rcount > 0 ? w->rcount : 0;
+#else
+  return -1;
+#endif
+}
+
+
+void uv__server_batch_io(uv_loop_t* loop, uv__io_t* w, unsigned int events) {
+  struct uv__accept_batch_s* batch;
+  uv_tcp_t* tcp;
+  int err;
+  int fd;
+
+  tcp = container_of(w, uv_tcp_t, io_watcher);
+  batch = tcp->accept_batch;
+  assert(events == UV__POLLIN);
+  assert(tcp->accepted_fd == -1);
+  assert(batch->count == 0);
+  assert(!(tcp->flags & UV_CLOSING));
+
+  err = 0;
+
+  while (batch->count < batch->size) {
+#if defined(UV_HAVE_KQUEUE)
+    if (w->rcount <= 0)
+      break;
+#endif /* defined(UV_HAVE_KQUEUE) */
+
+    fd = uv__accept(uv__stream_fd(tcp));
+    if (fd == -1) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        break;  /* Not an error. */
+
+      if (errno == ECONNABORTED)
+        continue;  /* Ignore. Nothing we can do about that. */
+
+      if (errno == EMFILE || errno == ENFILE) {
+        SAVE_ERRNO(err = uv__emfile_trick(loop, uv__stream_fd(tcp)));
+        if (err == EAGAIN || err == EWOULDBLOCK) {
+          err = 0;
+          break;
+        }
+      }
+
+      err = errno;
+      break;
+    }
+
+    UV_DEC_BACKLOG(w)
+    batch->fds[batch->count++] = fd;
+  }
+
+  if (batch->count > 0) {
+    uv__accept_batch_next((uv_stream_t*) tcp);
+    batch->cb(tcp, batch->count, uv__accept_pending(w));
+
+    /* The callback may have closed the server, which releases the batch. */
+    if (uv__stream_fd(tcp) == -1)
+      return;
+
+    uv__accept_batch_flush(tcp);
+  }
+
+  if (err != 0) {
+    uv__set_sys_error(loop, err);
+    batch->cb(tcp, -1, -1);
+  }
+}
+
+
+void uv__server_batch_close(uv_tcp_t* tcp) {
+  if (tcp->accept_batch == NULL)
+    return;
+
+  uv__accept_batch_flush(tcp);
+  free(tcp->accept_batch);
+  tcp->accept_batch = NULL;
+}
+
+
 #undef UV_DEC_BACKLOG
 
 
@@ -603,6 +754,9 @@ int uv_accept(uv_stream_t* server, uv_stream_t* client) {
   status = 0;
 
 out:
+  if (streamServer->accepted_fd == -1)
+    uv__accept_batch_next(streamServer);
+
   errno = saved_errno;
   return status;
 }
@@ -715,6 +869,227 @@ static int uv__handle_fd(uv_handle_t* handle) {
 }
 
 
+/* uv__write_file() offset that marks sendfile_fd as a splice pipe. */
+#define UV__SPLICE_PIPE_OFF (-1)
+
+/* The most a splice moves in one go; also the size of the fallback buffer. */
+#define UV__SPLICE_CHUNK (64 * 1024)
+
+
+/* Copy file data to the stream through a buffer, for platforms and fds
+ * that sendfile() doesn't handle.
+ */
+static ssize_t uv__sendfile_emul(int out_fd,
+                                 int in_fd,
+                                 int64_t* off,
+                                 size_t len) {
+  char buf[16 * 1024];
+  ssize_t nread;
+  ssize_t n;
+
+  if (len > sizeof(buf))
+    len = sizeof(buf);
+
+  do
+    nread = pread(in_fd, buf, len, *off);
+  while (nread == -1 && errno == EINTR);
+
+  if (nread <= 0)
+    return nread;
+
+  do
+    n = write(out_fd, buf, nread);
+  while (n == -1 && errno == EINTR);
+
+  /* Whatever wasn't written is read again on the next call. */
+  if (n > 0)
+    *off += n;
+
+  return n;
+}
+
+
+/* Non-blocking sendfile(): returns the number of bytes sent, 0 at the end
+ * of the file or -1 with errno set (EAGAIN when the stream is full).
+ */
+static ssize_t uv__sendfile(int out_fd, int in_fd, int64_t* off, size_t len) {
+#if defined(__linux__) || defined(__sun)
+  off_t o;
+  ssize_t r;
+
+  o = *off;
+  do
+    r = sendfile(out_fd, in_fd, &o, len);
+  while (r == -1 && errno == EINTR);
+
+  if (r != -1 || o > *off) {
+    r = o - *off;
+    *off = o;
+    return r;
+  }
+
+  if (errno == EINVAL ||
+      errno == ENOSYS ||
+      errno == ENOTSOCK ||
+      errno == EXDEV ||
+      errno == EIO) {
+    return uv__sendfile_emul(out_fd, in_fd, off, len);
+  }
+
+  return -1;
+#elif defined(__FreeBSD__) || defined(__APPLE__)
+  off_t n;
+  int r;
+
+  /* Both report a partial write as EAGAIN with the count in n. */
+#if defined(__FreeBSD__)
+  n = 0;
+  r = sendfile(in_fd, out_fd, *off, len, NULL, &n, 0);
+#else
+  n = len;
+  r = sendfile(in_fd, out_fd, *off, &n, NULL, 0);
+#endif
+
+  if (r != -1 || n != 0) {
+    *off += n;
+    return n;
+  }
+
+  if (errno == EINVAL ||
+      errno == ENOTSOCK ||
+      errno == EOPNOTSUPP ||
+      errno == ENOTSUP) {
+    return uv__sendfile_emul(out_fd, in_fd, off, len);
+  }
+
+  return -1;
+#else
+  return uv__sendfile_emul(out_fd, in_fd, off, len);
+#endif
+}
+
+
+#if defined(__linux__)
+/* The destination doesn't take splice() (an O_APPEND fd, for example). Move
+ * the data that is still in the splice pipe into the uv_splice_t's buffer
+ * and turn `req` into an ordinary write of that buffer. uv__splice_read()
+ * copies the following chunks through the buffer as well.
+ */
+static int uv__splice_write_emul(uv_write_t* req) {
+  uv_splice_t* splice_req;
+  uv_buf_t* buf;
+  size_t nread;
+  ssize_t n;
+
+  splice_req = container_of(req, uv_splice_t, write_req);
+  buf = &req->bufs[0];
+  assert(buf->len <= UV__SPLICE_CHUNK);
+
+  splice_req->buf = malloc(UV__SPLICE_CHUNK);
+  if (splice_req->buf == NULL) {
+    errno = ENOMEM;
+    return -1;
+  }
+
+  for (nread = 0; nread < buf->len; nread += n) {
+    do
+      n = read(req->sendfile_fd, splice_req->buf + nread, buf->len - nread);
+    while (n == -1 && errno == EINTR);
+
+    if (n == 0)
+      errno = EIO;
+    if (n <= 0)
+      return -1;
+  }
+
+  close(splice_req->fds[0]);
+  close(splice_req->fds[1]);
+  splice_req->fds[0] = -1;
+  splice_req->fds[1] = -1;
+
+  buf->base = splice_req->buf;
+  req->sendfile_fd = -1;
+  return 0;
+}
+#endif
+
+
+/* The sendfile() counterpart of the writev() path in uv__write(). The bytes
+ * still to send are kept in bufs[0].len so that write_queue_size is
+ * accounted for the same way as for ordinary writes.
+ */
+static void uv__write_file(uv_stream_t* stream, uv_write_t* req) {
+  uv_buf_t* buf;
+  ssize_t n;
+
+  buf = &req->bufs[0];
+
+start:
+
+  if (buf->len == 0) {
+    req->write_index = req->bufcnt;
+    uv__write_req_finish(req);
+    return;
+  }
+
+#if defined(__linux__)
+  if (req->sendfile_off == UV__SPLICE_PIPE_OFF) {
+    /* Data that uv__splice_read() moved into a pipe. */
+    do
+      n = splice(req->sendfile_fd,
+                 NULL,
+                 uv__stream_fd(stream),
+                 NULL,
+                 buf->len,
+                 SPLICE_F_NONBLOCK | SPLICE_F_MOVE);
+    while (n == -1 && errno == EINTR);
+
+    if (n == -1 && errno == EINVAL && uv__splice_write_emul(req) == 0) {
+      uv__write(stream);
+      return;
+    }
+  } else
+#endif
+  n = uv__sendfile(uv__stream_fd(stream),
+                   req->sendfile_fd,
+                   &req->sendfile_off,
+                   buf->len);
+
+  if (n == 0) {
+    /* The file (or the splice pipe) is shorter than what was asked for. */
+    errno = EIO;
+    n = -1;
+  }
+
+  if (n == -1) {
+    if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      req->error = errno;
+      uv__write_req_finish(req);
+      uv__io_stop(stream->loop, &stream->io_watcher, UV__POLLOUT);
+      if (!uv__io_active(&stream->io_watcher, UV__POLLIN))
+        uv__handle_stop(stream);
+      return;
+    }
+
+    if (stream->flags & UV_STREAM_BLOCKING)
+      goto start;
+
+    uv__io_start(stream->loop, &stream->io_watcher, UV__POLLOUT);
+    return;
+  }
+
+  assert((size_t) n <= buf->len);
+  assert(stream->write_queue_size >= (size_t) n);
+  buf->len -= n;
+  stream->write_queue_size -= n;
+
+  if (buf->len == 0 || (stream->flags & UV_STREAM_BLOCKING))
+    goto start;
+
+  uv__io_start(stream->loop, &stream->io_watcher, UV__POLLOUT);
+}
+
+
 static void uv__write(uv_stream_t* stream) {
   struct iovec* iov;
   ngx_queue_t* q;
@@ -733,6 +1108,11 @@ start:
   req = ngx_queue_data(q, uv_write_t, queue);
   assert(req->handle == stream);
 
+  if (req->sendfile_fd != -1) {
+    uv__write_file(stream, req);
+    return;
+  }
+
   /*
    * Cast to iovec. We had to have our own uv_buf_t instead of iovec
    * because Windows's WSABUF is not an iovec.
@@ -1116,7 +1496,10 @@ static void uv__stream_io(uv_loop_t* loop, uv__io_t* w, unsigned int events) {
   if (events & (UV__POLLIN | UV__POLLERR | UV__POLLHUP)) {
     assert(uv__stream_fd(stream) >= 0);
 
-    uv__read(stream);
+    if (stream->splice_src)
+      uv__splice_read(stream);
+    else
+      uv__read(stream);
 
     if (uv__stream_fd(stream) == -1)
       return; /* read_cb closed stream. */
@@ -1174,12 +1557,14 @@ static void uv__stream_connect(uv_stream_t* stream) {
 }
 
 
-int uv_write2(uv_write_t* req,
-              uv_stream_t* stream,
-              uv_buf_t bufs[],
-              int bufcnt,
-              uv_stream_t* send_handle,
-              uv_write_cb cb) {
+static int uv__write_start(uv_write_t* req,
+                           uv_stream_t* stream,
+                           uv_buf_t bufs[],
+                           int bufcnt,
+                           uv_stream_t* send_handle,
+                           int sendfile_fd,
+                           int64_t sendfile_off,
+                           uv_write_cb cb) {
   int empty_queue;
 
   assert(bufcnt > 0);
@@ -1219,6 +1604,8 @@ int uv_write2(uv_write_t* req,
   req->handle = stream;
   req->error = 0;
   req->send_handle = send_handle;
+  req->sendfile_fd = sendfile_fd;
+  req->sendfile_off = sendfile_off;
   ngx_queue_init(&req->queue);
 
   if (bufcnt <= (int) ARRAY_SIZE(req->bufsml))
@@ -1258,6 +1645,251 @@ int uv_write2(uv_write_t* req,
 }
 
 
+int uv_write2(uv_write_t* req,
+              uv_stream_t* stream,
+              uv_buf_t bufs[],
+              int bufcnt,
+              uv_stream_t* send_handle,
+              uv_write_cb cb) {
+  return uv__write_start(req, stream, bufs, bufcnt, send_handle, -1, 0, cb);
+}
+
+
+int uv_write_sendfile(uv_write_t* req,
+                      uv_stream_t* stream,
+                      uv_file fd,
+                      int64_t offset,
+                      size_t length,
+                      uv_write_cb cb) {
+  uv_buf_t buf;
+
+  if (fd < 0 || offset < 0)
+    return uv__set_artificial_error(stream->loop, UV_EINVAL);
+
+  buf.base = NULL;
+  buf.len = length;
+
+  return uv__write_start(req, stream, &buf, 1, NULL, fd, offset, cb);
+}
+
+
+static void uv__splice_finish(uv_splice_t* req, int status) {
+  uv_stream_t* src;
+
+  src = req->src;
+
+  if (src != NULL) {
+    src->splice_src = NULL;
+
+    if (!(src->flags & (UV_CLOSING | UV_STREAM_READING))) {
+      uv__io_stop(src->loop, &src->io_watcher, UV__POLLIN);
+      if (!uv__io_active(&src->io_watcher, UV__POLLOUT))
+        uv__handle_stop(src);
+    }
+  }
+
+  req->dst->splice_dst = NULL;
+
+  if (req->fds[0] != -1) {
+    close(req->fds[0]);
+    close(req->fds[1]);
+    req->fds[0] = -1;
+    req->fds[1] = -1;
+  }
+
+  free(req->buf);
+  req->buf = NULL;
+
+  req->cb(req, status);
+}
+
+
+/* Called when `stream` is destroyed while `req` uses it. */
+static void uv__splice_cancel(uv_splice_t* req, uv_stream_t* stream) {
+  if (req->pending != 0) {
+    /* The write to dst finishes the request, see uv__splice_write_cb(). */
+    assert(stream == req->src);
+    stream->splice_src = NULL;
+    req->src = NULL;
+    return;
+  }
+
+  uv__set_artificial_error(stream->loop, UV_ECANCELED);
+  uv__splice_finish(req, -1);
+}
+
+
+static void uv__splice_write_cb(uv_write_t* w, int status) {
+  uv_splice_t* req;
+  uv_stream_t* src;
+
+  req = container_of(w, uv_splice_t, write_req);
+  src = req->src;
+
+  if (status == 0 && src == NULL) {
+    /* src was closed while the write was in flight. */
+    uv__set_artificial_error(w->handle->loop, UV_ECANCELED);
+    status = -1;
+  }
+
+  if (status) {
+    req->pending = 0;
+    uv__splice_finish(req, -1);
+    return;
+  }
+
+  req->nbytes += req->pending;
+  req->pending = 0;
+
+  if (src->flags & UV_CLOSING)
+    return;
+
+  uv__io_start(src->loop, &src->io_watcher, UV__POLLIN);
+  uv__handle_start(src);
+}
+
+
+/* Moves the next chunk from the source stream into the pipe (or the buffer)
+ * and queues it on the destination. Reading stops until the write is done.
+ */
+static void uv__splice_read(uv_stream_t* stream) {
+  uv_splice_t* req;
+  uv_buf_t buf;
+  ssize_t n;
+  int fd;
+  int r;
+
+  req = stream->splice_src;
+  fd = uv__stream_fd(stream);
+
+  /* POLLERR or POLLHUP while waiting for the write. */
+  if (req->pending != 0)
+    return;
+
+#if defined(__linux__)
+  if (req->buf == NULL) {
+    do
+      n = splice(fd,
+                 NULL,
+                 req->fds[1],
+                 NULL,
+                 UV__SPLICE_CHUNK,
+                 SPLICE_F_NONBLOCK | SPLICE_F_MOVE);
+    while (n == -1 && errno == EINTR);
+
+    if (n == -1 && errno == EINVAL && req->nbytes == 0) {
+      /* The fd doesn't support splice(), copy through a buffer instead. */
+      close(req->fds[0]);
+      close(req->fds[1]);
+      req->fds[0] = -1;
+      req->fds[1] = -1;
+      req->buf = malloc(UV__SPLICE_CHUNK);
+      if (req->buf == NULL) {
+        uv__set_artificial_error(stream->loop, UV_ENOMEM);
+        uv__splice_finish(req, -1);
+        return;
+      }
+    }
+  }
+#endif
+
+  if (req->buf != NULL) {
+    do
+      n = read(fd, req->buf, UV__SPLICE_CHUNK);
+    while (n == -1 && errno == EINTR);
+  }
+
+  if (n == -1) {
+    if (errno == EAGAIN || errno == EWOULDBLOCK)
+      return;
+
+    uv__set_sys_error(stream->loop, errno);
+    uv__splice_finish(req, -1);
+    return;
+  }
+
+  if (n == 0) {
+    /* EOF. Everything read so far has been written. */
+    uv__splice_finish(req, 0);
+    return;
+  }
+
+  req->pending = n;
+  uv__io_stop(stream->loop, &stream->io_watcher, UV__POLLIN);
+  if (!uv__io_active(&stream->io_watcher, UV__POLLOUT))
+    uv__handle_stop(stream);
+
+  buf.base = req->buf;
+  buf.len = n;
+
+  if (req->buf != NULL)
+    r = uv__write_start(&req->write_req, req->dst, &buf, 1, NULL, -1, 0,
+                        uv__splice_write_cb);
+  else
+    r = uv__write_start(&req->write_req, req->dst, &buf, 1, NULL,
+                        req->fds[0], UV__SPLICE_PIPE_OFF, uv__splice_write_cb);
+
+  if (r) {
+    req->pending = 0;
+    uv__splice_finish(req, -1);
+  }
+}
+
+
+int uv_splice_start(uv_splice_t* req,
+                    uv_stream_t* src,
+                    uv_stream_t* dst,
+                    uv_splice_cb cb) {
+  if (src == dst)
+    return uv__set_artificial_error(src->loop, UV_EINVAL);
+
+  if (uv__stream_fd(src) < 0 || uv__stream_fd(dst) < 0)
+    return uv__set_artificial_error(src->loop, UV_EBADF);
+
+  if ((src->flags & (UV_CLOSING | UV_STREAM_READING)) ||
+      src->splice_src != NULL ||
+      dst->splice_dst != NULL) {
+    return uv__set_artificial_error(src->loop, UV_EBUSY);
+  }
+
+  req->src = src;
+  req->dst = dst;
+  req->cb = cb;
+  req->nbytes = 0;
+  req->pending = 0;
+  req->fds[0] = -1;
+  req->fds[1] = -1;
+  req->buf = NULL;
+
+#if defined(__linux__)
+  if (uv__make_pipe(req->fds, UV__F_NONBLOCK)) {
+    req->fds[0] = -1;
+    req->fds[1] = -1;
+  }
+#endif
+
+  if (req->fds[0] == -1) {
+    req->buf = malloc(UV__SPLICE_CHUNK);
+    if (req->buf == NULL)
+      return uv__set_artificial_error(src->loop, UV_ENOMEM);
+  }
+
+  src->splice_src = req;
+  dst->splice_dst = req;
+
+  uv__io_start(src->loop, &src->io_watcher, UV__POLLIN);
+  uv__handle_start(src);
+
+#if defined(__APPLE__)
+  /* Notify select() thread about state change */
+  if (src->select != NULL)
+    uv__stream_osx_interrupt_select(src);
+#endif /* defined(__APPLE__) */
+
+  return 0;
+}
+
+
 /* The buffers to be written must remain valid until the callback is called.
  * This is not required for the uv_buf_t array.
  */
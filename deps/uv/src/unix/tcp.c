@@ -30,6 +30,7 @@
 
 int uv_tcp_init(uv_loop_t* loop, uv_tcp_t* tcp) {
   uv__stream_init(loop, (uv_stream_t*)tcp, UV_TCP);
+  tcp->accept_batch = NULL;
   return 0;
 }
 
@@ -67,6 +68,12 @@ static int uv__bind(uv_tcp_t* tcp,
   if (setsockopt(tcp->io_watcher.fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)))
     return uv__set_sys_error(tcp->loop, errno);
 
+#ifdef SO_REUSEPORT
+  if ((tcp->flags & UV_TCP_REUSEPORT) &&
+      setsockopt(tcp->io_watcher.fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)))
+    return uv__set_sys_error(tcp->loop, errno);
+#endif
+
   errno = 0;
   if (bind(tcp->io_watcher.fd, addr, addrsize) && errno != EADDRINUSE)
     return uv__set_sys_error(tcp->loop, errno);
@@ -255,6 +262,38 @@ int uv_tcp_listen(uv_tcp_t* tcp, int backlog, uv_connection_cb cb) {
 }
 
 
+int uv_tcp_listen_batch(uv_tcp_t* tcp,
+                        int backlog,
+                        unsigned int batch,
+                        uv_connection_batch_cb cb) {
+  struct uv__accept_batch_s* b;
+
+  if (batch == 0 || batch > UV_TCP_ACCEPT_BATCH_MAX || cb == NULL)
+    return uv__set_artificial_error(tcp->loop, UV_EINVAL);
+
+  if (tcp->accept_batch != NULL)
+    return uv__set_artificial_error(tcp->loop, UV_EALREADY);
+
+  b = malloc(sizeof(*b) + (batch - 1) * sizeof(b->fds[0]));
+  if (b == NULL)
+    return uv__set_sys_error(tcp->loop, ENOMEM);
+
+  if (uv_tcp_listen(tcp, backlog, NULL)) {
+    free(b);
+    return -1;
+  }
+
+  b->cb = cb;
+  b->size = batch;
+  b->count = 0;
+  b->next = 0;
+  tcp->accept_batch = b;
+  tcp->io_watcher.cb = uv__server_batch_io;
+
+  return 0;
+}
+
+
 int uv__tcp_connect(uv_connect_t* req,
                     uv_tcp_t* handle,
                     struct sockaddr_in addr,
@@ -343,6 +382,19 @@ int uv_tcp_keepalive(uv_tcp_t* handle, int on, unsigned int delay) {
 }
 
 
+int uv_tcp_reuseport(uv_tcp_t* handle, int enable) {
+#ifdef SO_REUSEPORT
+  if (enable)
+    handle->flags |= UV_TCP_REUSEPORT;
+  else
+    handle->flags &= ~UV_TCP_REUSEPORT;
+  return 0;
+#else
+  return uv__set_artificial_error(handle->loop, UV_ENOTSUP);
+#endif
+}
+
+
 int uv_tcp_simultaneous_accepts(uv_tcp_t* handle, int enable) {
   if (enable)
     handle->flags &= ~UV_TCP_SINGLE_ACCEPT;
@@ -353,5 +405,6 @@ int uv_tcp_simultaneous_accepts(uv_tcp_t* handle, int enable) {
 
 
 void uv__tcp_close(uv_tcp_t* handle) {
+  uv__server_batch_close(handle);
   uv__stream_close((uv_stream_t*)handle);
 }
@@ -20,18 +20,38 @@
  */
 
 #include "internal.h"
+#include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define MAX_THREADPOOL_SIZE 128
 
+enum {
+  THREAD_UNUSED = 0,
+  THREAD_RUNNING,
+  THREAD_EXITED  /* Left worker(), waiting to be joined. */
+};
+
+struct uv__work_class {
+  ngx_queue_t wq;
+  unsigned int limit;
+  unsigned int running;
+  unsigned int queued;
+  uint64_t submitted;
+  uint64_t completed;
+  uint64_t wait_hist[UV_THREADPOOL_HIST_BUCKETS];
+  uint64_t run_hist[UV_THREADPOOL_HIST_BUCKETS];
+};
+
 static uv_once_t once = UV_ONCE_INIT;
 static uv_cond_t cond;
 static uv_mutex_t mutex;
-static unsigned int nthreads;
-static uv_thread_t* threads;
-static uv_thread_t default_threads[4];
-static ngx_queue_t exit_message;
-static ngx_queue_t wq;
+static unsigned int nthreads;  /* Threads in worker(). */
+static unsigned int nthreads_target;
+static uv_thread_t threads[MAX_THREADPOOL_SIZE];
+static int thread_state[MAX_THREADPOOL_SIZE];
+static struct uv__work_class classes[UV_WORK_CLASS_MAX];
+static unsigned int next_class;
 static volatile int initialized;
 
 
@@ -40,39 +60,91 @@ static void uv__cancelled(struct uv__work* w) {
 }
 
 
+static void hist_add(uint64_t* hist, uint64_t nsec) {
+  uint64_t usec;
+  unsigned int i;
+
+  usec = nsec / 1000;
+  for (i = 0; usec > 1 && i < UV_THREADPOOL_HIST_BUCKETS - 1; i++)
+    usec >>= 1;
+
+  hist[i]++;
+}
+
+
+/* Takes the next job off the class queues, round-robin over the classes that
+ * are below their limit. Must be called with the global mutex held.
+ */
+static struct uv__work* next_work(void) {
+  struct uv__work_class* c;
+  ngx_queue_t* q;
+  unsigned int n;
+  unsigned int i;
+
+  for (i = 0; i < UV_WORK_CLASS_MAX; i++) {
+    n = (next_class + i) % UV_WORK_CLASS_MAX;
+    c = classes + n;
+
+    if (ngx_queue_empty(&c->wq))
+      continue;
+
+    if (c->limit != 0 && c->running >= c->limit)
+      continue;
+
+    q = ngx_queue_head(&c->wq);
+    ngx_queue_remove(q);
+    ngx_queue_init(q);  /* Signal uv_cancel() that the work req is
+                           executing. */
+    c->queued--;
+    c->running++;
+    next_class = (n + 1) % UV_WORK_CLASS_MAX;
+
+    return ngx_queue_data(q, struct uv__work, wq);
+  }
+
+  return NULL;
+}
+
+
 /* To avoid deadlock with uv_cancel() it's crucial that the worker
  * never holds the global mutex and the loop-local mutex at the same time.
  */
 static void worker(void* arg) {
+  struct uv__work_class* c;
   struct uv__work* w;
-  ngx_queue_t* q;
+  unsigned int slot;
+  uint64_t start;
 
-  (void) arg;
+  slot = (unsigned int) (uintptr_t) arg;
 
   for (;;) {
     uv_mutex_lock(&mutex);
 
-    while (ngx_queue_empty(&wq))
+    while (nthreads <= nthreads_target && (w = next_work()) == NULL)
       uv_cond_wait(&cond, &mutex);
 
-    q = ngx_queue_head(&wq);
-
-    if (q == &exit_message)
+    if (nthreads > nthreads_target) {
+      /* The pool is shrinking. Pass on the wakeup we may have consumed. */
+      nthreads--;
+      thread_state[slot] = THREAD_EXITED;
       uv_cond_signal(&cond);
-    else {
-      ngx_queue_remove(q);
-      ngx_queue_init(q);  /* Signal uv_cancel() that the work req is
-                             executing. */
+      uv_mutex_unlock(&mutex);
+      break;
     }
 
+    c = classes + w->work_class;
+    start = uv__hrtime();
+    hist_add(c->wait_hist, start - w->queued_at);
     uv_mutex_unlock(&mutex);
 
-    if (q == &exit_message)
-      break;
-
-    w = ngx_queue_data(q, struct uv__work, wq);
     w->work(w);
 
+    uv_mutex_lock(&mutex);
+    c->running--;
+    c->completed++;
+    hist_add(c->run_hist, uv__hrtime() - start);
+    uv_mutex_unlock(&mutex);
+
     uv_mutex_lock(&w->loop->wq_mutex);
     w->work = NULL;  /* Signal uv_cancel() that the work req is done
                         executing. */
@@ -83,35 +155,74 @@ static void worker(void* arg) {
 }
 
 
-static void post(ngx_queue_t* q) {
+static void post(struct uv__work* w) {
+  struct uv__work_class* c;
+
+  c = classes + w->work_class;
+  w->queued_at = uv__hrtime();
+
   uv_mutex_lock(&mutex);
-  ngx_queue_insert_tail(&wq, q);
+  ngx_queue_insert_tail(&c->wq, &w->wq);
+  c->queued++;
+  c->submitted++;
   uv_cond_signal(&cond);
   uv_mutex_unlock(&mutex);
 }
 
 
+/* Joins the threads that left the pool. Must be called with the global
+ * mutex held, which is safe because an exited thread never takes it again.
+ */
+static void reap_threads(void) {
+  unsigned int i;
+
+  for (i = 0; i < MAX_THREADPOOL_SIZE; i++) {
+    if (thread_state[i] != THREAD_EXITED)
+      continue;
+
+    if (uv_thread_join(threads + i))
+      abort();
+
+    thread_state[i] = THREAD_UNUSED;
+  }
+}
+
+
+/* Starts workers until there are `nthreads_target` of them. Must be called
+ * with the global mutex held.
+ */
+static int start_threads(void) {
+  unsigned int i;
+
+  reap_threads();
+
+  for (i = 0; i < MAX_THREADPOOL_SIZE && nthreads < nthreads_target; i++) {
+    if (thread_state[i] != THREAD_UNUSED)
+      continue;
+
+    if (uv_thread_create(threads + i, worker, (void*) (uintptr_t) i))
+      return -1;
+
+    thread_state[i] = THREAD_RUNNING;
+    nthreads++;
+  }
+
+  return 0;
+}
+
+
 static void init_once(void) {
   unsigned int i;
   const char* val;
 
-  nthreads = ARRAY_SIZE(default_threads);
+  nthreads_target = 4;
   val = getenv("UV_THREADPOOL_SIZE");
   if (val != NULL)
-    nthreads = atoi(val);
-  if (nthreads == 0)
-    nthreads = 1;
-  if (nthreads > MAX_THREADPOOL_SIZE)
-    nthreads = MAX_THREADPOOL_SIZE;
-
-  threads = default_threads;
-  if (nthreads > ARRAY_SIZE(default_threads)) {
-    threads = malloc(nthreads * sizeof(threads[0]));
-    if (threads == NULL) {
-      nthreads = ARRAY_SIZE(default_threads);
-      threads = default_threads;
-    }
-  }
+    nthreads_target = atoi(val);
+  if (nthreads_target == 0)
+    nthreads_target = 1;
+  if (nthreads_target > MAX_THREADPOOL_SIZE)
+    nthreads_target = MAX_THREADPOOL_SIZE;
 
   if (uv_cond_init(&cond))
     abort();
@@ -119,11 +230,13 @@ static void init_once(void) {
   if (uv_mutex_init(&mutex))
     abort();
 
-  ngx_queue_init(&wq);
+  for (i = 0; i < UV_WORK_CLASS_MAX; i++)
+    ngx_queue_init(&classes[i].wq);
 
-  for (i = 0; i < nthreads; i++)
-    if (uv_thread_create(threads + i, worker, NULL))
-      abort();
+  uv_mutex_lock(&mutex);
+  if (start_threads())
+    abort();
+  uv_mutex_unlock(&mutex);
 
   initialized = 1;
 }
@@ -137,19 +250,24 @@ static void cleanup(void) {
   if (initialized == 0)
     return;
 
-  post(&exit_message);
+  uv_mutex_lock(&mutex);
+  nthreads_target = 0;
+  uv_cond_broadcast(&cond);
+  uv_mutex_unlock(&mutex);
+
+  for (i = 0; i < MAX_THREADPOOL_SIZE; i++) {
+    if (thread_state[i] == THREAD_UNUSED)
+      continue;
 
-  for (i = 0; i < nthreads; i++)
     if (uv_thread_join(threads + i))
       abort();
 
-  if (threads != default_threads)
-    free(threads);
+    thread_state[i] = THREAD_UNUSED;
+  }
 
   uv_mutex_destroy(&mutex);
   uv_cond_destroy(&cond);
 
-  threads = NULL;
   nthreads = 0;
   initialized = 0;
 }
@@ -158,13 +276,16 @@ static void cleanup(void) {
 
 void uv__work_submit(uv_loop_t* loop,
                      struct uv__work* w,
+                     uv_work_class_t work_class,
                      void (*work)(struct uv__work* w),
                      void (*done)(struct uv__work* w, int status)) {
   uv_once(&once, init_once);
+  assert(work_class >= 0 && work_class < UV_WORK_CLASS_MAX);
   w->loop = loop;
   w->work = work;
   w->done = done;
-  post(&w->wq);
+  w->work_class = work_class;
+  post(w);
 }
 
 
@@ -175,8 +296,10 @@ static int uv__work_cancel(uv_loop_t* loop, uv_req_t* req, struct uv__work* w) {
   uv_mutex_lock(&w->loop->wq_mutex);
 
   cancelled = !ngx_queue_empty(&w->wq) && w->work != NULL;
-  if (cancelled)
+  if (cancelled) {
     ngx_queue_remove(&w->wq);
+    classes[w->work_class].queued--;
+  }
 
   uv_mutex_unlock(&w->loop->wq_mutex);
   uv_mutex_unlock(&mutex);
@@ -249,18 +372,107 @@ int uv_queue_work(uv_loop_t* loop,
                   uv_work_t* req,
                   uv_work_cb work_cb,
                   uv_after_work_cb after_work_cb) {
-  if (work_cb == NULL)
+  return uv_queue_work_class(loop, req, UV_WORK_USER, work_cb, after_work_cb);
+}
+
+
+int uv_queue_work_class(uv_loop_t* loop,
+                        uv_work_t* req,
+                        uv_work_class_t work_class,
+                        uv_work_cb work_cb,
+                        uv_after_work_cb after_work_cb) {
+  if (work_cb == NULL || work_class < 0 || work_class >= UV_WORK_CLASS_MAX)
     return uv__set_artificial_error(loop, UV_EINVAL);
 
   uv__req_init(loop, req, UV_WORK);
   req->loop = loop;
   req->work_cb = work_cb;
   req->after_work_cb = after_work_cb;
-  uv__work_submit(loop, &req->work_req, uv__queue_work, uv__queue_done);
+  uv__work_submit(loop,
+                  &req->work_req,
+                  work_class,
+                  uv__queue_work,
+                  uv__queue_done);
   return 0;
 }
 
 
+uv_err_t uv_threadpool_set_limit(uv_work_class_t work_class,
+                                 unsigned int limit) {
+  if (work_class < 0 || work_class >= UV_WORK_CLASS_MAX)
+    return uv__new_artificial_error(UV_EINVAL);
+
+  uv_once(&once, init_once);
+
+  uv_mutex_lock(&mutex);
+  classes[work_class].limit = limit;
+  /* Workers may have skipped jobs of this class, let them look again. */
+  uv_cond_broadcast(&cond);
+  uv_mutex_unlock(&mutex);
+
+  return uv_ok_;
+}
+
+
+uv_err_t uv_threadpool_resize(unsigned int n) {
+  int r;
+
+  if (n == 0 || n > MAX_THREADPOOL_SIZE)
+    return uv__new_artificial_error(UV_EINVAL);
+
+  uv_once(&once, init_once);
+
+  uv_mutex_lock(&mutex);
+  nthreads_target = n;
+  r = start_threads();
+  if (nthreads > nthreads_target)
+    uv_cond_broadcast(&cond);
+  uv_mutex_unlock(&mutex);
+
+  if (r)
+    return uv__new_artificial_error(UV_ENOMEM);
+
+  return uv_ok_;
+}
+
+
+unsigned int uv_threadpool_size(void) {
+  unsigned int n;
+
+  uv_once(&once, init_once);
+
+  uv_mutex_lock(&mutex);
+  n = nthreads_target;
+  uv_mutex_unlock(&mutex);
+
+  return n;
+}
+
+
+uv_err_t uv_threadpool_get_stats(uv_work_class_t work_class,
+                                 uv_threadpool_stats_t* stats) {
+  struct uv__work_class* c;
+
+  if (work_class < 0 || work_class >= UV_WORK_CLASS_MAX)
+    return uv__new_artificial_error(UV_EINVAL);
+
+  uv_once(&once, init_once);
+  c = classes + work_class;
+
+  uv_mutex_lock(&mutex);
+  stats->limit = c->limit;
+  stats->running = c->running;
+  stats->queued = c->queued;
+  stats->submitted = c->submitted;
+  stats->completed = c->completed;
+  memcpy(stats->wait_hist, c->wait_hist, sizeof(stats->wait_hist));
+  memcpy(stats->run_hist, c->run_hist, sizeof(stats->run_hist));
+  uv_mutex_unlock(&mutex);
+
+  return uv_ok_;
+}
+
+
 int uv_cancel(uv_req_t* req) {
   struct uv__work* wreq;
   uv_loop_t* loop;
@@ -33,6 +33,150 @@ static void uv__udp_run_completed(uv_udp_t* handle);
 static void uv__udp_run_pending(uv_udp_t* handle);
 static void uv__udp_io(uv_loop_t* loop, uv__io_t* w, unsigned int revents);
 static void uv__udp_recvmsg(uv_loop_t* loop, uv__io_t* w, unsigned int revents);
+static void uv__udp_recvmmsg(uv_udp_t* handle);
+/* Reads up to `count` datagrams into `bufs`. Returns the number of datagrams
+ * read or -1 with errno set if not even the first read succeeded.
+ */
+static int uv__udp_read_batch(uv_udp_t* handle,
+                              unsigned int count,
+                              uv_buf_t* bufs,
+                              struct sockaddr_storage* peers,
+                              ssize_t* sizes,
+                              unsigned int* flags) {
+#if defined(__linux__)
+  static int no_recvmmsg;
+  struct uv__mmsghdr msgs[UV_UDP_BATCH_MAX];
+  int n;
+#endif
+  struct msghdr h;
+  unsigned int i;
+  ssize_t size;
+
+#if defined(__linux__)
+  if (no_recvmmsg == 0) {
+    memset(msgs, 0, count * sizeof(msgs[0]));
+
+    for (i = 0; i < count; i++) {
+      msgs[i].msg_hdr.msg_name = &peers[i];
+      msgs[i].msg_hdr.msg_namelen = sizeof(peers[i]);
+      msgs[i].msg_hdr.msg_iov = (void*) &bufs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    do {
+      n = uv__recvmmsg(handle->io_watcher.fd, msgs, count, 0, NULL);
+    }
+    while (n == -1 && errno == EINTR);
+
+    if (n != -1 || errno != ENOSYS) {
+      for (i = 0; (int) i < n; i++) {
+        sizes[i] = msgs[i].msg_len;
+        flags[i] = 0;
+
+        if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC)
+          flags[i] |= UV_UDP_PARTIAL;
+      }
+
+      return n;
+    }
+
+    no_recvmmsg = 1;
+  }
+#endif
+
+  memset(&h, 0, sizeof(h));
+
+  for (i = 0; i < count; i++) {
+    h.msg_name = &peers[i];
+    h.msg_namelen = sizeof(peers[i]);
+    h.msg_iov = (void*) &bufs[i];
+    h.msg_iovlen = 1;
+
+    do {
+      size = recvmsg(handle->io_watcher.fd, &h, 0);
+    }
+    while (size == -1 && errno == EINTR);
+
+    /* Errors after the first datagram are picked up by the next batch. */
+    if (size == -1)
+      return i > 0 ? (int) i : -1;
+
+    sizes[i] = size;
+    flags[i] = 0;
+
+    if (h.msg_flags & MSG_TRUNC)
+      flags[i] |= UV_UDP_PARTIAL;
+  }
+
+  return count;
+}
+
+
+static void uv__udp_recvmmsg(uv_udp_t* handle) {
+  struct sockaddr_storage peers[UV_UDP_BATCH_MAX];
+  uv_buf_t bufs[UV_UDP_BATCH_MAX];
+  ssize_t sizes[UV_UDP_BATCH_MAX];
+  unsigned int flags[UV_UDP_BATCH_MAX];
+  uv_udp_recv_cb recv_cb;
+  unsigned int count;
+  unsigned int last;
+  unsigned int i;
+  int batches;
+  int n;
+
+  /* Same starvation guard as uv__udp_recvmsg() but counted in batches. */
+  batches = 4;
+
+  do {
+    count = handle->recv_batch;
+    recv_cb = handle->recv_cb;
+
+    for (i = 0; i < count; i++) {
+      bufs[i] = handle->alloc_cb((uv_handle_t*)handle, 64 * 1024);
+      assert(bufs[i].len > 0);
+      assert(bufs[i].base != NULL);
+    }
+
+    n = uv__udp_read_batch(handle, count, bufs, peers, sizes, flags);
+
+    if (n == -1) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        uv__set_sys_error(handle->loop, EAGAIN);
+        n = 0;
+      }
+      else {
+        uv__set_sys_error(handle->loop, errno);
+        sizes[0] = -1;
+      }
+    }
+
+    /* Every slot is reported, even if the callback stops or closes the handle
+     * halfway through the batch, so that all buffers make it back.
+     */
+    for (i = 0; i < count; i++) {
+      last = (i == count - 1) ? UV_UDP_BATCH_END : 0;
+
+      if ((int) i < n)
+        recv_cb(handle,
+                sizes[i],
+                bufs[i],
+                (struct sockaddr*)&peers[i],
+                flags[i] | last);
+      else if (i == 0 && n == -1)
+        recv_cb(handle, -1, bufs[i], NULL, last);
+      else
+        recv_cb(handle, 0, bufs[i], NULL, last);
+    }
+  }
+  /* recv_cb callback may decide to pause or close the handle */
+  while (n == (int) count
+      && --batches > 0
+      && handle->io_watcher.fd != -1
+      && handle->recv_cb != NULL
+      && handle->recv_batch != 0);
+}
+
+
 static void uv__udp_sendmsg(uv_loop_t* loop, uv__io_t* w, unsigned int revents);
 static int uv__udp_maybe_deferred_bind(uv_udp_t* handle, int domain);
 static int uv__send(uv_udp_send_t* req,
@@ -85,12 +229,90 @@ void uv__udp_finish_close(uv_udp_t* handle) {
 }
 
 
+#if defined(__linux__)
+/* Sends the write queue in batches of up to UV_UDP_BATCH_MAX datagrams per
+ * sendmmsg() call. Returns -1 if the kernel doesn't have sendmmsg(), in which
+ * case nothing has been sent.
+ */
+static int uv__udp_run_pending_mmsg(uv_udp_t* handle) {
+  static int no_sendmmsg;
+  struct uv__mmsghdr msgs[UV_UDP_BATCH_MAX];
+  uv_udp_send_t* reqs[UV_UDP_BATCH_MAX];
+  uv_udp_send_t* req;
+  ngx_queue_t* q;
+  int count;
+  int n;
+  int i;
+
+  if (no_sendmmsg)
+    return -1;
+
+  while (!ngx_queue_empty(&handle->write_queue)) {
+    count = 0;
+
+    ngx_queue_foreach(q, &handle->write_queue) {
+      if (count == UV_UDP_BATCH_MAX)
+        break;
+
+      req = ngx_queue_data(q, uv_udp_send_t, queue);
+      reqs[count] = req;
+
+      memset(&msgs[count], 0, sizeof(msgs[count]));
+      msgs[count].msg_hdr.msg_name = &req->addr;
+      msgs[count].msg_hdr.msg_namelen = (req->addr.sin6_family == AF_INET6 ?
+        sizeof(struct sockaddr_in6) : sizeof(struct sockaddr_in));
+      msgs[count].msg_hdr.msg_iov = (struct iovec*)req->bufs;
+      msgs[count].msg_hdr.msg_iovlen = req->bufcnt;
+      count++;
+    }
+
+    do {
+      n = uv__sendmmsg(handle->io_watcher.fd, msgs, count, 0);
+    }
+    while (n == -1 && errno == EINTR);
+
+    if (n == -1) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        break;
+
+      if (errno == ENOSYS) {
+        no_sendmmsg = 1;
+        return -1;
+      }
+
+      /* sendmmsg() only fails outright when the first datagram fails. The
+       * ones after it are retried on the next iteration.
+       */
+      reqs[0]->status = -errno;
+      n = 1;
+    }
+    else {
+      for (i = 0; i < n; i++)
+        reqs[i]->status = msgs[i].msg_len;
+    }
+
+    for (i = 0; i < n; i++) {
+      ngx_queue_remove(&reqs[i]->queue);
+      ngx_queue_insert_tail(&handle->write_completed_queue, &reqs[i]->queue);
+    }
+  }
+
+  return 0;
+}
+#endif
+
+
 static void uv__udp_run_pending(uv_udp_t* handle) {
   uv_udp_send_t* req;
   ngx_queue_t* q;
   struct msghdr h;
   ssize_t size;
 
+#if defined(__linux__)
+  if (uv__udp_run_pending_mmsg(handle) == 0)
+    return;
+#endif
+
   while (!ngx_queue_empty(&handle->write_queue)) {
     q = ngx_queue_head(&handle->write_queue);
     assert(q != NULL);
@@ -201,6 +423,11 @@ static void uv__udp_recvmsg(uv_loop_t* loop,
   assert(handle->recv_cb != NULL);
   assert(handle->alloc_cb != NULL);
 
+  if (handle->recv_batch != 0) {
+    uv__udp_recvmmsg(handle);
+    return;
+  }
+
   /* Prevent loop starvation when the data comes in as fast as (or faster than)
    * we can read it. XXX Need to rearm fd if we switch to edge-triggered I/O.
    */
@@ -453,6 +680,7 @@ int uv_udp_init(uv_loop_t* loop, uv_udp_t* handle) {
   uv__handle_init(loop, (uv_handle_t*)handle, UV_UDP);
   handle->alloc_cb = NULL;
   handle->recv_cb = NULL;
+  handle->recv_batch = 0;
   uv__io_init(&handle->io_watcher, uv__udp_io, -1);
   ngx_queue_init(&handle->write_queue);
   ngx_queue_init(&handle->write_completed_queue);
@@ -694,6 +922,7 @@ int uv__udp_recv_start(uv_udp_t* handle,
 
   handle->alloc_cb = alloc_cb;
   handle->recv_cb = recv_cb;
+  handle->recv_batch = 0;
 
   uv__io_start(handle->loop, &handle->io_watcher, UV__POLLIN);
   uv__handle_start(handle);
@@ -702,6 +931,19 @@ int uv__udp_recv_start(uv_udp_t* handle,
 }
 
 
+int uv__udp_recv_batch_start(uv_udp_t* handle,
+                             unsigned int count,
+                             uv_alloc_cb alloc_cb,
+                             uv_udp_recv_cb recv_cb) {
+  if (uv__udp_recv_start(handle, alloc_cb, recv_cb))
+    return -1;
+
+  handle->recv_batch = count;
+
+  return 0;
+}
+
+
 int uv__udp_recv_stop(uv_udp_t* handle) {
   uv__io_stop(handle->loop, &handle->io_watcher, UV__POLLIN);
 
@@ -710,6 +952,7 @@ int uv__udp_recv_stop(uv_udp_t* handle) {
 
   handle->alloc_cb = NULL;
   handle->recv_cb = NULL;
+  handle->recv_batch = 0;
 
   return 0;
 }
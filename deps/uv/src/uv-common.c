@@ -293,6 +293,19 @@ int uv_udp_recv_start(uv_udp_t* handle,
 }
 
 
+int uv_udp_recv_batch_start(uv_udp_t* handle,
+                            unsigned int count,
+                            uv_alloc_cb alloc_cb,
+                            uv_udp_recv_cb recv_cb) {
+  if (handle->type != UV_UDP || alloc_cb == NULL || recv_cb == NULL ||
+      count == 0 || count > UV_UDP_BATCH_MAX) {
+    return uv__set_artificial_error(handle->loop, UV_EINVAL);
+  }
+
+  return uv__udp_recv_batch_start(handle, count, alloc_cb, recv_cb);
+}
+
+
 int uv_udp_recv_stop(uv_udp_t* handle) {
   if (handle->type != UV_UDP) {
     return uv__set_artificial_error(handle->loop, UV_EINVAL);
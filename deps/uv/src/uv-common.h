@@ -110,6 +110,9 @@ int uv__udp_send6(uv_udp_send_t* req,
 int uv__udp_recv_start(uv_udp_t* handle, uv_alloc_cb alloccb,
                        uv_udp_recv_cb recv_cb);
 
+int uv__udp_recv_batch_start(uv_udp_t* handle, unsigned int count,
+                             uv_alloc_cb alloccb, uv_udp_recv_cb recv_cb);
+
 int uv__udp_recv_stop(uv_udp_t* handle);
 
 void uv__fs_poll_close(uv_fs_poll_t* handle);
@@ -159,6 +159,20 @@ int uv_write2(uv_write_t* req, uv_stream_t* handle, uv_buf_t bufs[], int bufcnt,
 }
 
 
+int uv_write_sendfile(uv_write_t* req, uv_stream_t* handle, uv_file fd,
+    int64_t offset, size_t length, uv_write_cb cb) {
+  uv__set_artificial_error(handle->loop, UV_ENOSYS);
+  return -1;
+}
+
+
+int uv_splice_start(uv_splice_t* req, uv_stream_t* src, uv_stream_t* dst,
+    uv_splice_cb cb) {
+  uv__set_artificial_error(src->loop, UV_ENOSYS);
+  return -1;
+}
+
+
 int uv_shutdown(uv_shutdown_t* req, uv_stream_t* handle, uv_shutdown_cb cb) {
   uv_loop_t* loop = handle->loop;
 
@@ -1213,6 +1213,20 @@ int uv_tcp_keepalive(uv_tcp_t* handle, int enable, unsigned int delay) {
 }
 
 
+int uv_tcp_listen_batch(uv_tcp_t* handle, int backlog, unsigned int batch,
+    uv_connection_batch_cb cb) {
+  uv__set_artificial_error(handle->loop, UV_ENOSYS);
+  return -1;
+}
+
+
+int uv_tcp_reuseport(uv_tcp_t* handle, int enable) {
+  /* Windows has no SO_REUSEPORT; SO_REUSEADDR has different semantics. */
+  uv__set_artificial_error(handle->loop, UV_ENOTSUP);
+  return -1;
+}
+
+
 int uv_tcp_duplicate_socket(uv_tcp_t* handle, int pid,
     LPWSAPROTOCOL_INFOW protocol_info) {
   if (!(handle->flags & UV_HANDLE_CONNECTION)) {
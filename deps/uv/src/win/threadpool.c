@@ -70,6 +70,36 @@ int uv_queue_work(uv_loop_t* loop, uv_work_t* req, uv_work_cb work_cb,
 }
 
 
+int uv_queue_work_class(uv_loop_t* loop, uv_work_t* req,
+    uv_work_class_t work_class, uv_work_cb work_cb,
+    uv_after_work_cb after_work_cb) {
+  /* The system thread pool has no notion of work classes. */
+  return uv_queue_work(loop, req, work_cb, after_work_cb);
+}
+
+
+uv_err_t uv_threadpool_set_limit(uv_work_class_t work_class,
+    unsigned int limit) {
+  return uv__new_artificial_error(UV_ENOSYS);
+}
+
+
+uv_err_t uv_threadpool_resize(unsigned int nthreads) {
+  return uv__new_artificial_error(UV_ENOSYS);
+}
+
+
+unsigned int uv_threadpool_size(void) {
+  return 0;
+}
+
+
+uv_err_t uv_threadpool_get_stats(uv_work_class_t work_class,
+    uv_threadpool_stats_t* stats) {
+  return uv__new_artificial_error(UV_ENOSYS);
+}
+
+
 int uv_cancel(uv_req_t* req) {
   return -1;
 }
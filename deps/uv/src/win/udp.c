@@ -371,6 +371,13 @@ int uv__udp_recv_start(uv_udp_t* handle, uv_alloc_cb alloc_cb,
 }
 
 
+int uv__udp_recv_batch_start(uv_udp_t* handle, unsigned int count,
+    uv_alloc_cb alloc_cb, uv_udp_recv_cb recv_cb) {
+  uv__set_artificial_error(handle->loop, UV_ENOSYS);
+  return -1;
+}
+
+
 int uv__udp_recv_stop(uv_udp_t* handle) {
   if (handle->flags & UV_HANDLE_READING) {
     handle->flags &= ~UV_HANDLE_READING;
@@ -61,6 +61,7 @@
         'include/uv-private/tree.h',
         'src/fs-poll.c',
         'src/inet.c',
+        'src/timer-wheel.c',
         'src/uv-common.c',
         'src/uv-common.h',
         'src/version.c'
@@ -203,6 +204,7 @@
           'sources': [
             'src/unix/linux-core.c',
             'src/unix/linux-inotify.c',
+            'src/unix/linux-iouring.c',
             'src/unix/linux-syscalls.c',
             'src/unix/linux-syscalls.h',
           ],
@@ -486,8 +486,8 @@ DEFINE_string(testing_serialization_file, "/tmp/serdes",
 #endif
 
 // mksnapshot.cc
-DEFINE_string(extra_code, NULL, "A filename with extra code to be included in"
-                  " the snapshot (mksnapshot only)")
+DEFINE_string(extra_code, NULL, "A comma-separated list of files with extra"
+                  " code to be included in the snapshot (mksnapshot only)")
 
 //
 // Dev shell flags
@@ -291,6 +291,65 @@ class BZip2Decompressor : public StartupDataDecompressor {
 #endif
 
 
+// Compiles and runs one file of extra code in the current context.
+static void RunExtraCode(const char* name) {
+  HandleScope scope;
+  FILE* file = i::OS::FOpen(name, "rb");
+  if (file == NULL) {
+    fprintf(stderr, "Failed to open '%s': errno %d\n", name, errno);
+    exit(1);
+  }
+
+  fseek(file, 0, SEEK_END);
+  int size = ftell(file);
+  rewind(file);
+
+  char* chars = new char[size + 1];
+  chars[size] = '\0';
+  for (int i = 0; i < size;) {
+    int read = static_cast<int>(fread(&chars[i], 1, size - i, file));
+    if (read < 0) {
+      fprintf(stderr, "Failed to read '%s': errno %d\n", name, errno);
+      exit(1);
+    }
+    i += read;
+  }
+  fclose(file);
+  // Name the script after the file so that stack traces and the debugger
+  // point at it.
+  const char* base = name + strlen(name);
+  while (base > name && base[-1] != '/' && base[-1] != '\\') base--;
+  Local<String> source = String::New(chars);
+  delete[] chars;
+  TryCatch try_catch;
+  Local<Script> script = Script::Compile(source, String::New(base));
+  if (try_catch.HasCaught()) {
+    fprintf(stderr, "Failure compiling '%s' (see above)\n", name);
+    exit(1);
+  }
+  script->Run();
+  if (try_catch.HasCaught()) {
+    fprintf(stderr, "Failure running '%s'\n", name);
+    Local<Message> message = try_catch.Message();
+    Local<String> message_string = message->Get();
+    Local<String> message_line = message->GetSourceLine();
+    int len = 2 + message_string->Utf8Length() + message_line->Utf8Length();
+    char* buf = new char[len];
+    message_string->WriteUtf8(buf);
+    fprintf(stderr, "%s at line %d\n", buf, message->GetLineNumber());
+    message_line->WriteUtf8(buf);
+    fprintf(stderr, "%s\n", buf);
+    int from = message->GetStartColumn();
+    int to = message->GetEndColumn();
+    int i;
+    for (i = 0; i < from; i++) fprintf(stderr, " ");
+    for ( ; i <= to; i++) fprintf(stderr, "^");
+    fprintf(stderr, "\n");
+    exit(1);
+  }
+}
+
+
 int main(int argc, char** argv) {
   // By default, log code create information in the snapshot.
   i::FLAG_log_code = true;
@@ -322,56 +381,19 @@ int main(int argc, char** argv) {
     context->Enter();
     // Capture 100 frames if anything happens.
     V8::SetCaptureStackTraceForUncaughtExceptions(true, 100);
-    HandleScope scope;
-    const char* name = i::FLAG_extra_code;
-    FILE* file = i::OS::FOpen(name, "rb");
-    if (file == NULL) {
-      fprintf(stderr, "Failed to open '%s': errno %d\n", name, errno);
-      exit(1);
-    }
-
-    fseek(file, 0, SEEK_END);
-    int size = ftell(file);
-    rewind(file);
-
-    char* chars = new char[size + 1];
-    chars[size] = '\0';
-    for (int i = 0; i < size;) {
-      int read = static_cast<int>(fread(&chars[i], 1, size - i, file));
-      if (read < 0) {
-        fprintf(stderr, "Failed to read '%s': errno %d\n", name, errno);
-        exit(1);
-      }
-      i += read;
-    }
-    fclose(file);
-    Local<String> source = String::New(chars);
-    TryCatch try_catch;
-    Local<Script> script = Script::Compile(source);
-    if (try_catch.HasCaught()) {
-      fprintf(stderr, "Failure compiling '%s' (see above)\n", name);
-      exit(1);
-    }
-    script->Run();
-    if (try_catch.HasCaught()) {
-      fprintf(stderr, "Failure running '%s'\n", name);
-      Local<Message> message = try_catch.Message();
-      Local<String> message_string = message->Get();
-      Local<String> message_line = message->GetSourceLine();
-      int len = 2 + message_string->Utf8Length() + message_line->Utf8Length();
-      char* buf = new char(len);
-      message_string->WriteUtf8(buf);
-      fprintf(stderr, "%s at line %d\n", buf, message->GetLineNumber());
-      message_line->WriteUtf8(buf);
-      fprintf(stderr, "%s\n", buf);
-      int from = message->GetStartColumn();
-      int to = message->GetEndColumn();
-      int i;
-      for (i = 0; i < from; i++) fprintf(stderr, " ");
-      for ( ; i <= to; i++) fprintf(stderr, "^");
-      fprintf(stderr, "\n");
-      exit(1);
+    // --extra_code may name several files separated by commas. They are run
+    // in order, each as a separate script.
+    i::Vector<char> names = i::Vector<char>::New(
+        static_cast<int>(strlen(i::FLAG_extra_code)) + 1);
+    strcpy(names.start(), i::FLAG_extra_code);  // NOLINT
+    char* name = names.start();
+    while (name != NULL) {
+      char* next = strchr(name, ',');
+      if (next != NULL) *next++ = '\0';
+      if (*name != '\0') RunExtraCode(name);
+      name = next;
     }
+    names.Dispose();
     context->Exit();
   }
   // Make sure all builtin scripts are cached.
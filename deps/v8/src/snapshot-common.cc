@@ -81,6 +81,19 @@ void Snapshot::ReserveSpaceForLinkedInSnapshot(Deserializer* deserializer) {
 }
 
 
+int Snapshot::SpaceUsed(AllocationSpace space) {
+  switch (space) {
+    case NEW_SPACE: return new_space_used_;
+    case OLD_POINTER_SPACE: return pointer_space_used_;
+    case OLD_DATA_SPACE: return data_space_used_;
+    case CODE_SPACE: return code_space_used_;
+    case MAP_SPACE: return map_space_used_;
+    case CELL_SPACE: return cell_space_used_;
+    default: return 0;
+  }
+}
+
+
 bool Snapshot::Initialize(const char* snapshot_file) {
   if (snapshot_file) {
     int len;
@@ -52,6 +52,9 @@ class Snapshot {
   // successfully.
   static bool WriteToFile(const char* snapshot_file);
 
+  // Bytes the linked-in startup snapshot takes up in the given space.
+  static int SpaceUsed(AllocationSpace space);
+
   static const byte* data() { return data_; }
   static int size() { return size_; }
   static int raw_size() { return raw_size_; }
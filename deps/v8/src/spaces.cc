@@ -31,6 +31,7 @@
 #include "macro-assembler.h"
 #include "mark-compact.h"
 #include "platform.h"
+#include "snapshot.h"
 
 namespace v8 {
 namespace internal {
@@ -904,6 +905,10 @@ intptr_t PagedSpace::SizeOfFirstPage() {
     default:
       UNREACHABLE();
   }
+  // The startup snapshot is deserialized into the first page, which has to
+  // hold all of it. Snapshots built with mksnapshot --extra_code can be
+  // larger than the sizes above.
+  size = Max(size, Snapshot::SpaceUsed(identity()));
   return Min(size, AreaSize());
 }
 
@@ -208,17 +208,20 @@ function writeOrBuffer(stream, state, chunk, encoding, cb) {
   if (state.writing)
     state.buffer.push(new WriteReq(chunk, encoding, cb));
   else
-    doWrite(stream, state, len, chunk, encoding, cb);
+    doWrite(stream, state, false, len, chunk, encoding, cb);
 
   return ret;
 }
 
-function doWrite(stream, state, len, chunk, encoding, cb) {
+function doWrite(stream, state, writev, len, chunk, encoding, cb) {
   state.writelen = len;
   state.writecb = cb;
   state.writing = true;
   state.sync = true;
-  stream._write(chunk, encoding, state.onwrite);
+  if (writev)
+    stream._writev(chunk, state.onwrite);
+  else
+    stream._write(chunk, encoding, state.onwrite);
   state.sync = false;
 }
 
@@ -289,6 +292,18 @@ function onwriteDrain(stream, state) {
 function clearBuffer(stream, state) {
   state.bufferProcessing = true;
 
+  if (stream._writev && state.buffer.length > 1) {
+    // fast case, hand everything that piled up to _writev() in one go.
+    var buffer = state.buffer;
+    state.buffer = [];
+    doWrite(stream, state, true, state.length, buffer, '', function(er) {
+      for (var i = 0; i < buffer.length; i++)
+        buffer[i].callback(er);
+    });
+    state.bufferProcessing = false;
+    return;
+  }
+
   for (var c = 0; c < state.buffer.length; c++) {
     var entry = state.buffer[c];
     var chunk = entry.chunk;
@@ -296,7 +311,7 @@ function clearBuffer(stream, state) {
     var cb = entry.callback;
     var len = state.objectMode ? 1 : chunk.length;
 
-    doWrite(stream, state, len, chunk, encoding, cb);
+    doWrite(stream, state, false, len, chunk, encoding, cb);
 
     // if we didn't call the onwrite immediately, then
     // it means that we need to wait until it does.
@@ -319,6 +334,11 @@ Writable.prototype._write = function(chunk, encoding, cb) {
   cb(new Error('not implemented'));
 };
 
+// Streams that can write several chunks at once may implement
+// _writev(chunks, cb), where chunks is an array of {chunk, encoding}
+// objects.  It is used to flush the buffered writes in one call.
+Writable.prototype._writev = null;
+
 Writable.prototype.end = function(chunk, encoding, cb) {
   var state = this._writableState;
 
@@ -53,9 +53,11 @@ var cluster = module.exports = new Cluster();
 var masterStarted = false;
 var ids = 0;
 var serverHandlers = {};
+var roundRobinHandles = {};
 
 // Used in the worker:
 var serverListeners = {};
+var roundRobinProxies = {};
 var queryIds = 0;
 var queryCallbacks = {};
 
@@ -63,6 +65,11 @@ var queryCallbacks = {};
 cluster.isWorker = 'NODE_UNIQUE_ID' in process.env;
 cluster.isMaster = ! cluster.isWorker;
 
+// Workers bind their own SO_REUSEPORT listen sockets when the master
+// was set up with reusePort, see listen() in net.js.
+cluster._reusePort = cluster.isWorker &&
+                     process.env.NODE_CLUSTER_REUSEPORT === '1';
+
 // The worker object is only used in a worker
 cluster.worker = cluster.isWorker ? {} : null;
 // The workers array is only used in the master
@@ -131,7 +138,9 @@ cluster.setupMaster = function(options) {
     exec: options.exec || process.argv[1],
     execArgv: execArgv,
     args: options.args || process.argv.slice(2),
-    silent: options.silent || false
+    silent: options.silent || false,
+    reusePort: options.reusePort || false,
+    roundRobin: options.roundRobin || false
   };
 
   // emit setup event
@@ -168,7 +177,7 @@ function handleResponse(outMessage, outHandle, inMessage, inHandle, worker) {
 
   // Call callback if a query echo is received
   if (inMessage._queryEcho) {
-    queryCallbacks[inMessage._queryEcho](inMessage.content, inHandle);
+    queryCallbacks[inMessage._queryEcho](inMessage, inHandle);
     delete queryCallbacks[inMessage._queryEcho];
   }
 
@@ -194,7 +203,7 @@ function handleMessage(worker, inMessage, inHandle) {
 
   // Run handler if it exists
   if (messageHandler[message.cmd]) {
-    messageHandler[message.cmd](message, worker, respond);
+    messageHandler[message.cmd](message, worker, respond, inHandle);
   }
 
   // Send respond if it hasn't been called yet
@@ -226,18 +235,46 @@ if (cluster.isMaster) {
     var key = args.join(':');
     var handler;
 
+    // In round-robin mode the master keeps the listen socket to itself and
+    // hands out the accepted connections instead.
+    if (settings.roundRobin &&
+        (message.addressType === 4 || message.addressType === 6) &&
+        typeof message.fd !== 'number') {
+      handler = roundRobinHandles[key];
+      if (!handler) {
+        handler = new RoundRobinHandle(key,
+                                       message.address,
+                                       message.port,
+                                       message.addressType);
+      }
+
+      if (handler.errno) {
+        send({ roundRobin: true, errno: handler.errno });
+      } else {
+        roundRobinHandles[key] = handler;
+        handler.add(worker);
+        send({ roundRobin: true, sockname: handler.handle.getsockname() });
+      }
+      return;
+    }
+
     if (serverHandlers.hasOwnProperty(key)) {
       handler = serverHandlers[key];
     } else if (message.addressType === 'udp4' ||
                message.addressType === 'udp6') {
       var dgram = require('dgram');
       handler = dgram._createSocketHandle.apply(net, args);
-      serverHandlers[key] = handler;
     } else {
       handler = net._createServerHandle.apply(net, args);
-      serverHandlers[key] = handler;
     }
 
+    // Report the bind error instead of caching a handle that doesn't exist
+    if (!handler) {
+      send({ errno: process._errno });
+      return;
+    }
+    serverHandlers[key] = handler;
+
     // echo callback with the fd handler associated with it
     send({}, handler);
   };
@@ -266,6 +303,18 @@ if (cluster.isMaster) {
   messageHandler.suicide = function(message, worker) {
     worker.suicide = true;
   };
+
+  // A worker closed its round-robin server
+  messageHandler.close = function(message, worker) {
+    var handler = roundRobinHandles[message.key];
+    if (handler) handler.remove(worker);
+  };
+
+  // A worker is done with some of the connections it was handed
+  messageHandler.release = function(message, worker) {
+    var handler = roundRobinHandles[message.key];
+    if (handler) handler.release(worker, message.count);
+  };
 }
 
 
@@ -276,8 +325,195 @@ else if (cluster.isWorker) {
   messageHandler.disconnect = function(message, worker) {
     worker.disconnect();
   };
+
+  // Handle a connection accepted by the master in round-robin mode
+  messageHandler.newconn = function(message, worker, send, handle) {
+    var proxy = roundRobinProxies[message.key];
+
+    if (!handle) return send({ accepted: false });
+
+    // The server went away while the connection was in flight. Close our
+    // copy and let the master pass it on to another worker.
+    if (!proxy) {
+      handle.close();
+      return send({ accepted: false });
+    }
+
+    send({ accepted: true });
+    proxy.onconnection(handle);
+
+    // onconnection() closes the handle itself when over maxConnections.
+    if (handle.owner)
+      handle.owner.once('close', proxy.release.bind(proxy));
+    else
+      proxy.release();
+  };
 }
 
+
+// Master side of a round-robin server. The master owns the listen socket,
+// accepts connections and sends each one to a worker over the IPC channel.
+// The worker with the fewest connections still open gets the next one, with
+// ties broken in round-robin order, so workers that are slow to finish their
+// connections are handed fewer new ones.
+function RoundRobinHandle(key, address, port, addressType) {
+  this.key = key;
+  this.workers = [];
+  this.load = {};
+  this.pending = {};
+  this.next = 0;
+  this.errno = null;
+  this.handle = net._createServerHandle(address, port, addressType);
+
+  if (this.handle && this.handle.listen(511)) {
+    this.handle.close();
+    this.handle = null;
+  }
+
+  if (!this.handle) {
+    this.errno = process._errno;
+    return;
+  }
+
+  this.handle.onconnection = this.distribute.bind(this);
+}
+
+RoundRobinHandle.prototype.add = function(worker) {
+  if (this.workers.indexOf(worker) !== -1) return;
+  this.workers.push(worker);
+  this.load[worker.id] = 0;
+  this.pending[worker.id] = [];
+};
+
+RoundRobinHandle.prototype.remove = function(worker) {
+  var index = this.workers.indexOf(worker);
+  if (index === -1) return;
+
+  this.workers.splice(index, 1);
+  if (this.next > index) this.next--;
+  if (this.next >= this.workers.length) this.next = 0;
+
+  // A live worker still answers for the connections in flight to it, which
+  // then go to someone else. A dead one never will, so drop them.
+  if (!worker.process.connected) {
+    this.pending[worker.id].splice(0).forEach(function(handle) {
+      handle.close();
+    });
+  }
+  delete this.load[worker.id];
+  delete this.pending[worker.id];
+
+  if (this.workers.length === 0) {
+    this.handle.close();
+    this.handle = null;
+    delete roundRobinHandles[this.key];
+  }
+};
+
+RoundRobinHandle.prototype.release = function(worker, count) {
+  if (this.load.hasOwnProperty(worker.id))
+    this.load[worker.id] = Math.max(0, this.load[worker.id] - count);
+};
+
+RoundRobinHandle.prototype.pick = function() {
+  var workers = this.workers;
+  var best = -1;
+  var bestLoad = Infinity;
+
+  for (var i = 0; i < workers.length; i++) {
+    var index = (this.next + i) % workers.length;
+    var worker = workers[index];
+    if (!worker.process.connected) continue;
+    if (this.load[worker.id] < bestLoad) {
+      best = index;
+      bestLoad = this.load[worker.id];
+    }
+  }
+
+  if (best === -1) return null;
+  this.next = (best + 1) % workers.length;
+  return workers[best];
+};
+
+RoundRobinHandle.prototype.distribute = function(clientHandle) {
+  // Accept errors are transient (EMFILE and the like), keep listening.
+  if (!clientHandle) return;
+
+  var worker = this.pick();
+  if (!worker) {
+    clientHandle.close();
+    return;
+  }
+
+  var self = this;
+  var pending = this.pending[worker.id];
+  pending.push(clientHandle);
+  this.load[worker.id]++;
+
+  var message = { cmd: 'newconn', key: this.key };
+  sendInternalMessage(worker, message, clientHandle, function(reply) {
+    var index = pending.indexOf(clientHandle);
+    if (index === -1) return;  // Already closed, the worker died.
+    pending.splice(index, 1);
+
+    // The worker has its own copy of the socket now.
+    if (reply.accepted) {
+      clientHandle.close();
+      return;
+    }
+
+    self.release(worker, 1);
+    if (self.handle)
+      self.distribute(clientHandle);
+    else
+      clientHandle.close();
+  });
+};
+
+
+// Worker side of a round-robin server. It stands in for the TCP handle of a
+// net.Server; connections arrive from the master instead of from accept().
+function RoundRobinProxy(key, sockname) {
+  this.key = key;
+  this.sockname = sockname;
+  this.released = 0;
+  this.onconnection = null;
+  this.owner = null;
+}
+
+RoundRobinProxy.prototype.listen = function(backlog) {
+  return 0;
+};
+
+RoundRobinProxy.prototype.getsockname = function() {
+  return this.sockname;
+};
+
+RoundRobinProxy.prototype.ref = function() {};
+RoundRobinProxy.prototype.unref = function() {};
+
+RoundRobinProxy.prototype.close = function() {
+  if (roundRobinProxies[this.key] === this)
+    delete roundRobinProxies[this.key];
+  if (process.connected)
+    sendInternalMessage(cluster.worker, { cmd: 'close', key: this.key });
+};
+
+// Report closed connections back to the master, at most once per tick.
+RoundRobinProxy.prototype.release = function() {
+  if (this.released++ !== 0) return;
+
+  var self = this;
+  setImmediate(function() {
+    var count = self.released;
+    self.released = 0;
+    if (process.connected) {
+      sendInternalMessage(cluster.worker,
+                          { cmd: 'release', key: self.key, count: count });
+    }
+  });
+};
+
 function toDecInt(value) {
   value = parseInt(value, 10);
   return isNaN(value) ? null : value;
@@ -307,6 +543,11 @@ function Worker(customEnv) {
     // first: copy and add id property
     var envCopy = util._extend({}, env);
     envCopy['NODE_UNIQUE_ID'] = this.id;
+    if (settings.reusePort) {
+      envCopy['NODE_CLUSTER_REUSEPORT'] = '1';
+    } else {
+      delete envCopy['NODE_CLUSTER_REUSEPORT'];
+    }
     // second: extend envCopy with the env argument
     if (isObject(customEnv)) {
       envCopy = util._extend(envCopy, customEnv);
@@ -365,6 +606,16 @@ function prepareExit(worker, state) {
   // Remove from workers in the master
   if (cluster.isMaster) {
     delete cluster.workers[worker.id];
+    for (var key in roundRobinHandles) {
+      roundRobinHandles[key].remove(worker);
+    }
+
+    // Replies to messages still in flight to the worker will never come
+    var prefix = worker.id + ':';
+    for (var echo in queryCallbacks) {
+      if (echo.indexOf(prefix) === 0)
+        delete queryCallbacks[echo];
+    }
   }
 }
 
@@ -554,6 +805,37 @@ cluster._setupWorker = function() {
 // Internal function. Called by net.js and dgram.js when attempting to bind a
 // TCP server or UDP socket.
 cluster._getServer = function(tcpSelf, address, port, addressType, fd, cb) {
+  cluster._addServer(tcpSelf, address, port, addressType, fd);
+
+  // Request the fd handler from the master process
+  var message = {
+    cmd: 'queryServer',
+    address: address,
+    port: port,
+    addressType: addressType,
+    fd: fd
+  };
+
+  // The callback will be stored until the master has responded. A failed
+  // bind comes back with the master's errno instead of a handle.
+  sendInternalMessage(cluster.worker, message, function(msg, handle) {
+    if (msg.errno)
+      return cb(null, msg.errno);
+
+    if (msg.roundRobin) {
+      var key = [address, port, addressType, fd].join(':');
+      handle = roundRobinProxies[key] = new RoundRobinProxy(key,
+                                                            msg.sockname);
+    }
+    cb(handle);
+  });
+
+};
+
+// Internal function. Track a server in the worker and tell the master once
+// it is listening. Used directly by net.js for servers that bind their own
+// socket instead of getting one from the master.
+cluster._addServer = function(tcpSelf, address, port, addressType, fd) {
   // This can only be called from a worker.
   assert(cluster.isWorker);
 
@@ -572,19 +854,4 @@ cluster._getServer = function(tcpSelf, address, port, addressType, fd, cb) {
       fd: fd
     });
   });
-
-  // Request the fd handler from the master process
-  var message = {
-    cmd: 'queryServer',
-    address: address,
-    port: port,
-    addressType: addressType,
-    fd: fd
-  };
-
-  // The callback will be stored until the master has responded
-  sendInternalMessage(cluster.worker, message, function(msg, handle) {
-    cb(handle);
-  });
-
 };
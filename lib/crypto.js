@@ -131,6 +131,14 @@ exports.createCredentials = function(options, context) {
     c.context.setSessionIdContext(options.sessionIdContext);
   }
 
+  if (options.sessionCache) {
+    c.context.setSessionCache(options.sessionCache._handle);
+  }
+
+  if (options.ticketKeys) {
+    c.context.setTicketKeys(options.ticketKeys);
+  }
+
   if (options.pfx) {
     var pfx = options.pfx;
     var passphrase = options.passphrase;
@@ -186,37 +194,81 @@ function Hash(algorithm, options) {
   if (!(this instanceof Hash))
     return new Hash(algorithm, options);
   this._binding = new binding.Hash(algorithm);
+  this._async = !!(options && options.async);
   LazyTransform.call(this, options);
 }
 
 util.inherits(Hash, LazyTransform);
 
 Hash.prototype._transform = function(chunk, encoding, callback) {
+  if (this._async) {
+    this._binding.update(toBuf(chunk, encoding), null, callback);
+    return;
+  }
   this._binding.update(chunk, encoding);
   callback();
 };
 
 Hash.prototype._flush = function(callback) {
+  var self = this;
   var encoding = this._readableState.encoding || 'buffer';
+  if (this._async) {
+    this._binding.digest(encoding, function(err, digest) {
+      if (!err) self.push(digest, encoding);
+      callback(err);
+    });
+    return;
+  }
   this.push(this._binding.digest(encoding), encoding);
   callback();
 };
 
-Hash.prototype.update = function(data, encoding) {
+Hash.prototype.update = function(data, encoding, callback) {
+  if (typeof encoding === 'function') {
+    callback = encoding;
+    encoding = null;
+  }
   encoding = encoding || exports.DEFAULT_ENCODING;
   if (encoding === 'buffer' && typeof data === 'string')
     encoding = 'binary';
+  if (typeof callback === 'function') {
+    this._binding.update(toBuf(data, encoding), null, callback);
+    return this;
+  }
   this._binding.update(data, encoding);
   return this;
 };
 
 
-Hash.prototype.digest = function(outputEncoding) {
+Hash.prototype.digest = function(outputEncoding, callback) {
+  if (typeof outputEncoding === 'function') {
+    callback = outputEncoding;
+    outputEncoding = null;
+  }
   outputEncoding = outputEncoding || exports.DEFAULT_ENCODING;
+  if (typeof callback === 'function') {
+    this._binding.digest(outputEncoding, callback);
+    return;
+  }
   return this._binding.digest(outputEncoding);
 };
 
 
+// Digests all of `data` in the thread pool, as an HMAC when a `key` is given.
+exports.hash = function(algorithm, data, key, callback) {
+  if (typeof key === 'function') {
+    callback = key;
+    key = null;
+  }
+  if (typeof callback !== 'function')
+    throw new Error('No callback provided to hash');
+
+  data = toBuf(data);
+  key = key === null || key === undefined ? null : toBuf(key);
+  binding.hash(algorithm, data, key, callback);
+};
+
+
 exports.createHmac = exports.Hmac = Hmac;
 
 function Hmac(hmac, key, options) {
@@ -224,6 +276,7 @@ function Hmac(hmac, key, options) {
     return new Hmac(hmac, key, options);
   this._binding = new binding.Hmac();
   this._binding.init(hmac, toBuf(key));
+  this._async = !!(options && options.async);
   LazyTransform.call(this, options);
 }
 
@@ -388,8 +441,22 @@ Sign.prototype._write = function(chunk, encoding, callback) {
 
 Sign.prototype.update = Hash.prototype.update;
 
-Sign.prototype.sign = function(key, encoding) {
+Sign.prototype.sign = function(key, encoding, callback) {
+  if (typeof encoding === 'function') {
+    callback = encoding;
+    encoding = null;
+  }
   encoding = encoding || exports.DEFAULT_ENCODING;
+
+  if (typeof callback === 'function') {
+    this._binding.sign(toBuf(key), function(err, ret) {
+      if (!err && encoding && encoding !== 'buffer')
+        ret = ret.toString(encoding);
+      callback(err, ret);
+    });
+    return;
+  }
+
   var ret = this._binding.sign(toBuf(key));
 
   if (encoding && encoding !== 'buffer')
@@ -416,8 +483,21 @@ util.inherits(Verify, stream.Writable);
 Verify.prototype._write = Sign.prototype._write;
 Verify.prototype.update = Sign.prototype.update;
 
-Verify.prototype.verify = function(object, signature, sigEncoding) {
+Verify.prototype.verify = function(object, signature, sigEncoding,
+                                  callback) {
+  if (typeof sigEncoding === 'function') {
+    callback = sigEncoding;
+    sigEncoding = null;
+  }
   sigEncoding = sigEncoding || exports.DEFAULT_ENCODING;
+
+  if (typeof callback === 'function') {
+    this._binding.verify(toBuf(object),
+                         toBuf(signature, sigEncoding),
+                         callback);
+    return;
+  }
+
   return this._binding.verify(toBuf(object), toBuf(signature, sigEncoding));
 };
 
@@ -454,9 +534,23 @@ DiffieHellmanGroup.prototype.generateKeys =
     DiffieHellman.prototype.generateKeys =
     dhGenerateKeys;
 
-function dhGenerateKeys(encoding) {
-  var keys = this._binding.generateKeys();
+function dhGenerateKeys(encoding, callback) {
+  if (typeof encoding === 'function') {
+    callback = encoding;
+    encoding = null;
+  }
   encoding = encoding || exports.DEFAULT_ENCODING;
+
+  if (typeof callback === 'function') {
+    this._binding.generateKeys(function(err, keys) {
+      if (!err && encoding && encoding !== 'buffer')
+        keys = keys.toString(encoding);
+      callback(err, keys);
+    });
+    return;
+  }
+
+  var keys = this._binding.generateKeys();
   if (encoding && encoding !== 'buffer')
     keys = keys.toString(encoding);
   return keys;
@@ -467,9 +561,26 @@ DiffieHellmanGroup.prototype.computeSecret =
     DiffieHellman.prototype.computeSecret =
     dhComputeSecret;
 
-function dhComputeSecret(key, inEnc, outEnc) {
+function dhComputeSecret(key, inEnc, outEnc, callback) {
+  if (typeof inEnc === 'function') {
+    callback = inEnc;
+    inEnc = null;
+  } else if (typeof outEnc === 'function') {
+    callback = outEnc;
+    outEnc = null;
+  }
   inEnc = inEnc || exports.DEFAULT_ENCODING;
   outEnc = outEnc || exports.DEFAULT_ENCODING;
+
+  if (typeof callback === 'function') {
+    this._binding.computeSecret(toBuf(key, inEnc), function(err, ret) {
+      if (!err && outEnc && outEnc !== 'buffer')
+        ret = ret.toString(outEnc);
+      callback(err, ret);
+    });
+    return;
+  }
+
   var ret = this._binding.computeSecret(toBuf(key, inEnc));
   if (outEnc && outEnc !== 'buffer')
     ret = ret.toString(outEnc);
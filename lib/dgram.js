@@ -29,6 +29,9 @@ var BIND_STATE_UNBOUND = 0;
 var BIND_STATE_BINDING = 1;
 var BIND_STATE_BOUND = 2;
 
+// Mirrors UV_UDP_BATCH_MAX in uv.h.
+var RECV_BATCH_MAX = 64;
+
 // lazily loaded
 var cluster = null;
 var dns = null;
@@ -78,6 +81,7 @@ function newHandle(type) {
     handle.lookup = lookup6;
     handle.bind = handle.bind6;
     handle.send = handle.send6;
+    handle.sendBatch = handle.sendBatch6;
     return handle;
   }
 
@@ -114,6 +118,7 @@ function Socket(type, listener) {
 
   this._handle = handle;
   this._receiving = false;
+  this._recvBatch = 0;
   this._bindState = BIND_STATE_UNBOUND;
   this.type = type;
   this.fd = null; // compatibility hack
@@ -132,8 +137,9 @@ exports.createSocket = function(type, listener) {
 
 function startListening(socket) {
   socket._handle.onmessage = onMessage;
+  socket._handle.onmessages = onMessages;
   // Todo: handle errors
-  socket._handle.recvStart();
+  socket._handle.recvStart(socket._recvBatch);
   socket._receiving = true;
   socket._bindState = BIND_STATE_BOUND;
   socket.fd = -42; // compatibility hack
@@ -147,6 +153,7 @@ function replaceHandle(self, newHandle) {
   newHandle.lookup = self._handle.lookup;
   newHandle.bind = self._handle.bind;
   newHandle.send = self._handle.send;
+  newHandle.sendBatch = self._handle.sendBatch;
   newHandle.owner = self;
 
   // Replace the existing handle by the handle we got from master.
@@ -190,7 +197,13 @@ Socket.prototype.bind = function(/*port, address, callback*/) {
       cluster = require('cluster');
 
     if (cluster.isWorker) {
-      cluster._getServer(self, ip, port, self.type, -1, function(handle) {
+      cluster._getServer(self, ip, port, self.type, -1, function(handle, err) {
+        if (!handle) {
+          self.emit('error', errnoException(err, 'bind'));
+          self._bindState = BIND_STATE_UNBOUND;
+          return;
+        }
+
         if (!self._handle)
           // handle has been closed in the mean time.
           return handle.close();
@@ -274,18 +287,8 @@ Socket.prototype.send = function(buffer,
   // If the socket hasn't been bound yet, push the outbound packet onto the
   // send queue and send after binding is complete.
   if (self._bindState != BIND_STATE_BOUND) {
-    // If the send queue hasn't been initialized yet, do it, and install an
-    // event handler that flushes the send queue after binding is done.
-    if (!self._sendQueue) {
-      self._sendQueue = [];
-      self.once('listening', function() {
-        // Flush the send queue.
-        for (var i = 0; i < self._sendQueue.length; i++)
-          self.send.apply(self, self._sendQueue[i]);
-        self._sendQueue = undefined;
-      });
-    }
-    self._sendQueue.push([buffer, offset, length, port, address, callback]);
+    enqueueSend(self, self.send,
+                [buffer, offset, length, port, address, callback]);
     return;
   }
 
@@ -312,6 +315,22 @@ Socket.prototype.send = function(buffer,
 };
 
 
+function enqueueSend(self, method, args) {
+  // If the send queue hasn't been initialized yet, do it, and install an
+  // event handler that flushes the send queue after binding is done.
+  if (!self._sendQueue) {
+    self._sendQueue = [];
+    self.once('listening', function() {
+      // Flush the send queue.
+      for (var i = 0; i < self._sendQueue.length; i++)
+        self._sendQueue[i][0].apply(self, self._sendQueue[i][1]);
+      self._sendQueue = undefined;
+    });
+  }
+  self._sendQueue.push([method, args]);
+}
+
+
 function afterSend(status, handle, req, buffer) {
   var self = handle.owner;
 
@@ -320,6 +339,102 @@ function afterSend(status, handle, req, buffer) {
 }
 
 
+// Sends every buffer in `buffers` as a datagram to the same destination.
+// On Linux the datagrams go out with as few sendmmsg() calls as possible.
+Socket.prototype.sendBatch = function(buffers, port, address, callback) {
+  var self = this;
+
+  if (!Array.isArray(buffers))
+    throw new TypeError('First argument must be an array of buffers.');
+
+  for (var i = 0; i < buffers.length; i++) {
+    if (!Buffer.isBuffer(buffers[i]))
+      throw new TypeError('First argument must be an array of buffers.');
+  }
+
+  port = port | 0;
+  if (port <= 0 || port > 65535)
+    throw new RangeError('Port should be > 0 and < 65536');
+
+  callback = callback || noop;
+
+  self._healthCheck();
+
+  if (buffers.length === 0) {
+    process.nextTick(function() {
+      callback(null, 0);
+    });
+    return;
+  }
+
+  // Don't let the caller reuse the array while the datagrams are in flight.
+  buffers = buffers.slice();
+
+  if (self._bindState == BIND_STATE_UNBOUND)
+    self.bind(0, null);
+
+  if (self._bindState != BIND_STATE_BOUND) {
+    enqueueSend(self, self.sendBatch, [buffers, port, address, callback]);
+    return;
+  }
+
+  self._handle.lookup(address, function(err, ip) {
+    if (err) {
+      callback(err);
+      self.emit('error', err);
+    }
+    else if (self._handle) {
+      var req = self._handle.sendBatch(buffers, port, ip);
+      if (req) {
+        req.oncomplete = afterSendBatch;
+        req.cb = callback;
+      }
+      else {
+        var err = errnoException(process._errno, 'send');
+        process.nextTick(function() {
+          callback(err);
+        });
+      }
+    }
+  });
+};
+
+
+function afterSendBatch(status, handle, req, buffers) {
+  if (status) {
+    req.cb(errnoException(process._errno, 'send'));
+    return;
+  }
+
+  var bytes = 0;
+  for (var i = 0; i < buffers.length; i++)
+    bytes += buffers[i].length;
+
+  req.cb(null, bytes);
+}
+
+
+// Reads up to `count` datagrams per system call and delivers each batch in
+// a single 'messages' event. Zero switches back to one 'message' event per
+// datagram. Not supported on Windows.
+Socket.prototype.setRecvBatch = function(count) {
+  count = count | 0;
+  if (count < 0 || count > RECV_BATCH_MAX)
+    throw new RangeError('Batch size should be >= 0 and <= ' + RECV_BATCH_MAX);
+
+  this._healthCheck();
+  this._recvBatch = count;
+
+  if (this._receiving) {
+    this._handle.recvStop();
+    if (!this._handle.recvStart(count)) {
+      this._receiving = false;
+      throw errnoException(process._errno, 'recvStart');
+    }
+  }
+};
+
+
 Socket.prototype.close = function() {
   this._healthCheck();
   this._stopReceiving();
@@ -438,6 +553,22 @@ function onMessage(handle, slab, start, len, rinfo) {
 }
 
 
+function onMessages(handle, buffer, offsets, lengths, rinfos) {
+  var self = handle.owner;
+
+  if (self.listeners('messages').length > 0) {
+    self.emit('messages', buffer, offsets, lengths, rinfos);
+    return;
+  }
+
+  // Nobody asked for batches, fall back to one event per datagram.
+  for (var i = 0; i < offsets.length && self._handle; i++) {
+    var start = offsets[i];
+    self.emit('message', buffer.slice(start, start + lengths[i]), rinfos[i]);
+  }
+}
+
+
 Socket.prototype.ref = function() {
   if (this._handle)
     this._handle.ref();
@@ -195,6 +195,23 @@ fs.readFile = function(path, options, callback_) {
   var encoding = options.encoding;
   assertEncoding(encoding);
 
+  var flag = options.flag || 'r';
+
+  if (binding.readFile) {
+    // The whole open, fstat, read, close sequence runs in one threadpool job.
+    if (!nullCheck(path, callback)) return;
+    binding.readFile(pathModule._makeLong(path),
+                     stringToFlags(flag),
+                     438 /*=0666*/,
+                     function(er, buffer) {
+      if (er) return callback(er);
+      buffer = new Buffer(buffer, buffer.length, 0);
+      if (encoding) buffer = buffer.toString(encoding);
+      callback(null, buffer);
+    });
+    return;
+  }
+
   // first, stat the file, so we know the size.
   var size;
   var buffer; // single buffer with file data
@@ -202,7 +219,6 @@ fs.readFile = function(path, options, callback_) {
   var pos = 0;
   var fd;
 
-  var flag = options.flag || 'r';
   fs.open(path, flag, 438 /*=0666*/, function(er, fd_) {
     if (er) return callback(er);
     fd = fd_;
@@ -643,47 +659,363 @@ fs.mkdirSync = function(path, mode) {
                        modeNum(mode, 511 /*=0777*/));
 };
 
-fs.readdir = function(path, callback) {
+fs.readdir = function(path, options, callback) {
+  if (typeof options === 'function') {
+    callback = options;
+    options = undefined;
+  }
   callback = makeCallback(callback);
   if (!nullCheck(path, callback)) return;
-  binding.readdir(pathModule._makeLong(path), callback);
+  path = pathModule._makeLong(path);
+  if (!options || !options.withFileTypes) {
+    binding.readdir(path, callback);
+    return;
+  }
+  binding.readdirTypes(path, function(err, result) {
+    if (err) return callback(err);
+    var dirents = toDirents(result);
+    resolveDirentTypes(path, dirents, function() {
+      callback(null, dirents);
+    });
+  });
 };
 
-fs.readdirSync = function(path) {
+fs.readdirSync = function(path, options) {
   nullCheck(path);
-  return binding.readdir(pathModule._makeLong(path));
+  path = pathModule._makeLong(path);
+  if (!options || !options.withFileTypes)
+    return binding.readdir(path);
+  var dirents = toDirents(binding.readdirTypes(path));
+  resolveDirentTypesSync(path, dirents);
+  return dirents;
+};
+
+// Entry types, as in DirentType in src/node_dir.cc.
+var DIRENT_UNKNOWN = 0;
+var DIRENT_FILE = 1;
+var DIRENT_DIR = 2;
+var DIRENT_LINK = 3;
+var DIRENT_FIFO = 4;
+var DIRENT_SOCKET = 5;
+var DIRENT_CHAR = 6;
+var DIRENT_BLOCK = 7;
+
+function Dirent(name, type) {
+  this.name = name;
+  this._type = type;
+}
+fs.Dirent = Dirent;
+
+Dirent.prototype.isFile = function() {
+  return this._type === DIRENT_FILE;
 };
 
-fs.fstat = function(fd, callback) {
-  binding.fstat(fd, makeCallback(callback));
+Dirent.prototype.isDirectory = function() {
+  return this._type === DIRENT_DIR;
 };
 
-fs.lstat = function(path, callback) {
+Dirent.prototype.isSymbolicLink = function() {
+  return this._type === DIRENT_LINK;
+};
+
+Dirent.prototype.isFIFO = function() {
+  return this._type === DIRENT_FIFO;
+};
+
+Dirent.prototype.isSocket = function() {
+  return this._type === DIRENT_SOCKET;
+};
+
+Dirent.prototype.isCharacterDevice = function() {
+  return this._type === DIRENT_CHAR;
+};
+
+Dirent.prototype.isBlockDevice = function() {
+  return this._type === DIRENT_BLOCK;
+};
+
+// result is [names, types] from the binding.
+function toDirents(result) {
+  var names = result[0];
+  var types = result[1];
+  var dirents = new Array(names.length);
+  for (var i = 0; i < names.length; i++)
+    dirents[i] = new Dirent(names[i], types[i]);
+  return dirents;
+}
+
+function direntType(mode) {
+  switch (mode & constants.S_IFMT) {
+    case constants.S_IFREG: return DIRENT_FILE;
+    case constants.S_IFDIR: return DIRENT_DIR;
+    case constants.S_IFLNK: return DIRENT_LINK;
+    case constants.S_IFIFO: return DIRENT_FIFO;
+    case constants.S_IFSOCK: return DIRENT_SOCKET;
+    case constants.S_IFCHR: return DIRENT_CHAR;
+    case constants.S_IFBLK: return DIRENT_BLOCK;
+  }
+  return DIRENT_UNKNOWN;
+}
+
+// Some file systems don't report entry types, and some platforms never do.
+// Fill those in with one batched lstat of the unknown entries. Entries that
+// can't be lstat-ed any more (removed in the meantime) stay unknown.
+function unknownDirents(dirents) {
+  return dirents.filter(function(dirent) {
+    return dirent._type === DIRENT_UNKNOWN;
+  });
+}
+
+function setDirentTypes(dirents, result) {
+  for (var i = 0; i < dirents.length; i++) {
+    if (!result.errors || !result.errors[i])
+      dirents[i]._type = direntType(result.data[i * STAT_FIELDS + 2]);  // mode
+  }
+}
+
+function direntPaths(path, dirents) {
+  return dirents.map(function(dirent) {
+    return pathModule.join(path, dirent.name);
+  });
+}
+
+function resolveDirentTypes(path, dirents, callback) {
+  var unknown = unknownDirents(dirents);
+  if (unknown.length === 0) return callback();
+  fs.statMany(direntPaths(path, unknown), true, function(err, result) {
+    if (!err) setDirentTypes(unknown, result);
+    callback();
+  });
+}
+
+function resolveDirentTypesSync(path, dirents) {
+  var unknown = unknownDirents(dirents);
+  if (unknown.length === 0) return;
+  setDirentTypes(unknown, fs.statManySync(direntPaths(path, unknown), true));
+}
+
+// The default number of entries that dir.readNext() returns at most.
+var DIR_BATCH_SIZE = 128;
+
+function Dir(handle, path) {
+  this.path = path;
+  this._handle = handle;
+}
+fs.Dir = Dir;
+
+fs.opendir = function(path, callback) {
   callback = makeCallback(callback);
   if (!nullCheck(path, callback)) return;
-  binding.lstat(pathModule._makeLong(path), callback);
+  binding.opendir(pathModule._makeLong(path), function(err, handle) {
+    if (err) return callback(err);
+    callback(null, new Dir(handle, path));
+  });
+};
+
+fs.opendirSync = function(path) {
+  nullCheck(path);
+  return new Dir(binding.opendir(pathModule._makeLong(path)), path);
 };
 
-fs.stat = function(path, callback) {
+function dirBatchSize(count) {
+  if (count === undefined) return DIR_BATCH_SIZE;
+  if (count !== (count >>> 0) || count === 0)
+    throw new TypeError('count must be a positive integer');
+  return count;
+}
+
+// Calls back with an array of at most `count` fs.Dirent objects, or with null
+// once every entry has been read. Only one readNext() or close() can be in
+// progress at a time.
+Dir.prototype.readNext = function(count, callback) {
+  if (typeof count === 'function') {
+    callback = count;
+    count = undefined;
+  }
+  callback = makeCallback(callback);
+
+  var self = this;
+  try {
+    this._handle.read(dirBatchSize(count), function(err, result) {
+      if (err) return callback(err);
+      if (result === null) return callback(null, null);
+      var dirents = toDirents(result);
+      resolveDirentTypes(self.path, dirents, function() {
+        callback(null, dirents);
+      });
+    });
+  } catch (er) {
+    process.nextTick(function() {
+      callback(er);
+    });
+  }
+};
+
+Dir.prototype.readNextSync = function(count) {
+  var result = this._handle.read(dirBatchSize(count));
+  if (result === null) return null;
+  var dirents = toDirents(result);
+  resolveDirentTypesSync(this.path, dirents);
+  return dirents;
+};
+
+Dir.prototype.close = function(callback) {
+  callback = makeCallback(callback);
+  try {
+    this._handle.close(callback);
+  } catch (er) {
+    process.nextTick(function() {
+      callback(er);
+    });
+  }
+};
+
+Dir.prototype.closeSync = function() {
+  this._handle.close();
+};
+
+// Number of values in one stat record: dev, ino, mode, nlink, uid, gid, rdev,
+// size, blksize, blocks, atime, mtime, ctime.
+var STAT_FIELDS = 13;
+
+function isStatValues(values) {
+  return values instanceof Float64Array && values.length >= STAT_FIELDS;
+}
+
+function checkStatValues(values) {
+  if (values !== undefined && !isStatValues(values))
+    throw new TypeError('values must be a Float64Array of at least ' +
+                        STAT_FIELDS + ' elements');
+}
+
+fs.fstat = function(fd, values, callback) {
+  if (typeof values === 'function') {
+    callback = values;
+    values = undefined;
+  }
+  checkStatValues(values);
+  if (values)
+    binding.fstat(fd, values, makeCallback(callback));
+  else
+    binding.fstat(fd, makeCallback(callback));
+};
+
+fs.lstat = function(path, values, callback) {
+  if (typeof values === 'function') {
+    callback = values;
+    values = undefined;
+  }
+  checkStatValues(values);
+  callback = makeCallback(callback);
+  if (!nullCheck(path, callback)) return;
+  if (values)
+    binding.lstat(pathModule._makeLong(path), values, callback);
+  else
+    binding.lstat(pathModule._makeLong(path), callback);
+};
+
+fs.stat = function(path, values, callback) {
+  if (typeof values === 'function') {
+    callback = values;
+    values = undefined;
+  }
+  checkStatValues(values);
   callback = makeCallback(callback);
   if (!nullCheck(path, callback)) return;
-  binding.stat(pathModule._makeLong(path), callback);
+  if (values)
+    binding.stat(pathModule._makeLong(path), values, callback);
+  else
+    binding.stat(pathModule._makeLong(path), callback);
 };
 
-fs.fstatSync = function(fd) {
+fs.fstatSync = function(fd, values) {
+  checkStatValues(values);
+  if (values)
+    return binding.fstat(fd, values);
   return binding.fstat(fd);
 };
 
-fs.lstatSync = function(path) {
+fs.lstatSync = function(path, values) {
+  checkStatValues(values);
   nullCheck(path);
+  if (values)
+    return binding.lstat(pathModule._makeLong(path), values);
   return binding.lstat(pathModule._makeLong(path));
 };
 
-fs.statSync = function(path) {
+fs.statSync = function(path, values) {
+  checkStatValues(values);
   nullCheck(path);
+  if (values)
+    return binding.stat(pathModule._makeLong(path), values);
   return binding.stat(pathModule._makeLong(path));
 };
 
+function statManyPaths(paths) {
+  if (!Array.isArray(paths))
+    throw new TypeError('paths must be an array');
+  return paths.map(function(path) {
+    path = '' + path;
+    nullCheck(path);
+    return pathModule._makeLong(path);
+  });
+}
+
+fs.statMany = function(paths, lstat, callback) {
+  if (typeof lstat === 'function') {
+    callback = lstat;
+    lstat = false;
+  }
+  callback = makeCallback(callback);
+
+  try {
+    paths = statManyPaths(paths);
+  } catch (er) {
+    process.nextTick(function() {
+      callback(er);
+    });
+    return;
+  }
+
+  var data = new Float64Array(paths.length * STAT_FIELDS);
+  binding.statMany(paths, !!lstat, data, function(err, errors) {
+    if (err) return callback(err);
+    callback(null, { data: data, errors: errors });
+  });
+};
+
+fs.statManySync = function(paths, lstat) {
+  paths = statManyPaths(paths);
+  var data = new Float64Array(paths.length * STAT_FIELDS);
+  var errors = binding.statMany(paths, !!lstat, data);
+  return { data: data, errors: errors };
+};
+
+if (binding.mmap) {
+  fs.mmap = function(fd, offset, length, prot, advice) {
+    if (prot === undefined || prot === null) prot = constants.PROT_READ;
+    var slow = binding.mmap(fd, offset, length, prot);
+    if (advice !== undefined && advice !== null)
+      binding.madvise(slow, 0, length, advice);
+    return new Buffer(slow, length, 0);
+  };
+
+  fs.madvise = function(buffer, advice) {
+    if (!Buffer.isBuffer(buffer))
+      throw new TypeError('buffer must be a Buffer');
+    binding.madvise(buffer.parent || buffer,
+                    buffer.offset || 0,
+                    buffer.length,
+                    advice);
+  };
+
+  fs.munmap = function(buffer) {
+    if (!Buffer.isBuffer(buffer))
+      throw new TypeError('buffer must be a Buffer');
+    binding.munmap(buffer.parent || buffer);
+  };
+}
+
 fs.readlink = function(path, callback) {
   callback = makeCallback(callback);
   if (!nullCheck(path, callback)) return;
@@ -939,6 +1271,22 @@ fs.writeFile = function(path, data, options, callback) {
   assertEncoding(options.encoding);
 
   var flag = options.flag || 'w';
+
+  if (binding.writeFile) {
+    // The whole open, write, close sequence runs in one threadpool job.
+    if (!nullCheck(path, callback)) return;
+    var buffer = Buffer.isBuffer(data) ? data : new Buffer('' + data,
+        options.encoding || 'utf8');
+    binding.writeFile(pathModule._makeLong(path),
+                      buffer,
+                      stringToFlags(flag),
+                      modeNum(options.mode, 438 /*=0666*/),
+                      function(er) {
+      callback(er);
+    });
+    return;
+  }
+
   fs.open(path, options.flag || 'w', options.mode, function(openErr, fd) {
     if (openErr) {
       if (callback) callback(openErr);
@@ -382,7 +382,7 @@ Socket.prototype._read = function(n) {
   if (this._connecting || !this._handle) {
     debug('_read wait for connection');
     this.once('connect', this._read.bind(this, n));
-  } else if (!this._handle.reading) {
+  } else if (!this._handle.reading && !this._splicing) {
     // not already reading, start the flow
     debug('Socket._read readStart');
     this._handle.reading = true;
@@ -535,21 +535,7 @@ function onread(buffer, offset, length) {
 
   } else if (process._errno == 'EOF') {
     debug('EOF');
-
-    if (self._readableState.length === 0) {
-      self.readable = false;
-      maybeDestroy(self);
-    }
-
-    if (self.onend) self.once('end', self.onend);
-
-    // push a null to signal the end of data.
-    self.push(null);
-
-    // internal end event so that we know that the actual socket
-    // is no longer readable, and we can start the shutdown
-    // procedure. No need to wait for all the data to be consumed.
-    self.emit('_socketEnd');
+    onReadEOF(self);
   } else {
     debug('error', process._errno);
     // Error
@@ -558,6 +544,24 @@ function onread(buffer, offset, length) {
 }
 
 
+function onReadEOF(self) {
+  if (self._readableState.length === 0) {
+    self.readable = false;
+    maybeDestroy(self);
+  }
+
+  if (self.onend) self.once('end', self.onend);
+
+  // push a null to signal the end of data.
+  self.push(null);
+
+  // internal end event so that we know that the actual socket
+  // is no longer readable, and we can start the shutdown
+  // procedure. No need to wait for all the data to be consumed.
+  self.emit('_socketEnd');
+}
+
+
 Socket.prototype._getpeername = function() {
   if (!this._handle || !this._handle.getpeername) {
     return {};
@@ -614,7 +618,12 @@ Socket.prototype.write = function(chunk, encoding, cb) {
 };
 
 
-Socket.prototype._write = function(data, encoding, cb) {
+Socket.prototype._writeGeneric = function(writev, data, encoding, cb) {
+  // sendFile() added the file bytes to the Writable's length, take them off
+  // again when this write completes, whichever way it does.
+  if (!writev && data._sendFile)
+    this._writableState.writelen = data._sendFile.length;
+
   // If we are still connecting, then buffer this for later.
   // The Writable logic will buffer up any more writes while
   // waiting for this one to be done.
@@ -622,7 +631,7 @@ Socket.prototype._write = function(data, encoding, cb) {
     this._pendingData = data;
     this._pendingEncoding = encoding;
     this.once('connect', function() {
-      this._write(data, encoding, cb);
+      this._writeGeneric(writev, data, encoding, cb);
     });
     return;
   }
@@ -636,8 +645,18 @@ Socket.prototype._write = function(data, encoding, cb) {
     return false;
   }
 
-  var enc = Buffer.isBuffer(data) ? 'buffer' : encoding;
-  var writeReq = createWriteReq(this._handle, data, enc);
+  if (writev ? hasFileSegment(data) : data._sendFile) {
+    this._writeSegments(writev ? data : [{ chunk: data }], 0, cb);
+    return;
+  }
+
+  var writeReq;
+  if (writev)
+    writeReq = createWritevReq(this._handle, data);
+  else {
+    var enc = Buffer.isBuffer(data) ? 'buffer' : encoding;
+    writeReq = createWriteReq(this._handle, data, enc);
+  }
 
   if (!writeReq || typeof writeReq !== 'object')
     return this._destroy(errnoException(process._errno, 'write'), cb);
@@ -653,6 +672,187 @@ Socket.prototype._write = function(data, encoding, cb) {
     writeReq.cb = cb;
 };
 
+
+Socket.prototype._writev = function(chunks, cb) {
+  this._writeGeneric(true, chunks, '', cb);
+};
+
+
+Socket.prototype._write = function(data, encoding, cb) {
+  this._writeGeneric(false, data, encoding, cb);
+};
+
+// Queue a file segment for sendFile(). It travels through the write queue
+// as an empty Buffer so that it is written in order with the data around it.
+// Its length still counts towards the Writable's buffered length, so that
+// write() and 'drain' apply backpressure for the file data too.
+Socket.prototype.sendFile = function(fd, offset, length, cb) {
+  if (typeof fd !== 'number' || fd < 0)
+    throw new TypeError('fd must be a file descriptor');
+  if (typeof offset !== 'number' || offset < 0)
+    throw new TypeError('offset must be a non-negative number');
+  if (typeof length !== 'number' || length < 0)
+    throw new TypeError('length must be a non-negative number');
+
+  var chunk = new Buffer(0);
+  chunk._sendFile = { fd: fd, offset: offset, length: length };
+
+  // After end() the chunk is refused with 'write after end' and never
+  // written, so its bytes must not be counted either.
+  var state = this._writableState;
+  if (!state.ended)
+    state.length += length;
+  return stream.Duplex.prototype.write.call(this, chunk, cb);
+};
+
+function hasFileSegment(data) {
+  for (var i = 0; i < data.length; i++) {
+    if (data[i].chunk._sendFile)
+      return true;
+  }
+  return false;
+}
+
+// Write a batch with file segments in it, starting at data[index]. Runs of
+// ordinary chunks and the file segments are all queued on the handle right
+// away so that the order is kept; `cb` goes with the last request. A stream
+// that cannot send files itself has the segment read and written in pieces
+// instead, and the rest of the batch waits until that is done.
+Socket.prototype._writeSegments = function(data, index, cb) {
+  var self = this;
+  var handle = this._handle;
+  var req = null;
+  var run = [];
+
+  for (var i = index; i < data.length; i++) {
+    var file = data[i].chunk._sendFile;
+    if (!file) {
+      run.push(data[i]);
+      continue;
+    }
+
+    if (run.length > 0) {
+      req = createWritevReq(handle, run);
+      run = [];
+      if (!this._dispatchWrite(req))
+        return this._destroy(errnoException(process._errno, 'write'), cb);
+    }
+
+    req = null;
+    if (typeof handle.sendFile === 'function')
+      req = handle.sendFile(file.fd, file.offset, file.length);
+
+    if (!req) {
+      if (typeof handle.sendFile === 'function' &&
+          process._errno !== 'ENOSYS' &&
+          process._errno !== 'ENOTSUP') {
+        return this._destroy(errnoException(process._errno, 'write'), cb);
+      }
+      return this._readAndWriteFile(file, function(err) {
+        if (err)
+          return self._destroy(err, cb);
+        self._writeSegments(data, i + 1, cb);
+      });
+    }
+
+    this._dispatchWrite(req);
+  }
+
+  if (run.length > 0) {
+    req = createWritevReq(handle, run);
+    if (!this._dispatchWrite(req))
+      return this._destroy(errnoException(process._errno, 'write'), cb);
+  }
+
+  if (!req || handle.writeQueueSize === 0)
+    cb();
+  else
+    req.cb = cb;
+};
+
+Socket.prototype._dispatchWrite = function(req) {
+  if (!req || typeof req !== 'object')
+    return false;
+  req.oncomplete = afterWrite;
+  this._bytesDispatched += req.bytes;
+  return true;
+};
+
+// No zero-copy path for this stream (Windows, TLS): read the segment with
+// fs.read() into a bounded Buffer and write it out one piece at a time, so
+// that neither the event loop nor memory use depends on the segment size.
+var SEND_FILE_CHUNK_SIZE = 64 * 1024;
+
+Socket.prototype._readAndWriteFile = function(file, cb) {
+  var self = this;
+  var fs = require('fs');
+  var buffer = new Buffer(Math.min(file.length, SEND_FILE_CHUNK_SIZE));
+  var sent = 0;
+
+  function read() {
+    if (sent === file.length)
+      return cb(null);
+    fs.read(file.fd,
+            buffer,
+            0,
+            Math.min(buffer.length, file.length - sent),
+            file.offset + sent,
+            onread);
+  }
+
+  function onread(err, bytesRead) {
+    if (err)
+      return cb(err);
+    if (self.destroyed || !self._handle)
+      return cb(new Error('This socket is closed.'));
+    // Same as the native path: the file ended early.
+    if (bytesRead === 0)
+      return cb(errnoException('EIO', 'write'));
+
+    // The buffer is only reused once this write has completed.
+    var req = self._handle.writeBuffer(buffer.slice(0, bytesRead));
+    if (!req || typeof req !== 'object')
+      return cb(errnoException(process._errno, 'write'));
+
+    req.oncomplete = onwrite;
+    self._bytesDispatched += req.bytes;
+    sent += bytesRead;
+    timers._unrefActive(self);
+  }
+
+  function onwrite(status) {
+    if (self.destroyed)
+      return;
+    if (status)
+      return cb(errnoException(process._errno, 'write'));
+    read();
+  }
+
+  read();
+};
+
+function createWritevReq(handle, data) {
+  // Handles without writev() get the chunks concatenated into one Buffer.
+  if (typeof handle.writev !== 'function') {
+    var list = data.map(function(entry) {
+      if (Buffer.isBuffer(entry.chunk))
+        return entry.chunk;
+      return new Buffer(entry.chunk, entry.encoding);
+    });
+    return handle.writeBuffer(Buffer.concat(list));
+  }
+
+  // Flatten into [chunk, encoding, chunk, encoding, ...]
+  var chunks = new Array(data.length << 1);
+  for (var i = 0; i < data.length; i++) {
+    var entry = data[i];
+    chunks[i * 2] = entry.chunk;
+    chunks[i * 2 + 1] = Buffer.isBuffer(entry.chunk) ? 'buffer' :
+                        entry.encoding;
+  }
+  return handle.writev(chunks);
+}
+
 function createWriteReq(handle, data, encoding) {
   switch (encoding) {
     case 'buffer':
@@ -677,6 +877,95 @@ function createWriteReq(handle, data, encoding) {
 }
 
 
+// Move everything read from this socket to `dest` in the native layer until
+// EOF, then end `dest`. Data already buffered in JS on either side is
+// flushed first so that the order is kept.
+Socket.prototype.splice = function(dest, cb) {
+  var self = this;
+  var bytes = 0;
+  var state = this._readableState;
+
+  if (!(dest instanceof Socket))
+    throw new TypeError('destination must be a net.Socket');
+  if (this._splicing)
+    throw new Error('Socket is already spliced');
+
+  this._splicing = true;
+
+  if (this._handle && this._handle.reading) {
+    this._handle.reading = false;
+    this._handle.readStop();
+  }
+
+  // Whatever was read but not consumed yet goes out first.
+  var chunk = state.length > 0 ? this.read() : null;
+  if (chunk !== null)
+    bytes += Buffer.isBuffer(chunk) ? chunk.length : Buffer.byteLength(chunk);
+
+  // The callback runs once the chunk (or nothing) has been queued on the
+  // handle, behind the writes that were buffered before it.
+  dest.write(chunk !== null ? chunk : new Buffer(0), start);
+
+  function start() {
+    if (self._connecting) {
+      self.once('connect', start);
+      return;
+    }
+
+    if (!self._handle || !dest._handle)
+      return done(new Error('This socket is closed.'));
+
+    if (state.ended) {
+      // EOF was already read in JS.
+      self._splicing = false;
+      dest.end();
+      return done(null);
+    }
+
+    if (typeof self._handle.pipe === 'function') {
+      self._handle.onpipe = onpipe;
+      if (self._handle.pipe(dest._handle) === 0)
+        return;
+      self._handle.onpipe = null;
+      if (process._errno !== 'ENOSYS' && process._errno !== 'ENOTSUP')
+        return done(errnoException(process._errno, 'pipe'));
+    }
+
+    // No native path for this pair of streams (Windows, TLS): fall back to
+    // a plain stream pipe.
+    var bytesRead = self.bytesRead;
+    self._splicing = false;
+    self.once('end', function() {
+      bytes += self.bytesRead - bytesRead;
+      done(null);
+    });
+    self.pipe(dest);
+  }
+
+  function onpipe(status, nbytes) {
+    this.onpipe = null;
+    self._splicing = false;
+    self.bytesRead += nbytes;
+    dest._bytesDispatched += nbytes;
+    bytes += nbytes;
+
+    if (status)
+      return done(errnoException(process._errno, 'pipe'));
+
+    onReadEOF(self);
+    dest.end();
+    done(null);
+  }
+
+  function done(err) {
+    if (cb)
+      cb(err, bytes);
+    else if (err)
+      self._destroy(err);
+  }
+};
+
+
 Socket.prototype.__defineGetter__('bytesWritten', function() {
   var bytes = this._bytesDispatched,
       state = this._writableState,
@@ -690,7 +979,15 @@ Socket.prototype.__defineGetter__('bytesWritten', function() {
       bytes += Buffer.byteLength(el.chunk, el.encoding);
   });
 
-  if (data) {
+  if (Array.isArray(data)) {
+    // was a writev, iterate over chunks to get total length
+    data.forEach(function(el) {
+      if (Buffer.isBuffer(el.chunk))
+        bytes += el.chunk.length;
+      else
+        bytes += Buffer.byteLength(el.chunk, el.encoding);
+    });
+  } else if (data) {
     if (Buffer.isBuffer(data))
       bytes += data.length;
     else
@@ -947,6 +1244,8 @@ function Server(/* [ options, ] listener */) {
   this._slaves = [];
 
   this.allowHalfOpen = options.allowHalfOpen || false;
+  this.acceptBatch = options.acceptBatch || 0;
+  this.acceptBacklog = -1;
 }
 util.inherits(Server, events.EventEmitter);
 exports.Server = Server;
@@ -955,8 +1254,11 @@ exports.Server = Server;
 function toNumber(x) { return (x = Number(x)) >= 0 ? x : false; }
 
 
+// Flags for TCP.prototype.bind(), keep in sync with src/tcp_wrap.cc.
+var TCP_REUSEPORT = 1;
+
 var createServerHandle = exports._createServerHandle =
-    function(address, port, addressType, fd) {
+    function(address, port, addressType, fd, flags) {
   var r = 0;
   // assign handle in listen, and clean up if bind or listen fails
   var handle;
@@ -991,9 +1293,9 @@ var createServerHandle = exports._createServerHandle =
   if (address || port) {
     debug('bind to ' + address);
     if (addressType == 6) {
-      r = handle.bind6(address, port);
+      r = handle.bind6(address, port, flags | 0);
     } else {
-      r = handle.bind(address, port);
+      r = handle.bind(address, port, flags | 0);
     }
   }
 
@@ -1033,7 +1335,7 @@ Server.prototype._listen2 = function(address, port, addressType, backlog, fd) {
   // Use a backlog of 512 entries. We pass 511 to the listen() call because
   // the kernel does: backlogsize = roundup_pow_of_two(backlogsize + 1);
   // which will thus give us a backlog of 512 entries.
-  r = self._handle.listen(backlog || 511);
+  r = self._handle.listen(backlog || 511, self.acceptBatch);
 
   if (r) {
     var ex = errnoException(process._errno, 'listen');
@@ -1062,7 +1364,37 @@ function listen(self, address, port, addressType, backlog, fd) {
     return;
   }
 
-  cluster._getServer(self, address, port, addressType, fd, function(handle) {
+  // In reusePort mode every worker binds its own SO_REUSEPORT socket so
+  // that the kernel spreads connections over the workers' accept queues.
+  // Random ports (port 0), pipes and fds still go through the master,
+  // as does everything on platforms without SO_REUSEPORT.
+  if (cluster._reusePort && port > 0 && addressType !== -1 &&
+      typeof fd !== 'number') {
+    var handle = createServerHandle(address, port, addressType, fd,
+                                    TCP_REUSEPORT);
+    if (handle) {
+      cluster._addServer(self, address, port, addressType, fd);
+      self._handle = handle;
+      self._listen2(address, port, addressType, backlog, fd);
+      return;
+    }
+    if (process._errno !== 'ENOTSUP') {
+      var error = errnoException(process._errno, 'listen');
+      process.nextTick(function() {
+        self.emit('error', error);
+      });
+      return;
+    }
+  }
+
+  cluster._getServer(self, address, port, addressType, fd, cb);
+
+  function cb(handle, err) {
+    if (!handle) {
+      self.emit('error', errnoException(err, 'bind'));
+      return;
+    }
+
     // Some operating systems (notably OS X and Solaris) don't report EADDRINUSE
     // errors right away. libuv mimics that behavior for the sake of platform
     // consistency but that means we have have a socket on our hands that is
@@ -1076,7 +1408,7 @@ function listen(self, address, port, addressType, backlog, fd) {
 
     self._handle = handle;
     self._listen2(address, port, addressType, backlog, fd);
-  });
+  }
 }
 
 
@@ -1149,12 +1481,25 @@ Server.prototype.address = function() {
   }
 };
 
-function onconnection(clientHandle) {
+function onconnection(clientHandle, pending) {
   var handle = this;
   var self = handle.owner;
 
   debug('onconnection');
 
+  // A batch of connections from a server with acceptBatch set.
+  if (Array.isArray(clientHandle)) {
+    self.acceptBacklog = pending;
+    for (var i = 0; i < clientHandle.length; i++) {
+      // A 'connection' listener may have closed the server.
+      if (self._handle === handle)
+        onconnection.call(handle, clientHandle[i]);
+      else
+        clientHandle[i].close();
+    }
+    return;
+  }
+
   if (!clientHandle) {
     self.emit('error', errnoException(process._errno, 'accept'));
     return;
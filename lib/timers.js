@@ -20,6 +20,7 @@
 // USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 var Timer = process.binding('timer_wrap').Timer;
+var WheelTimer = process.binding('timer_wrap').WheelTimer;
 var L = require('_linklist');
 var assert = require('assert').ok;
 
@@ -131,6 +132,9 @@ function listOnTimeout() {
 var unenroll = exports.unenroll = function(item) {
   L.remove(item);
 
+  if (item._wheelTimer)
+    item._wheelTimer.stop();
+
   var list = lists[item._idleTimeout];
   // if empty then stop the watcher
   debug('unenroll');
@@ -377,48 +381,22 @@ exports.clearImmediate = function(immediate) {
 
 // Internal APIs that need timeouts should use timers._unrefActive isntead of
 // timers.active as internal timeouts shouldn't hold the loop open
+//
+// These timeouts live on the timing wheel in timer_wrap, where restarting a
+// timeout on every read or write is O(1).
 
-var unrefList, unrefTimer;
-
-
-function unrefTimeout() {
-  var now = Date.now();
-
-  debug('unrefTimer fired');
-
-  var first;
-  while (first = L.peek(unrefList)) {
-    var diff = now - first._idleStart;
-
-    if (diff < first._idleTimeout) {
-      diff = first._idleTimeout - diff;
-      unrefTimer.start(diff, 0);
-      unrefTimer.when = now + diff;
-      debug('unrefTimer rescheudling for later');
-      return;
-    }
-
-    L.remove(first);
-
-    var domain = first.domain;
+function wheelOnTimeout() {
+  var item = this.owner;
+  var domain = item.domain;
 
-    if (!first._onTimeout) continue;
-    if (domain && domain._disposed) continue;
+  debug('wheel timer firing timeout');
 
-    try {
-      if (domain) domain.enter();
-      var threw = true;
-      debug('unreftimer firing timeout');
-      first._onTimeout();
-      threw = false;
-      if (domain) domain.exit();
-    } finally {
-      if (threw) process.nextTick(unrefTimeout);
-    }
-  }
+  if (!item._onTimeout) return;
+  if (domain && domain._disposed) return;
 
-  debug('unrefList is empty');
-  unrefTimer.when = -1;
+  if (domain) domain.enter();
+  item._onTimeout();
+  if (domain) domain.exit();
 }
 
 
@@ -429,55 +407,12 @@ exports._unrefActive = function(item) {
 
   L.remove(item);
 
-  if (!unrefList) {
-    debug('unrefList initialized');
-    unrefList = {};
-    L.init(unrefList);
-
-    debug('unrefTimer initialized');
-    unrefTimer = new Timer();
-    unrefTimer.unref();
-    unrefTimer.when = -1;
-    unrefTimer.ontimeout = unrefTimeout;
-  }
-
-  var now = Date.now();
-  item._idleStart = now;
-
-  if (L.isEmpty(unrefList)) {
-    debug('unrefList empty');
-    L.append(unrefList, item);
-
-    unrefTimer.start(msecs, 0);
-    unrefTimer.when = now + msecs;
-    debug('unrefTimer scheduled');
-    return;
-  }
-
-  var when = now + msecs;
-
-  debug('unrefList find where we can insert');
-
-  var cur, them;
-
-  for (cur = unrefList._idlePrev; cur != unrefList; cur = cur._idlePrev) {
-    them = cur._idleStart + cur._idleTimeout;
-
-    if (when < them) {
-      debug('unrefList inserting into middle of list');
-
-      L.append(cur, item);
-
-      if (unrefTimer.when > when) {
-        debug('unrefTimer is scheduled to fire too late, reschedule');
-        unrefTimer.start(msecs, 0);
-        unrefTimer.when = when;
-      }
-
-      return;
-    }
+  var timer = item._wheelTimer;
+  if (!timer) {
+    timer = item._wheelTimer = new WheelTimer();
+    timer.owner = item;
+    timer.ontimeout = wheelOnTimeout;
   }
 
-  debug('unrefList append to end');
-  L.append(unrefList, item);
+  timer.start(msecs);
 };
@@ -61,8 +61,10 @@ if (process.env.NODE_DEBUG && /tls/.test(process.env.NODE_DEBUG)) {
 
 
 var Connection = null;
+var tls_wrap = null;
 try {
   Connection = process.binding('crypto').Connection;
+  tls_wrap = process.binding('tls_wrap');
 } catch (e) {
   throw new Error('node.js not compiled with openssl crypto support.');
 }
@@ -830,8 +832,7 @@ function onclienthello(hello) {
 
     // Cycle data
     self._resumingSession = false;
-    self.cleartext.read(0);
-    self.encrypted.read(0);
+    self._cycle();
   }
 
   if (hello.sessionId.length <= 0 ||
@@ -891,32 +892,7 @@ function SecurePair(credentials, isServer, requestCert, rejectUnauthorized,
   this._rejectUnauthorized = rejectUnauthorized ? true : false;
   this._requestCert = requestCert ? true : false;
 
-  this.ssl = new Connection(this.credentials.context,
-                            this._isServer ? true : false,
-                            this._isServer ? this._requestCert :
-                                             options.servername,
-                            this._rejectUnauthorized);
-
-  if (this._isServer) {
-    this.ssl.onhandshakestart = onhandshakestart.bind(this);
-    this.ssl.onhandshakedone = onhandshakedone.bind(this);
-    this.ssl.onclienthello = onclienthello.bind(this);
-    this.ssl.onnewsession = onnewsession.bind(this);
-    this.ssl.lastHandshakeTime = 0;
-    this.ssl.handshakes = 0;
-  }
-
-  if (process.features.tls_sni) {
-    if (this._isServer && options.SNICallback) {
-      this.ssl.setSNICallback(options.SNICallback);
-    }
-    this.servername = null;
-  }
-
-  if (process.features.tls_npn && options.NPNProtocols) {
-    this.ssl.setNPNProtocols(options.NPNProtocols);
-    this.npnProtocol = null;
-  }
+  initConnection(this, options);
 
   /* Acts as a r/w stream to the cleartext side of the stream. */
   this.cleartext = new CleartextStream(this, options.cleartext);
@@ -941,6 +917,36 @@ function SecurePair(credentials, isServer, requestCert, rejectUnauthorized,
 util.inherits(SecurePair, events.EventEmitter);
 
 
+function initConnection(pair, options) {
+  pair.ssl = new Connection(pair.credentials.context,
+                            pair._isServer ? true : false,
+                            pair._isServer ? pair._requestCert :
+                                             options.servername,
+                            pair._rejectUnauthorized);
+
+  if (pair._isServer) {
+    pair.ssl.onhandshakestart = onhandshakestart.bind(pair);
+    pair.ssl.onhandshakedone = onhandshakedone.bind(pair);
+    pair.ssl.onclienthello = onclienthello.bind(pair);
+    pair.ssl.onnewsession = onnewsession.bind(pair);
+    pair.ssl.lastHandshakeTime = 0;
+    pair.ssl.handshakes = 0;
+  }
+
+  if (process.features.tls_sni) {
+    if (pair._isServer && options.SNICallback) {
+      pair.ssl.setSNICallback(options.SNICallback);
+    }
+    pair.servername = null;
+  }
+
+  if (process.features.tls_npn && options.NPNProtocols) {
+    pair.ssl.setNPNProtocols(options.NPNProtocols);
+    pair.npnProtocol = null;
+  }
+}
+
+
 exports.createSecurePair = function(credentials,
                                     isServer,
                                     requestCert,
@@ -953,6 +959,12 @@ exports.createSecurePair = function(credentials,
 };
 
 
+SecurePair.prototype._cycle = function() {
+  this.cleartext.read(0);
+  this.encrypted.read(0);
+};
+
+
 SecurePair.prototype.maybeInitFinished = function() {
   if (this.ssl && !this._secureEstablished && this.ssl.isInitFinished()) {
     if (process.features.tls_npn) {
@@ -1015,6 +1027,121 @@ SecurePair.prototype.error = function(returnOnly) {
   return err;
 };
 
+
+/**
+ * Runs the TLS connection on the handle of a net.Socket (src/tls_wrap.cc)
+ * instead of piping it through a pair of CryptoStreams. Only cleartext ever
+ * reaches JS, and the socket itself is the cleartext stream.
+ */
+
+function SecureWrap(socket, credentials, isServer, requestCert,
+                    rejectUnauthorized, options) {
+  var self = this;
+
+  options || (options = {});
+
+  events.EventEmitter.call(this);
+
+  this.server = options.server;
+  this._secureEstablished = false;
+  this._isServer = isServer ? true : false;
+  this._destroying = false;
+
+  if (!credentials) {
+    this.credentials = crypto.createCredentials();
+  } else {
+    this.credentials = credentials;
+  }
+
+  if (!this._isServer) {
+    requestCert = true;
+  }
+
+  this._rejectUnauthorized = rejectUnauthorized ? true : false;
+  this._requestCert = requestCert ? true : false;
+
+  initConnection(this, options);
+
+  this.ssl.onsecure = function() {
+    self.maybeInitFinished();
+  };
+  this.ssl.onerror = function(err) {
+    self.error(err);
+  };
+
+  this.socket = socket;
+  this.cleartext = socket;
+
+  // The socket stands in for the CleartextStream.
+  socket.pair = this;
+  socket.encrypted = true;
+  socket.authorized = false;
+  socket.getPeerCertificate = CryptoStream.prototype.getPeerCertificate;
+  socket.getSession = CryptoStream.prototype.getSession;
+  socket.isSessionReused = CryptoStream.prototype.isSessionReused;
+  socket.getCipher = CryptoStream.prototype.getCipher;
+}
+
+util.inherits(SecureWrap, events.EventEmitter);
+
+
+// Must be called before any data is written to the socket.
+SecureWrap.prototype.start = function() {
+  var socket = this.socket;
+  var ssl = this.ssl;
+
+  if (socket._handle && !socket._connecting) {
+    tls_wrap.wrap(socket._handle, ssl);
+  } else {
+    // Runs before the 'connect' listener that flushes buffered writes.
+    socket.once('connect', function() {
+      tls_wrap.wrap(socket._handle, ssl);
+    });
+  }
+};
+
+
+SecureWrap.prototype._cycle = function() {
+  if (this.socket._handle) tls_wrap.cycle(this.socket._handle);
+};
+
+
+SecureWrap.prototype.maybeInitFinished =
+    SecurePair.prototype.maybeInitFinished;
+
+
+SecureWrap.prototype.destroy = function() {
+  if (this._destroying) return;
+  this._destroying = true;
+
+  // The SSL object is released along with the socket handle.
+  this.socket.destroy();
+};
+
+
+SecureWrap.prototype.error = function(err) {
+  if (!this._secureEstablished) {
+    // Emit ECONNRESET instead of zero return
+    if (!err || err.message === 'ZERO_RETURN') {
+      var connReset = new Error('socket hang up');
+      connReset.code = 'ECONNRESET';
+      connReset.sslError = err && err.message;
+
+      err = connReset;
+    }
+    this.destroy();
+    this.emit('error', err);
+  } else if (this._isServer &&
+             this._rejectUnauthorized &&
+             /peer did not return a certificate/.test(err.message)) {
+    // Not really an error.
+    this.destroy();
+  } else {
+    this.socket.destroy(err);
+  }
+};
+
+
 // TODO: support anonymous (nocert) and PSK
 
 
@@ -1123,8 +1250,11 @@ function Server(/* [options], listener */) {
     secureProtocol: self.secureProtocol,
     secureOptions: self.secureOptions,
     crl: self.crl,
-    sessionIdContext: self.sessionIdContext
+    sessionIdContext: self.sessionIdContext,
+    sessionCache: self.sessionCache,
+    ticketKeys: self.ticketKeys
   });
+  this._sharedCreds = sharedCreds;
 
   var timeout = options.handshakeTimeout || (120 * 1000);
 
@@ -1136,21 +1266,36 @@ function Server(/* [options], listener */) {
   net.Server.call(this, function(socket) {
     var creds = crypto.createCredentials(null, sharedCreds.context);
 
-    var pair = new SecurePair(creds,
-                              true,
-                              self.requestCert,
-                              self.rejectUnauthorized,
-                              {
-                                server: self,
-                                NPNProtocols: self.NPNProtocols,
-                                SNICallback: self.SNICallback,
-
-                                // Stream options
-                                cleartext: self._cleartext,
-                                encrypted: self._encrypted
-                              });
-
-    var cleartext = pipe(pair, socket);
+    var pair, cleartext;
+    if (self.nativeTLS) {
+      pair = new SecureWrap(socket,
+                            creds,
+                            true,
+                            self.requestCert,
+                            self.rejectUnauthorized,
+                            {
+                              server: self,
+                              NPNProtocols: self.NPNProtocols,
+                              SNICallback: self.SNICallback
+                            });
+      pair.start();
+      cleartext = socket;
+    } else {
+      pair = new SecurePair(creds,
+                            true,
+                            self.requestCert,
+                            self.rejectUnauthorized,
+                            {
+                              server: self,
+                              NPNProtocols: self.NPNProtocols,
+                              SNICallback: self.SNICallback,
+
+                              // Stream options
+                              cleartext: self._cleartext,
+                              encrypted: self._encrypted
+                            });
+      cleartext = pipe(pair, socket);
+    }
     cleartext._controlReleased = false;
 
     function listener() {
@@ -1248,8 +1393,77 @@ Server.prototype.setOptions = function(options) {
   }
   if (options.cleartext) this.cleartext = options.cleartext;
   if (options.encrypted) this.encrypted = options.encrypted;
+  if (options.nativeTLS) this.nativeTLS = true;
+  if (options.sessionCache) {
+    if (!(options.sessionCache instanceof SessionCache)) {
+      throw new TypeError('sessionCache must be created with ' +
+                          'tls.createSessionCache()');
+    }
+    this.sessionCache = options.sessionCache;
+  }
+  if (options.ticketKeys) {
+    checkTicketKeys(options.ticketKeys);
+    this.ticketKeys = options.ticketKeys;
+  }
+};
+
+
+function checkTicketKeys(keys) {
+  if (!Buffer.isBuffer(keys) || keys.length % 48 !== 0) {
+    throw new TypeError('ticketKeys must be a Buffer of 48 byte keys');
+  }
+}
+
+
+// Installs a new ring of session ticket keys. The first key issues new
+// tickets, tickets issued with any of the others are still accepted.
+Server.prototype.setTicketKeys = function(keys) {
+  checkTicketKeys(keys);
+  this._sharedCreds.context.setTicketKeys(keys);
 };
 
+
+Server.prototype.getTicketKeys = function() {
+  return this._sharedCreds.context.getTicketKeys();
+};
+
+// Session cache shared by all processes that open the same name, e.g. the
+// workers of a cluster.
+function SessionCache(options) {
+  if (!(this instanceof SessionCache)) return new SessionCache(options);
+
+  options = options || {};
+  if (typeof options.name !== 'string' || options.name.length === 0) {
+    throw new TypeError('name must be a non-empty string');
+  }
+
+  var size = options.size === undefined ? 1024 : options.size;
+  if (typeof size !== 'number') {
+    throw new TypeError('size must be a number');
+  }
+
+  var SharedSessionCache = process.binding('crypto').SharedSessionCache;
+  this.name = options.name;
+  this._handle = new SharedSessionCache(this.name, size);
+}
+exports.SessionCache = SessionCache;
+
+
+exports.createSessionCache = function(options) {
+  return new SessionCache(options);
+};
+
+
+SessionCache.prototype.getStats = function() {
+  return this._handle.getStats();
+};
+
+
+SessionCache.prototype.unlink = function() {
+  this._handle.unlink();
+};
+
+
 // SNI Contexts High-Level API
 Server.prototype.addContext = function(servername, credentials) {
   if (!servername) {
@@ -1322,14 +1536,29 @@ exports.connect = function(/* [port, host], options, cb */) {
   var NPN = {};
   convertNPNProtocols(options.NPNProtocols, NPN);
   var hostname = options.servername || options.host || 'localhost',
-      pair = new SecurePair(sslcontext, false, true,
-                            options.rejectUnauthorized === true ? true : false,
-                            {
-                              NPNProtocols: NPN.NPNProtocols,
-                              servername: hostname,
-                              cleartext: options.cleartext,
-                              encrypted: options.encrypted
-                            });
+      pair,
+      cleartext;
+
+  // Only sockets with a libuv stream handle can run TLS natively.
+  if (options.nativeTLS && socket instanceof net.Socket &&
+      (!options.socket || socket._handle || socket._connecting)) {
+    pair = new SecureWrap(socket, sslcontext, false, true,
+                          options.rejectUnauthorized === true ? true : false,
+                          {
+                            NPNProtocols: NPN.NPNProtocols,
+                            servername: hostname
+                          });
+    cleartext = socket;
+  } else {
+    pair = new SecurePair(sslcontext, false, true,
+                          options.rejectUnauthorized === true ? true : false,
+                          {
+                            NPNProtocols: NPN.NPNProtocols,
+                            servername: hostname,
+                            cleartext: options.cleartext,
+                            encrypted: options.encrypted
+                          });
+  }
 
   if (options.session) {
     var session = options.session;
@@ -1338,7 +1567,11 @@ exports.connect = function(/* [port, host], options, cb */) {
     pair.ssl.setSession(session);
   }
 
-  var cleartext = pipe(pair, socket);
+  if (cleartext) {
+    pair.start();
+  } else {
+    cleartext = pipe(pair, socket);
+  }
   if (cb) {
     cleartext.once('secureConnect', cb);
   }
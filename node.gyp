@@ -16,6 +16,7 @@
     'node_use_openssl%': 'true',
     'node_use_systemtap%': 'false',
     'node_shared_openssl%': 'false',
+    'node_core_snapshot%': 'false',
     'library_files': [
       'src/node.js',
       'lib/_debugger.js',
@@ -79,11 +80,14 @@
 
       'sources': [
         'src/fs_event_wrap.cc',
+        'src/buffer_pool.cc',
         'src/cares_wrap.cc',
         'src/handle_wrap.cc',
         'src/node.cc',
         'src/node_buffer.cc',
+        'src/node_compile_cache.cc',
         'src/node_constants.cc',
+        'src/node_dir.cc',
         'src/node_extensions.cc',
         'src/node_file.cc',
         'src/node_http_parser.cc',
@@ -92,13 +96,13 @@
         'src/node_os.cc',
         'src/node_script.cc',
         'src/node_stat_watcher.cc',
+        'src/node_threadpool.cc',
         'src/node_string.cc',
         'src/node_zlib.cc',
         'src/pipe_wrap.cc',
         'src/signal_wrap.cc',
         'src/string_bytes.cc',
         'src/stream_wrap.cc',
-        'src/slab_allocator.cc',
         'src/tcp_wrap.cc',
         'src/timer_wrap.cc',
         'src/tty_wrap.cc',
@@ -106,11 +110,15 @@
         'src/v8_typed_array.cc',
         'src/udp_wrap.cc',
         # headers to make for a more pleasant IDE experience
+        'src/buffer_pool.h',
         'src/handle_wrap.h',
         'src/node.h',
         'src/node_buffer.h',
+        'src/node_compile_cache.h',
         'src/node_constants.h',
         'src/node_crypto.h',
+        'src/node_crypto_session_cache.h',
+        'src/node_dir.h',
         'src/node_extensions.h',
         'src/node_file.h',
         'src/node_http_parser.h',
@@ -119,14 +127,15 @@
         'src/node_root_certs.h',
         'src/node_script.h',
         'src/node_string.h',
+        'src/node_threadpool.h',
         'src/node_version.h',
         'src/ngx-queue.h',
         'src/pipe_wrap.h',
         'src/tty_wrap.h',
         'src/tcp_wrap.h',
+        'src/tls_wrap.h',
         'src/udp_wrap.h',
         'src/req_wrap.h',
-        'src/slab_allocator.h',
         'src/string_bytes.h',
         'src/stream_wrap.h',
         'src/tree.h',
@@ -149,7 +158,11 @@
       'conditions': [
         [ 'node_use_openssl=="true"', {
           'defines': [ 'HAVE_OPENSSL=1' ],
-          'sources': [ 'src/node_crypto.cc' ],
+          'sources': [
+            'src/node_crypto.cc',
+            'src/node_crypto_session_cache.cc',
+            'src/tls_wrap.cc',
+          ],
           'conditions': [
             [ 'node_shared_openssl=="false"', {
               'dependencies': [ './deps/openssl/openssl.gyp:openssl' ],
@@ -227,7 +240,18 @@
             'deps/v8/include/v8.h',
             'deps/v8/include/v8-debug.h',
           ],
-          'dependencies': [ 'deps/v8/tools/gyp/v8.gyp:v8' ],
+          'conditions': [
+            # node_core_snapshot takes the place of v8_snapshot.
+            [ 'node_core_snapshot=="true"', {
+              'dependencies': [
+                'deps/v8/tools/gyp/v8.gyp:v8_base',
+                'node_core_snapshot',
+              ],
+              'include_dirs': [ 'deps/v8/include' ],
+            }, {
+              'dependencies': [ 'deps/v8/tools/gyp/v8.gyp:v8' ],
+            }],
+          ],
         }],
 
         [ 'node_shared_zlib=="false"', {
@@ -481,5 +505,96 @@
         } ],
       ]
     }
-  ] # end targets
+  ], # end targets
+
+  'conditions': [
+    # A V8 startup snapshot that also holds src/node.js and the lib/ module
+    # wrappers, compiled. Built like v8_snapshot, but mksnapshot runs the
+    # scripts from tools/mksnapshot.py before it serializes the heap.
+    [ 'node_core_snapshot=="true"', {
+      'targets': [
+        {
+          'target_name': 'node_core_snapshot',
+          'type': 'static_library',
+          'conditions': [
+            [ 'want_separate_host_toolset==1', {
+              'dependencies': [
+                'deps/v8/tools/gyp/v8.gyp:mksnapshot#host',
+                'deps/v8/tools/gyp/v8.gyp:js2c#host',
+              ],
+            }, {
+              'dependencies': [
+                'deps/v8/tools/gyp/v8.gyp:mksnapshot',
+                'deps/v8/tools/gyp/v8.gyp:js2c',
+              ],
+            }],
+          ],
+          'include_dirs': [
+            'deps/v8/src',
+          ],
+          'sources': [
+            '<(SHARED_INTERMEDIATE_DIR)/libraries.cc',
+            '<(SHARED_INTERMEDIATE_DIR)/experimental-libraries.cc',
+            '<(INTERMEDIATE_DIR)/snapshot.cc',
+          ],
+          'actions': [
+            {
+              'action_name': 'node_mksnapshot',
+              'inputs': [
+                '<(PRODUCT_DIR)/<(EXECUTABLE_PREFIX)mksnapshot<(EXECUTABLE_SUFFIX)',
+                'tools/mksnapshot.py',
+                'tools/js2c.py',
+                '<@(library_files)',
+              ],
+              'outputs': [
+                '<(INTERMEDIATE_DIR)/snapshot.cc',
+              ],
+              'variables': {
+                'mksnapshot_flags': [
+                  '--log-snapshot-positions',
+                  '--logfile=<(INTERMEDIATE_DIR)/snapshot.log',
+                ],
+              },
+              'conditions': [
+                # Same macros as node_js2c.
+                [ 'node_use_dtrace=="false"'
+                  ' and node_use_etw=="false"'
+                  ' and node_use_systemtap=="false"', {
+                  'inputs': [ 'src/macros.py' ],
+                }],
+                [ 'node_use_perfctr=="false"', {
+                  'inputs': [ 'src/perfctr_macros.py' ],
+                }],
+                # Keep the generated code in line with V8's own snapshot,
+                # see run_mksnapshot in deps/v8/tools/gyp/v8.gyp.
+                [ 'target_arch=="arm" and armv7!=1', {
+                  'variables': {
+                    'mksnapshot_flags': [
+                      '--noenable_armv7',
+                      '--noenable_vfp3',
+                    ],
+                  },
+                }],
+                [ 'target_arch=="arm" and armv7==1 and arm_neon!=1'
+                  ' and arm_fpu!="vfpv3" and arm_fpu!="vfpv3-d16"', {
+                  'variables': {
+                    'mksnapshot_flags': [ '--noenable_vfp3' ],
+                  },
+                }],
+              ],
+              'action': [
+                '<(python)',
+                'tools/mksnapshot.py',
+                '<(PRODUCT_DIR)/<(EXECUTABLE_PREFIX)mksnapshot<(EXECUTABLE_SUFFIX)',
+                '<(INTERMEDIATE_DIR)/snapshot',
+                '<@(_outputs)',
+                '<@(mksnapshot_flags)',
+                '<@(_inputs)',
+              ],
+            },
+          ],
+        }, # end node_core_snapshot
+      ],
+    }],
+  ],
 }
@@ -0,0 +1,2 @@
+this.__nodeSnapshot = function(id, fn) { __nodeSnapshot.modules[id] = fn; };
+__nodeSnapshot.modules = {};
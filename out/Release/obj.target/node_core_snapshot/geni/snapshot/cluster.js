@@ -0,0 +1,859 @@
+__nodeSnapshot('cluster', (function (exports, require, module, __filename, __dirname) { // Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+var assert = require('assert');
+var fork = require('child_process').fork;
+var net = require('net');
+var EventEmitter = require('events').EventEmitter;
+var util = require('util');
+
+function isObject(o) {
+  return (typeof o === 'object' && o !== null);
+}
+
+var debug;
+if (process.env.NODE_DEBUG && /cluster/.test(process.env.NODE_DEBUG)) {
+  debug = function(x) {
+    var prefix = process.pid + ',' +
+        (process.env.NODE_UNIQUE_ID ? 'Worker' : 'Master');
+    console.error(prefix, x);
+  };
+} else {
+  debug = function() { };
+}
+
+// cluster object:
+function Cluster() {
+  EventEmitter.call(this);
+}
+
+util.inherits(Cluster, EventEmitter);
+
+var cluster = module.exports = new Cluster();
+
+// Used in the master:
+var masterStarted = false;
+var ids = 0;
+var serverHandlers = {};
+var roundRobinHandles = {};
+
+// Used in the worker:
+var serverListeners = {};
+var roundRobinProxies = {};
+var queryIds = 0;
+var queryCallbacks = {};
+
+// Define isWorker and isMaster
+cluster.isWorker = 'NODE_UNIQUE_ID' in process.env;
+cluster.isMaster = ! cluster.isWorker;
+
+// Workers bind their own SO_REUSEPORT listen sockets when the master
+// was set up with reusePort, see listen() in net.js.
+cluster._reusePort = cluster.isWorker &&
+                     process.env.NODE_CLUSTER_REUSEPORT === '1';
+
+// The worker object is only used in a worker
+cluster.worker = cluster.isWorker ? {} : null;
+// The workers array is only used in the master
+cluster.workers = cluster.isMaster ? {} : null;
+
+// Settings object
+var settings = cluster.settings = {};
+
+// Simple function to call a function on each worker
+function eachWorker(cb) {
+  // Go through all workers
+  for (var id in cluster.workers) {
+    if (cluster.workers.hasOwnProperty(id)) {
+      cb(cluster.workers[id]);
+    }
+  }
+}
+
+// Extremely simple progress tracker
+function ProgressTracker(missing, callback) {
+  this.missing = missing;
+  this.callback = callback;
+}
+ProgressTracker.prototype.done = function() {
+  this.missing -= 1;
+  this.check();
+};
+ProgressTracker.prototype.check = function() {
+  if (this.missing === 0) this.callback();
+};
+
+cluster.setupMaster = function(options) {
+  // This can only be called from the master.
+  assert(cluster.isMaster);
+
+  // Don't allow this function to run more than once
+  if (masterStarted) return;
+  masterStarted = true;
+
+  // Get filename and arguments
+  options = options || {};
+
+  // By default, V8 writes the profile data of all processes to a single
+  // v8.log.
+  //
+  // Running that log file through a tick processor produces bogus numbers
+  // because many events won't match up with the recorded memory mappings
+  // and you end up with graphs where 80+% of ticks is unaccounted for.
+  //
+  // Fixing the tick processor to deal with multi-process output is not very
+  // useful because the processes may be running wildly disparate workloads.
+  //
+  // That's why we fix up the command line arguments to include
+  // a "--logfile=v8-%p.log" argument (where %p is expanded to the PID)
+  // unless it already contains a --logfile argument.
+  var execArgv = options.execArgv || process.execArgv;
+  if (execArgv.some(function(s) { return /^--prof/.test(s); }) &&
+      !execArgv.some(function(s) { return /^--logfile=/.test(s); }))
+  {
+    execArgv = execArgv.slice();
+    execArgv.push('--logfile=v8-%p.log');
+  }
+
+  // Set settings object
+  settings = cluster.settings = {
+    exec: options.exec || process.argv[1],
+    execArgv: execArgv,
+    args: options.args || process.argv.slice(2),
+    silent: options.silent || false,
+    reusePort: options.reusePort || false,
+    roundRobin: options.roundRobin || false
+  };
+
+  // emit setup event
+  cluster.emit('setup');
+};
+
+// Check if a message is internal only
+var INTERNAL_PREFIX = 'NODE_CLUSTER_';
+function isInternalMessage(message) {
+  return isObject(message) &&
+      typeof message.cmd === 'string' &&
+      message.cmd.length > INTERNAL_PREFIX.length &&
+      message.cmd.slice(0, INTERNAL_PREFIX.length) === INTERNAL_PREFIX;
+}
+
+// Modify message object to be internal
+function internalMessage(inMessage) {
+  var outMessage = util._extend({}, inMessage);
+
+  // Add internal prefix to cmd
+  outMessage.cmd = INTERNAL_PREFIX + (outMessage.cmd || '');
+
+  return outMessage;
+}
+
+// Handle callback messages
+function handleResponse(outMessage, outHandle, inMessage, inHandle, worker) {
+
+  // The message there will be sent
+  var message = internalMessage(outMessage);
+
+  // callback id - will be undefined if not set
+  message._queryEcho = inMessage._requestEcho;
+
+  // Call callback if a query echo is received
+  if (inMessage._queryEcho) {
+    queryCallbacks[inMessage._queryEcho](inMessage, inHandle);
+    delete queryCallbacks[inMessage._queryEcho];
+  }
+
+  // Send if outWrap contains something useful
+  if (!(outMessage === undefined && message._queryEcho === undefined)) {
+    sendInternalMessage(worker, message, outHandle);
+  }
+}
+
+// Handle messages from both master and workers
+var messageHandler = {};
+function handleMessage(worker, inMessage, inHandle) {
+
+  // Remove internal prefix
+  var message = util._extend({}, inMessage);
+  message.cmd = inMessage.cmd.substr(INTERNAL_PREFIX.length);
+
+  var respondUsed = false;
+  function respond(outMessage, outHandler) {
+    respondUsed = true;
+    handleResponse(outMessage, outHandler, inMessage, inHandle, worker);
+  }
+
+  // Run handler if it exists
+  if (messageHandler[message.cmd]) {
+    messageHandler[message.cmd](message, worker, respond, inHandle);
+  }
+
+  // Send respond if it hasn't been called yet
+  if (respondUsed === false) {
+    respond();
+  }
+}
+
+// Messages to the master will be handled using these methods
+if (cluster.isMaster) {
+
+  // Handle online messages from workers
+  messageHandler.online = function(message, worker) {
+    worker.state = 'online';
+    debug('Worker ' + worker.process.pid + ' online');
+    worker.emit('online');
+    cluster.emit('online', worker);
+  };
+
+  // Handle queryServer messages from workers
+  messageHandler.queryServer = function(message, worker, send) {
+
+    // This sequence of information is unique to the connection
+    // but not to the worker
+    var args = [message.address,
+                message.port,
+                message.addressType,
+                message.fd];
+    var key = args.join(':');
+    var handler;
+
+    // In round-robin mode the master keeps the listen socket to itself and
+    // hands out the accepted connections instead.
+    if (settings.roundRobin &&
+        (message.addressType === 4 || message.addressType === 6) &&
+        typeof message.fd !== 'number') {
+      handler = roundRobinHandles[key];
+      if (!handler) {
+        handler = new RoundRobinHandle(key,
+                                       message.address,
+                                       message.port,
+                                       message.addressType);
+      }
+
+      if (handler.errno) {
+        send({ roundRobin: true, errno: handler.errno });
+      } else {
+        roundRobinHandles[key] = handler;
+        handler.add(worker);
+        send({ roundRobin: true, sockname: handler.handle.getsockname() });
+      }
+      return;
+    }
+
+    if (serverHandlers.hasOwnProperty(key)) {
+      handler = serverHandlers[key];
+    } else if (message.addressType === 'udp4' ||
+               message.addressType === 'udp6') {
+      var dgram = require('dgram');
+      handler = dgram._createSocketHandle.apply(net, args);
+    } else {
+      handler = net._createServerHandle.apply(net, args);
+    }
+
+    // Report the bind error instead of caching a handle that doesn't exist
+    if (!handler) {
+      send({ errno: process._errno });
+      return;
+    }
+    serverHandlers[key] = handler;
+
+    // echo callback with the fd handler associated with it
+    send({}, handler);
+  };
+
+  // Handle listening messages from workers
+  messageHandler.listening = function(message, worker) {
+
+    worker.state = 'listening';
+
+    // Emit listening, now that we know the worker is listening
+    worker.emit('listening', {
+      address: message.address,
+      port: message.port,
+      addressType: message.addressType,
+      fd: message.fd
+    });
+    cluster.emit('listening', worker, {
+      address: message.address,
+      port: message.port,
+      addressType: message.addressType,
+      fd: message.fd
+    });
+  };
+
+  // Handle suicide messages from workers
+  messageHandler.suicide = function(message, worker) {
+    worker.suicide = true;
+  };
+
+  // A worker closed its round-robin server
+  messageHandler.close = function(message, worker) {
+    var handler = roundRobinHandles[message.key];
+    if (handler) handler.remove(worker);
+  };
+
+  // A worker is done with some of the connections it was handed
+  messageHandler.release = function(message, worker) {
+    var handler = roundRobinHandles[message.key];
+    if (handler) handler.release(worker, message.count);
+  };
+}
+
+
+// Messages to a worker will be handled using these methods
+else if (cluster.isWorker) {
+
+  // Handle worker.disconnect from master
+  messageHandler.disconnect = function(message, worker) {
+    worker.disconnect();
+  };
+
+  // Handle a connection accepted by the master in round-robin mode
+  messageHandler.newconn = function(message, worker, send, handle) {
+    var proxy = roundRobinProxies[message.key];
+
+    if (!handle) return send({ accepted: false });
+
+    // The server went away while the connection was in flight. Close our
+    // copy and let the master pass it on to another worker.
+    if (!proxy) {
+      handle.close();
+      return send({ accepted: false });
+    }
+
+    send({ accepted: true });
+    proxy.onconnection(handle);
+
+    // onconnection() closes the handle itself when over maxConnections.
+    if (handle.owner)
+      handle.owner.once('close', proxy.release.bind(proxy));
+    else
+      proxy.release();
+  };
+}
+
+
+// Master side of a round-robin server. The master owns the listen socket,
+// accepts connections and sends each one to a worker over the IPC channel.
+// The worker with the fewest connections still open gets the next one, with
+// ties broken in round-robin order, so workers that are slow to finish their
+// connections are handed fewer new ones.
+function RoundRobinHandle(key, address, port, addressType) {
+  this.key = key;
+  this.workers = [];
+  this.load = {};
+  this.pending = {};
+  this.next = 0;
+  this.errno = null;
+  this.handle = net._createServerHandle(address, port, addressType);
+
+  if (this.handle && this.handle.listen(511)) {
+    this.handle.close();
+    this.handle = null;
+  }
+
+  if (!this.handle) {
+    this.errno = process._errno;
+    return;
+  }
+
+  this.handle.onconnection = this.distribute.bind(this);
+}
+
+RoundRobinHandle.prototype.add = function(worker) {
+  if (this.workers.indexOf(worker) !== -1) return;
+  this.workers.push(worker);
+  this.load[worker.id] = 0;
+  this.pending[worker.id] = [];
+};
+
+RoundRobinHandle.prototype.remove = function(worker) {
+  var index = this.workers.indexOf(worker);
+  if (index === -1) return;
+
+  this.workers.splice(index, 1);
+  if (this.next > index) this.next--;
+  if (this.next >= this.workers.length) this.next = 0;
+
+  // A live worker still answers for the connections in flight to it, which
+  // then go to someone else. A dead one never will, so drop them.
+  if (!worker.process.connected) {
+    this.pending[worker.id].splice(0).forEach(function(handle) {
+      handle.close();
+    });
+  }
+  delete this.load[worker.id];
+  delete this.pending[worker.id];
+
+  if (this.workers.length === 0) {
+    this.handle.close();
+    this.handle = null;
+    delete roundRobinHandles[this.key];
+  }
+};
+
+RoundRobinHandle.prototype.release = function(worker, count) {
+  if (this.load.hasOwnProperty(worker.id))
+    this.load[worker.id] = Math.max(0, this.load[worker.id] - count);
+};
+
+RoundRobinHandle.prototype.pick = function() {
+  var workers = this.workers;
+  var best = -1;
+  var bestLoad = Infinity;
+
+  for (var i = 0; i < workers.length; i++) {
+    var index = (this.next + i) % workers.length;
+    var worker = workers[index];
+    if (!worker.process.connected) continue;
+    if (this.load[worker.id] < bestLoad) {
+      best = index;
+      bestLoad = this.load[worker.id];
+    }
+  }
+
+  if (best === -1) return null;
+  this.next = (best + 1) % workers.length;
+  return workers[best];
+};
+
+RoundRobinHandle.prototype.distribute = function(clientHandle) {
+  // Accept errors are transient (EMFILE and the like), keep listening.
+  if (!clientHandle) return;
+
+  var worker = this.pick();
+  if (!worker) {
+    clientHandle.close();
+    return;
+  }
+
+  var self = this;
+  var pending = this.pending[worker.id];
+  pending.push(clientHandle);
+  this.load[worker.id]++;
+
+  var message = { cmd: 'newconn', key: this.key };
+  sendInternalMessage(worker, message, clientHandle, function(reply) {
+    var index = pending.indexOf(clientHandle);
+    if (index === -1) return;  // Already closed, the worker died.
+    pending.splice(index, 1);
+
+    // The worker has its own copy of the socket now.
+    if (reply.accepted) {
+      clientHandle.close();
+      return;
+    }
+
+    self.release(worker, 1);
+    if (self.handle)
+      self.distribute(clientHandle);
+    else
+      clientHandle.close();
+  });
+};
+
+
+// Worker side of a round-robin server. It stands in for the TCP handle of a
+// net.Server; connections arrive from the master instead of from accept().
+function RoundRobinProxy(key, sockname) {
+  this.key = key;
+  this.sockname = sockname;
+  this.released = 0;
+  this.onconnection = null;
+  this.owner = null;
+}
+
+RoundRobinProxy.prototype.listen = function(backlog) {
+  return 0;
+};
+
+RoundRobinProxy.prototype.getsockname = function() {
+  return this.sockname;
+};
+
+RoundRobinProxy.prototype.ref = function() {};
+RoundRobinProxy.prototype.unref = function() {};
+
+RoundRobinProxy.prototype.close = function() {
+  if (roundRobinProxies[this.key] === this)
+    delete roundRobinProxies[this.key];
+  if (process.connected)
+    sendInternalMessage(cluster.worker, { cmd: 'close', key: this.key });
+};
+
+// Report closed connections back to the master, at most once per tick.
+RoundRobinProxy.prototype.release = function() {
+  if (this.released++ !== 0) return;
+
+  var self = this;
+  setImmediate(function() {
+    var count = self.released;
+    self.released = 0;
+    if (process.connected) {
+      sendInternalMessage(cluster.worker,
+                          { cmd: 'release', key: self.key, count: count });
+    }
+  });
+};
+
+function toDecInt(value) {
+  value = parseInt(value, 10);
+  return isNaN(value) ? null : value;
+}
+
+// Create a worker object, that works both for master and worker
+function Worker(customEnv) {
+  if (!(this instanceof Worker)) return new Worker();
+  EventEmitter.call(this);
+
+  var self = this;
+  var env = process.env;
+
+  // Assign a unique id, default null
+  this.id = cluster.isMaster ? ++ids : toDecInt(env.NODE_UNIQUE_ID);
+
+  // XXX: Legacy.  Remove in 0.9
+  this.workerID = this.uniqueID = this.id;
+
+  // Assign state
+  this.state = 'none';
+
+  // Create or get process
+  if (cluster.isMaster) {
+
+    // Create env object
+    // first: copy and add id property
+    var envCopy = util._extend({}, env);
+    envCopy['NODE_UNIQUE_ID'] = this.id;
+    if (settings.reusePort) {
+      envCopy['NODE_CLUSTER_REUSEPORT'] = '1';
+    } else {
+      delete envCopy['NODE_CLUSTER_REUSEPORT'];
+    }
+    // second: extend envCopy with the env argument
+    if (isObject(customEnv)) {
+      envCopy = util._extend(envCopy, customEnv);
+    }
+
+    // fork worker
+    this.process = fork(settings.exec, settings.args, {
+      'env': envCopy,
+      'silent': settings.silent,
+      'execArgv': settings.execArgv
+    });
+  } else {
+    this.process = process;
+  }
+
+  if (cluster.isMaster) {
+    // Save worker in the cluster.workers array
+    cluster.workers[this.id] = this;
+
+    // Emit a fork event, on next tick
+    // There is no worker.fork event since this has no real purpose
+    process.nextTick(function() {
+      cluster.emit('fork', self);
+    });
+  }
+
+  // handle internalMessage, exit and disconnect event
+  this.process.on('internalMessage', handleMessage.bind(null, this));
+  this.process.once('exit', function(exitCode, signalCode) {
+    prepareExit(self, 'dead');
+    self.emit('exit', exitCode, signalCode);
+    cluster.emit('exit', self, exitCode, signalCode);
+  });
+  this.process.once('disconnect', function() {
+    prepareExit(self, 'disconnected');
+    self.emit('disconnect');
+    cluster.emit('disconnect', self);
+  });
+
+  // relay message and error
+  this.process.on('message', this.emit.bind(this, 'message'));
+  this.process.on('error', this.emit.bind(this, 'error'));
+
+}
+util.inherits(Worker, EventEmitter);
+cluster.Worker = Worker;
+
+function prepareExit(worker, state) {
+
+  // set state to disconnect
+  worker.state = state;
+
+  // Make suicide a boolean
+  worker.suicide = !!worker.suicide;
+
+  // Remove from workers in the master
+  if (cluster.isMaster) {
+    delete cluster.workers[worker.id];
+    for (var key in roundRobinHandles) {
+      roundRobinHandles[key].remove(worker);
+    }
+
+    // Replies to messages still in flight to the worker will never come
+    var prefix = worker.id + ':';
+    for (var echo in queryCallbacks) {
+      if (echo.indexOf(prefix) === 0)
+        delete queryCallbacks[echo];
+    }
+  }
+}
+
+// Send internal message
+function sendInternalMessage(worker, message/*, handler, callback*/) {
+
+  // Exist callback
+  var callback = arguments[arguments.length - 1];
+  if (typeof callback !== 'function') {
+    callback = undefined;
+  }
+
+  // exist handler
+  var handler = arguments[2] !== callback ? arguments[2] : undefined;
+
+  if (!isInternalMessage(message)) {
+    message = internalMessage(message);
+  }
+
+  // Store callback for later
+  if (callback) {
+    message._requestEcho = worker.id + ':' + (++queryIds);
+    queryCallbacks[message._requestEcho] = callback;
+  }
+
+
+  worker.send(message, handler);
+}
+
+// Send message to worker or master
+Worker.prototype.send = function() {
+
+  // You could also just use process.send in a worker
+  this.process.send.apply(this.process, arguments);
+};
+
+// Kill the worker without restarting
+Worker.prototype.kill = Worker.prototype.destroy = function(signal) {
+  if (!signal)
+    signal = 'SIGTERM';
+
+  var self = this;
+
+  this.suicide = true;
+
+  if (cluster.isMaster) {
+    // Disconnect IPC channel
+    // this way the worker won't need to propagate suicide state to master
+    if (self.process.connected) {
+      self.process.once('disconnect', function() {
+        self.process.kill(signal);
+      });
+      self.process.disconnect();
+    } else {
+      self.process.kill(signal);
+    }
+
+  } else {
+    // Channel is open
+    if (this.process.connected) {
+
+      // Inform master to suicide and then kill
+      sendInternalMessage(this, {cmd: 'suicide'}, function() {
+        process.exit(0);
+      });
+
+      // When channel is closed, terminate the process
+      this.process.once('disconnect', function() {
+        process.exit(0);
+      });
+    } else {
+      process.exit(0);
+    }
+  }
+};
+
+// The .disconnect function will close all servers
+// and then disconnect the IPC channel.
+if (cluster.isMaster) {
+  // Used in master
+  Worker.prototype.disconnect = function() {
+    this.suicide = true;
+
+    sendInternalMessage(this, {cmd: 'disconnect'});
+  };
+
+} else {
+  // Used in workers
+  Worker.prototype.disconnect = function() {
+    var self = this;
+
+    this.suicide = true;
+
+    // keep track of open servers
+    var servers = Object.keys(serverListeners).length;
+    var progress = new ProgressTracker(servers, function() {
+      // There are no more servers open so we will close the IPC channel.
+      // Closing the IPC channel will emit a disconnect event
+      // in both master and worker on the process object.
+      // This event will be handled by prepareExit.
+      self.process.disconnect();
+    });
+
+    // depending on where this function was called from (master or worker)
+    // The suicide state has already been set,
+    // but it doesn't really matter if we set it again.
+    sendInternalMessage(this, {cmd: 'suicide'}, function() {
+      // in case there are no servers
+      progress.check();
+
+      // closing all servers gracefully
+      var server;
+      for (var key in serverListeners) {
+        server = serverListeners[key];
+
+        // in case the server is closed we won't close it again
+        if (server._handle === null) {
+          progress.done();
+          continue;
+        }
+
+        server.on('close', progress.done.bind(progress));
+        server.close();
+      }
+    });
+
+  };
+}
+
+// Fork a new worker
+cluster.fork = function(env) {
+  // This can only be called from the master.
+  assert(cluster.isMaster);
+
+  // Make sure that the master has been initialized
+  cluster.setupMaster();
+
+  return (new cluster.Worker(env));
+};
+
+// execute .disconnect on all workers and close handlers when done
+cluster.disconnect = function(callback) {
+  // This can only be called from the master.
+  assert(cluster.isMaster);
+
+  // Close all TCP handlers when all workers are disconnected
+  var workers = Object.keys(cluster.workers).length;
+  var progress = new ProgressTracker(workers, function() {
+    for (var key in serverHandlers) {
+      serverHandlers[key].close();
+      delete serverHandlers[key];
+    }
+
+    // call callback when done
+    if (callback) callback();
+  });
+
+  // begin disconnecting all workers
+  eachWorker(function(worker) {
+    worker.once('disconnect', progress.done.bind(progress));
+    worker.disconnect();
+  });
+
+  // in case there weren't any workers
+  progress.check();
+};
+
+// Internal function. Called from src/node.js when worker process starts.
+cluster._setupWorker = function() {
+
+  // Get worker class
+  var worker = cluster.worker = new Worker();
+
+  // we will terminate the worker
+  // when the worker is disconnected from the parent accidentally
+  process.once('disconnect', function() {
+    if (worker.suicide !== true) {
+      process.exit(0);
+    }
+  });
+
+  // Tell master that the worker is online
+  worker.state = 'online';
+  sendInternalMessage(worker, { cmd: 'online' });
+};
+
+// Internal function. Called by net.js and dgram.js when attempting to bind a
+// TCP server or UDP socket.
+cluster._getServer = function(tcpSelf, address, port, addressType, fd, cb) {
+  cluster._addServer(tcpSelf, address, port, addressType, fd);
+
+  // Request the fd handler from the master process
+  var message = {
+    cmd: 'queryServer',
+    address: address,
+    port: port,
+    addressType: addressType,
+    fd: fd
+  };
+
+  // The callback will be stored until the master has responded. A failed
+  // bind comes back with the master's errno instead of a handle.
+  sendInternalMessage(cluster.worker, message, function(msg, handle) {
+    if (msg.errno)
+      return cb(null, msg.errno);
+
+    if (msg.roundRobin) {
+      var key = [address, port, addressType, fd].join(':');
+      handle = roundRobinProxies[key] = new RoundRobinProxy(key,
+                                                            msg.sockname);
+    }
+    cb(handle);
+  });
+
+};
+
+// Internal function. Track a server in the worker and tell the master once
+// it is listening. Used directly by net.js for servers that bind their own
+// socket instead of getting one from the master.
+cluster._addServer = function(tcpSelf, address, port, addressType, fd) {
+  // This can only be called from a worker.
+  assert(cluster.isWorker);
+
+  // Store tcp instance for later use
+  var key = [address, port, addressType, fd].join(':');
+  serverListeners[key] = tcpSelf;
+
+  // Send a listening message to the master
+  tcpSelf.once('listening', function() {
+    cluster.worker.state = 'listening';
+    sendInternalMessage(cluster.worker, {
+      cmd: 'listening',
+      address: address,
+      port: tcpSelf.address().port || port,
+      addressType: addressType,
+      fd: fd
+    });
+  });
+};
+
+}));
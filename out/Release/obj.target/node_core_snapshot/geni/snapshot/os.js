@@ -0,0 +1,59 @@
+__nodeSnapshot('os', (function (exports, require, module, __filename, __dirname) { // Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+var binding = process.binding('os');
+var util = require('util');
+
+exports.endianness = binding.getEndianness;
+exports.hostname = binding.getHostname;
+exports.loadavg = binding.getLoadAvg;
+exports.uptime = binding.getUptime;
+exports.freemem = binding.getFreeMem;
+exports.totalmem = binding.getTotalMem;
+exports.cpus = binding.getCPUs;
+exports.type = binding.getOSType;
+exports.release = binding.getOSRelease;
+exports.networkInterfaces = binding.getInterfaceAddresses;
+
+exports.arch = function() {
+  return process.arch;
+};
+
+exports.platform = function() {
+  return process.platform;
+};
+
+exports.tmpdir = function() {
+  return process.env.TMPDIR ||
+         process.env.TMP ||
+         process.env.TEMP ||
+         (process.platform === 'win32' ? 'c:\\windows\\temp' : '/tmp');
+};
+
+exports.tmpDir = exports.tmpdir;
+
+exports.getNetworkInterfaces = util.deprecate(function() {
+  return exports.networkInterfaces();
+}, 'getNetworkInterfaces is now called `os.networkInterfaces`.');
+
+exports.EOL = process.platform === 'win32' ? '\r\n' : '\n';
+
+}));
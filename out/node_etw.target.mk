@@ -0,0 +1,18 @@
+# This file is generated by gyp; do not edit.
+
+TOOLSET := target
+TARGET := node_etw
+### Rules for final target.
+$(obj).target/node_etw.stamp: TOOLSET := $(TOOLSET)
+$(obj).target/node_etw.stamp:  FORCE_DO_CMD
+	$(call do_cmd,touch)
+
+all_deps += $(obj).target/node_etw.stamp
+# Add target alias
+.PHONY: node_etw
+node_etw: $(obj).target/node_etw.stamp
+
+# Add target alias to "all" target.
+.PHONY: all
+all: node_etw
+
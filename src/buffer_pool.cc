@@ -0,0 +1,242 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "node.h"
+#include "node_buffer.h"
+#include "buffer_pool.h"
+
+#include <assert.h>
+#include <string.h>
+
+
+namespace node {
+
+using v8::Arguments;
+using v8::Array;
+using v8::Handle;
+using v8::HandleScope;
+using v8::Integer;
+using v8::Local;
+using v8::Number;
+using v8::Object;
+using v8::String;
+using v8::V8;
+using v8::Value;
+
+
+static const size_t class_sizes[BufferPool::kNumClasses] = {
+  4096,
+  16384,
+  BufferPool::kMaxChunkSize
+};
+
+static BufferPool* default_pool;
+
+
+static void TrimDefaultPool(void*) {
+  // Live Buffers still point into the pool, so only drop the free lists.
+  default_pool->Trim();
+}
+
+
+BufferPool::BufferPool() {
+  for (unsigned int i = 0; i < kNumClasses; i++) {
+    SizeClass* size_class = &classes_[i];
+    size_class->pool = this;
+    size_class->size = class_sizes[i];
+    size_class->free_list = NULL;
+    size_class->free_count = 0;
+    size_class->pinned_count = 0;
+    size_class->hits = 0;
+    size_class->misses = 0;
+  }
+}
+
+
+BufferPool::~BufferPool() {
+  Trim();
+}
+
+
+BufferPool* BufferPool::GetDefault() {
+  if (default_pool == NULL) {
+    default_pool = new BufferPool();
+    AtExit(TrimDefaultPool, NULL);
+  }
+  return default_pool;
+}
+
+
+BufferPool::SizeClass* BufferPool::ClassFor(size_t size) {
+  for (unsigned int i = 0; i < kNumClasses; i++) {
+    if (size <= classes_[i].size) return &classes_[i];
+  }
+  return NULL;
+}
+
+
+char* BufferPool::Pop(SizeClass* size_class) {
+  FreeChunk* chunk = size_class->free_list;
+
+  if (chunk == NULL) {
+    size_class->misses++;
+    return new char[size_class->size];
+  }
+
+  size_class->hits++;
+  size_class->free_list = chunk->next;
+  size_class->free_count--;
+  return reinterpret_cast<char*>(chunk);
+}
+
+
+void BufferPool::Push(SizeClass* size_class, char* data) {
+  if (size_class->size * (size_class->free_count + 1) > kMaxCachedBytes) {
+    delete[] data;
+    return;
+  }
+
+  FreeChunk* chunk = reinterpret_cast<FreeChunk*>(data);
+  chunk->next = size_class->free_list;
+  size_class->free_list = chunk;
+  size_class->free_count++;
+}
+
+
+uv_buf_t BufferPool::Allocate(size_t size) {
+  if (size > kMaxChunkSize) size = kMaxChunkSize;
+  SizeClass* size_class = ClassFor(size);
+  return uv_buf_init(Pop(size_class), size_class->size);
+}
+
+
+void BufferPool::Release(uv_buf_t buf) {
+  if (buf.base == NULL) return;
+  SizeClass* size_class = ClassFor(buf.len);
+  assert(size_class != NULL && size_class->size == buf.len);
+  Push(size_class, buf.base);
+}
+
+
+void BufferPool::OnFree(char* data, void* hint) {
+  SizeClass* size_class = static_cast<SizeClass*>(hint);
+  assert(size_class->pinned_count > 0);
+  size_class->pinned_count--;
+  V8::AdjustAmountOfExternalAllocatedMemory(
+      -static_cast<intptr_t>(size_class->size));
+  size_class->pool->Push(size_class, data);
+}
+
+
+Local<Object> BufferPool::ToBuffer(uv_buf_t buf, size_t length) {
+  HandleScope scope;
+
+  assert(length > 0 && length <= buf.len);
+
+  SizeClass* size_class = ClassFor(buf.len);
+  SizeClass* fit = ClassFor(length);
+  assert(size_class != NULL && size_class->size == buf.len);
+  char* data = buf.base;
+
+  if (fit != size_class) {
+    data = Pop(fit);
+    memcpy(data, buf.base, length);
+    Push(size_class, buf.base);
+    size_class = fit;
+  }
+
+  size_class->pinned_count++;
+  V8::AdjustAmountOfExternalAllocatedMemory(size_class->size);
+
+  Buffer* buffer = Buffer::New(data, length, OnFree, size_class);
+  return scope.Close(Local<Object>::New(buffer->handle_));
+}
+
+
+void BufferPool::Trim() {
+  for (unsigned int i = 0; i < kNumClasses; i++) {
+    SizeClass* size_class = &classes_[i];
+    while (size_class->free_list != NULL) {
+      FreeChunk* chunk = size_class->free_list;
+      size_class->free_list = chunk->next;
+      delete[] reinterpret_cast<char*>(chunk);
+    }
+    size_class->free_count = 0;
+  }
+}
+
+
+Local<Object> BufferPool::GetStats() {
+  HandleScope scope;
+
+  Local<Object> stats = Object::New();
+  Local<Array> classes = Array::New(kNumClasses);
+  double hits = 0;
+  double misses = 0;
+  double pinned_bytes = 0;
+  double cached_bytes = 0;
+
+  for (unsigned int i = 0; i < kNumClasses; i++) {
+    SizeClass* size_class = &classes_[i];
+    Local<Object> entry = Object::New();
+    entry->Set(String::New("size"), Integer::NewFromUnsigned(size_class->size));
+    entry->Set(String::New("hits"), Number::New(size_class->hits));
+    entry->Set(String::New("misses"), Number::New(size_class->misses));
+    entry->Set(String::New("pinned"),
+               Number::New(static_cast<double>(size_class->pinned_count)));
+    entry->Set(String::New("cached"),
+               Number::New(static_cast<double>(size_class->free_count)));
+    classes->Set(i, entry);
+
+    hits += size_class->hits;
+    misses += size_class->misses;
+    pinned_bytes += static_cast<double>(size_class->pinned_count) *
+                    size_class->size;
+    cached_bytes += static_cast<double>(size_class->free_count) *
+                    size_class->size;
+  }
+
+  stats->Set(String::New("hits"), Number::New(hits));
+  stats->Set(String::New("misses"), Number::New(misses));
+  stats->Set(String::New("pinnedBytes"), Number::New(pinned_bytes));
+  stats->Set(String::New("cachedBytes"), Number::New(cached_bytes));
+  stats->Set(String::New("classes"), classes);
+
+  return scope.Close(stats);
+}
+
+
+Handle<Value> BufferPool::GetStats(const Arguments& args) {
+  HandleScope scope;
+  return scope.Close(GetDefault()->GetStats());
+}
+
+
+void BufferPool::Initialize(Handle<Object> target) {
+  HandleScope scope;
+
+  NODE_SET_METHOD(target, "getStats", GetStats);
+}
+
+
+}  // namespace node
+
+NODE_MODULE(node_buffer_pool, node::BufferPool::Initialize)
@@ -0,0 +1,94 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef BUFFER_POOL_H_
+#define BUFFER_POOL_H_
+
+#include "v8.h"
+#include "uv.h"
+
+namespace node {
+
+// Size-classed pool for the memory that stream and UDP reads land in.
+//
+// Every read is handed to JS as a Buffer that owns exactly one chunk of the
+// pool.  When that Buffer is garbage collected the chunk goes back on the
+// free list of its size class, so a long-lived slice pins its own chunk and
+// nothing else.
+class BufferPool {
+ public:
+  static const unsigned int kNumClasses = 3;
+  static const size_t kMaxChunkSize = 65536;
+  // Upper bound on the memory kept in the free list of each size class.
+  static const size_t kMaxCachedBytes = 1024 * 1024;
+
+  BufferPool();
+  ~BufferPool();
+
+  // Returns a chunk of at least `size` bytes, capped at kMaxChunkSize.
+  uv_buf_t Allocate(size_t size);
+
+  // Returns a chunk that never made it to JS back to the pool.
+  void Release(uv_buf_t buf);
+
+  // Wraps the first `length` bytes of `buf` in a Buffer. Reads that fit a
+  // smaller size class are copied into a chunk of that class first, so that
+  // a Buffer never pins much more memory than it holds.
+  v8::Local<v8::Object> ToBuffer(uv_buf_t buf, size_t length);
+
+  // Frees all cached chunks. Chunks owned by live Buffers are untouched.
+  void Trim();
+
+  v8::Local<v8::Object> GetStats();
+
+  // The pool shared by all stream and UDP handles on the loop.
+  static BufferPool* GetDefault();
+
+  static void Initialize(v8::Handle<v8::Object> target);
+
+ private:
+  struct FreeChunk {
+    FreeChunk* next;
+  };
+
+  struct SizeClass {
+    BufferPool* pool;
+    size_t size;
+    FreeChunk* free_list;
+    size_t free_count;
+    size_t pinned_count;
+    double hits;
+    double misses;
+  };
+
+  static void OnFree(char* data, void* hint);
+  static v8::Handle<v8::Value> GetStats(const v8::Arguments& args);
+
+  SizeClass* ClassFor(size_t size);
+  char* Pop(SizeClass* size_class);
+  void Push(SizeClass* size_class, char* data);
+
+  SizeClass classes_[kNumClasses];
+};
+
+}  // namespace node
+
+#endif  // BUFFER_POOL_H_
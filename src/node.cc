@@ -1960,6 +1960,10 @@ void FatalException(TryCatch &try_catch) {
 Persistent<Object> binding_cache;
 Persistent<Array> module_load_list;
 
+// Compiled core modules from the startup snapshot, keyed by module id.
+// Only set in builds configured with --with-core-snapshot.
+static Persistent<Object> core_snapshot;
+
 static Handle<Value> Binding(const Arguments& args) {
   HandleScope scope;
 
@@ -2001,6 +2005,14 @@ static Handle<Value> Binding(const Arguments& args) {
     DefineJavaScript(exports);
     binding_cache->Set(module, exports);
 
+  } else if (!strcmp(*module_v, "snapshot")) {
+    if (core_snapshot.IsEmpty()) {
+      exports = Object::New();
+    } else {
+      exports = Local<Object>::New(core_snapshot);
+    }
+    binding_cache->Set(module, exports);
+
   } else {
 
     return ThrowException(Exception::Error(String::New("No such module")));
@@ -2465,8 +2477,33 @@ void Load(Handle<Object> process_l) {
 
   TryCatch try_catch;
 
-  Local<Value> f_value = ExecuteString(MainSource(),
-                                       IMMUTABLE_STRING("node.js"));
+  Local<Object> global = v8::Context::GetCurrent()->Global();
+
+  // With --with-core-snapshot, the startup snapshot already holds node.js
+  // and the lib/ modules in compiled form. tools/mksnapshot.py left them in
+  // __nodeSnapshot.modules; take them off the global object before any
+  // other code runs.
+  Local<String> snapshot_key = String::NewSymbol("__nodeSnapshot");
+  Local<Value> snapshot_v = global->Get(snapshot_key);
+  Local<Value> f_value;
+
+  if (snapshot_v->IsFunction()) {
+    Local<Value> modules_v =
+        snapshot_v->ToObject()->Get(String::NewSymbol("modules"));
+    global->Delete(snapshot_key);
+
+    if (modules_v->IsObject()) {
+      Local<String> node_key = String::NewSymbol("node");
+      core_snapshot = Persistent<Object>::New(modules_v->ToObject());
+      f_value = core_snapshot->Get(node_key);
+      core_snapshot->Delete(node_key);
+    }
+  }
+
+  if (f_value.IsEmpty() || !f_value->IsFunction()) {
+    f_value = ExecuteString(MainSource(), IMMUTABLE_STRING("node.js"));
+  }
+
   if (try_catch.HasCaught())  {
     ReportException(try_catch, true);
     exit(10);
@@ -2482,8 +2519,6 @@ void Load(Handle<Object> process_l) {
   // who do not like how 'src/node.js' setups the module system but do like
   // Node's I/O bindings may want to replace 'f' with their own function.
 
-  // Add a reference to the global object
-  Local<Object> global = v8::Context::GetCurrent()->Global();
   Local<Value> args[1] = { Local<Value>::New(process_l) };
 
 #if defined HAVE_DTRACE || defined HAVE_ETW || defined HAVE_SYSTEMTAP
@@ -2555,6 +2590,8 @@ static void PrintHelp() {
          "NODE_MODULE_CONTEXTS   Set to 1 to load modules in their own\n"
          "                       global contexts.\n"
          "NODE_DISABLE_COLORS    Set to 1 to disable colors in the REPL\n"
+         "NODE_COMPILE_CACHE     Directory in which to keep the preparse\n"
+         "                       data of compiled scripts between runs.\n"
          "\n"
          "Documentation can be found at http://nodejs.org/\n");
 }
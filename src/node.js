@@ -837,6 +837,7 @@
   }
 
   NativeModule._source = process.binding('natives');
+  NativeModule._snapshot = process.binding('snapshot');
   NativeModule._cache = {};
 
   NativeModule.require = function(id) {
@@ -885,10 +886,17 @@
   ];
 
   NativeModule.prototype.compile = function() {
-    var source = NativeModule.getSource(this.id);
-    source = NativeModule.wrap(source);
+    // Builds with --with-core-snapshot have the wrapper compiled already.
+    var fn = NativeModule._snapshot[this.id];
+
+    if (typeof fn === 'function') {
+      delete NativeModule._snapshot[this.id];
+    } else {
+      var source = NativeModule.getSource(this.id);
+      source = NativeModule.wrap(source);
+      fn = runInThisContext(source, this.filename, true);
+    }
 
-    var fn = runInThisContext(source, this.filename, true);
     fn(this.exports, NativeModule.require, this, this.filename);
 
     this.loaded = true;
@@ -0,0 +1,215 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "node_compile_cache.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef _WIN32
+# include <direct.h>
+# include <process.h>
+# define getpid _getpid
+# define mkdir(path, mode) _mkdir(path)
+#else
+# include <unistd.h>
+#endif
+
+namespace node {
+
+using v8::Handle;
+using v8::ScriptData;
+using v8::String;
+using v8::V8;
+
+// Mirrors FLAG_min_preparse_length in deps/v8/src/flag-definitions.h, V8
+// doesn't preparse smaller scripts.
+static const size_t kMinSourceLength = 1024;
+
+static const char kMagic[8] = { 'N', 'O', 'D', 'E', 'C', 'C', '0', '2' };
+
+// `checksum` covers the preparse data. V8 only sanity checks the data in
+// debug builds, where a failed check is fatal rather than ignored.
+struct CacheHeader {
+  char magic[8];
+  uint64_t key;
+  uint64_t checksum;
+  uint32_t source_length;
+  uint32_t data_length;
+};
+
+
+// Returns the cache directory, or NULL if the cache is off.
+static const char* CacheDir() {
+  static bool initialized = false;
+  static const char* dir = NULL;
+
+  if (!initialized) {
+    initialized = true;
+    const char* env = getenv("NODE_COMPILE_CACHE");
+    if (env != NULL && env[0] != '\0') {
+      if (mkdir(env, 0777) == 0 || errno == EEXIST)
+        dir = env;
+    }
+  }
+
+  return dir;
+}
+
+
+// FNV-1a.
+static const uint64_t kHashBasis = 14695981039346656037ULL;
+
+static uint64_t Hash(uint64_t hash, const char* data, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+static uint64_t Checksum(const char* data, size_t length) {
+  return Hash(kHashBasis, data, length);
+}
+
+// The preparse data depends on the V8 version and the pointer size, so they
+// are part of the key.
+static uint64_t CacheKey(const char* source, size_t length) {
+  const char* version = V8::GetVersion();
+  unsigned char pointer_size = sizeof(void*);
+  uint64_t hash = kHashBasis;
+  hash = Hash(hash, version, strlen(version));
+  hash = Hash(hash, reinterpret_cast<const char*>(&pointer_size), 1);
+  return Hash(hash, source, length);
+}
+
+
+CompileCacheData::CompileCacheData(Handle<String> source)
+    : buffer_(NULL),
+      data_(NULL) {
+  const char* dir = CacheDir();
+  if (dir == NULL || static_cast<size_t>(source->Length()) < kMinSourceLength)
+    return;
+
+  String::Utf8Value utf8(source);
+  uint64_t key = CacheKey(*utf8, utf8.length());
+
+  char path[4096];
+  int r = snprintf(path,
+                   sizeof(path),
+                   "%s/%08x%08x",
+                   dir,
+                   static_cast<unsigned int>(key >> 32),
+                   static_cast<unsigned int>(key));
+  if (r < 0 || static_cast<size_t>(r) >= sizeof(path))
+    return;
+
+  if (Load(path, key, utf8.length()))
+    return;
+
+  data_ = ScriptData::PreCompile(*utf8, utf8.length());
+  if (data_->HasError()) {
+    // Let the compiler report the syntax error.
+    delete data_;
+    data_ = NULL;
+    return;
+  }
+
+  Store(path, key, utf8.length());
+}
+
+
+CompileCacheData::~CompileCacheData() {
+  delete data_;
+  free(buffer_);
+}
+
+
+bool CompileCacheData::Load(const char* path,
+                            uint64_t key,
+                            size_t source_length) {
+  FILE* file = fopen(path, "rb");
+  if (file == NULL)
+    return false;
+
+  CacheHeader header;
+  bool ok = fread(&header, sizeof(header), 1, file) == 1 &&
+            memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+            header.key == key &&
+            header.source_length == source_length &&
+            header.data_length > 0 &&
+            header.data_length % sizeof(unsigned) == 0;
+
+  if (ok) {
+    // malloc() memory is suitably aligned, so ScriptData::New() uses the
+    // buffer without copying it. It must live as long as data_.
+    buffer_ = static_cast<char*>(malloc(header.data_length));
+    ok = buffer_ != NULL &&
+         fread(buffer_, header.data_length, 1, file) == 1 &&
+         fgetc(file) == EOF &&
+         Checksum(buffer_, header.data_length) == header.checksum;
+  }
+
+  fclose(file);
+
+  if (!ok) {
+    free(buffer_);
+    buffer_ = NULL;
+    return false;
+  }
+
+  data_ = ScriptData::New(buffer_, header.data_length);
+  return true;
+}
+
+
+// Writes to a temporary file first so that other processes never see a
+// partial entry.
+void CompileCacheData::Store(const char* path,
+                             uint64_t key,
+                             size_t source_length) {
+  char tmp[4096 + 32];
+  snprintf(tmp, sizeof(tmp), "%s.%d.tmp", path, static_cast<int>(getpid()));
+
+  FILE* file = fopen(tmp, "wb");
+  if (file == NULL)
+    return;
+
+  CacheHeader header;
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.key = key;
+  header.source_length = source_length;
+  header.data_length = data_->Length();
+  header.checksum = Checksum(data_->Data(), header.data_length);
+
+  bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+            fwrite(data_->Data(), header.data_length, 1, file) == 1;
+  ok = fclose(file) == 0 && ok;
+
+  if (!ok || rename(tmp, path) != 0)
+    remove(tmp);
+}
+
+}  // namespace node
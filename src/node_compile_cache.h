@@ -0,0 +1,50 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef NODE_COMPILE_CACHE_H_
+#define NODE_COMPILE_CACHE_H_
+
+#include "v8.h"
+
+namespace node {
+
+// The preparse data of a script, from the compile cache in the directory
+// named by NODE_COMPILE_CACHE. On a miss the script is preparsed and the
+// result is written to the cache for the next run. Scripts too small for V8
+// to preparse, and every script when the variable isn't set, get no data.
+class CompileCacheData {
+ public:
+  explicit CompileCacheData(v8::Handle<v8::String> source);
+  ~CompileCacheData();
+
+  // For Script::Compile() and Script::New(), NULL if there is no data.
+  v8::ScriptData* data() const { return data_; }
+
+ private:
+  bool Load(const char* path, uint64_t key, size_t source_length);
+  void Store(const char* path, uint64_t key, size_t source_length);
+
+  char* buffer_;
+  v8::ScriptData* data_;
+};
+
+}  // namespace node
+#endif  // NODE_COMPILE_CACHE_H_
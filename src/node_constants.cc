@@ -31,6 +31,9 @@
 #include <signal.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#endif
 
 #if HAVE_OPENSSL
 # include <openssl/ssl.h>
@@ -163,6 +166,38 @@ void DefineConstants(Handle<Object> target) {
   NODE_DEFINE_CONSTANT(target, S_IXOTH);
 #endif
 
+#ifdef PROT_NONE
+  NODE_DEFINE_CONSTANT(target, PROT_NONE);
+#endif
+
+#ifdef PROT_READ
+  NODE_DEFINE_CONSTANT(target, PROT_READ);
+#endif
+
+#ifdef PROT_WRITE
+  NODE_DEFINE_CONSTANT(target, PROT_WRITE);
+#endif
+
+#ifdef MADV_NORMAL
+  NODE_DEFINE_CONSTANT(target, MADV_NORMAL);
+#endif
+
+#ifdef MADV_RANDOM
+  NODE_DEFINE_CONSTANT(target, MADV_RANDOM);
+#endif
+
+#ifdef MADV_SEQUENTIAL
+  NODE_DEFINE_CONSTANT(target, MADV_SEQUENTIAL);
+#endif
+
+#ifdef MADV_WILLNEED
+  NODE_DEFINE_CONSTANT(target, MADV_WILLNEED);
+#endif
+
+#ifdef MADV_DONTNEED
+  NODE_DEFINE_CONSTANT(target, MADV_DONTNEED);
+#endif
+
 #ifdef E2BIG
   NODE_DEFINE_CONSTANT(target, E2BIG);
 #endif
@@ -27,6 +27,7 @@
 #include "node_buffer.h"
 #include "string_bytes.h"
 #include "node_root_certs.h"
+#include "ngx-queue.h"
 
 #include <string.h>
 #ifdef _MSC_VER
@@ -95,6 +96,9 @@ static Persistent<String> onnewsession_sym;
 static Persistent<String> sessionid_sym;
 
 static Persistent<FunctionTemplate> secure_context_constructor;
+static Persistent<FunctionTemplate> connection_constructor;
+
+X509_STORE* root_cert_store;
 
 static uv_rwlock_t* locks;
 
@@ -171,6 +175,10 @@ void SecureContext::Initialize(Handle<Object> target) {
   NODE_SET_PROTOTYPE_METHOD(t, "setOptions", SecureContext::SetOptions);
   NODE_SET_PROTOTYPE_METHOD(t, "setSessionIdContext",
                                SecureContext::SetSessionIdContext);
+  NODE_SET_PROTOTYPE_METHOD(t, "setSessionCache",
+                               SecureContext::SetSessionCache);
+  NODE_SET_PROTOTYPE_METHOD(t, "setTicketKeys", SecureContext::SetTicketKeys);
+  NODE_SET_PROTOTYPE_METHOD(t, "getTicketKeys", SecureContext::GetTicketKeys);
   NODE_SET_PROTOTYPE_METHOD(t, "close", SecureContext::Close);
   NODE_SET_PROTOTYPE_METHOD(t, "loadPKCS12", SecureContext::LoadPKCS12);
 
@@ -238,6 +246,7 @@ Handle<Value> SecureContext::Init(const Arguments& args) {
   }
 
   sc->ctx_ = SSL_CTX_new(method);
+  SSL_CTX_set_app_data(sc->ctx_, sc);
 
   // SSL session cache configuration
   SSL_CTX_set_session_cache_mode(sc->ctx_,
@@ -246,6 +255,7 @@ Handle<Value> SecureContext::Init(const Arguments& args) {
                                  SSL_SESS_CACHE_NO_AUTO_CLEAR);
   SSL_CTX_sess_set_get_cb(sc->ctx_, GetSessionCallback);
   SSL_CTX_sess_set_new_cb(sc->ctx_, NewSessionCallback);
+  SSL_CTX_sess_set_remove_cb(sc->ctx_, RemoveSessionCallback);
 
   sc->ca_store_ = NULL;
   return True();
@@ -264,6 +274,16 @@ SSL_SESSION* SecureContext::GetSessionCallback(SSL* s,
   SSL_SESSION* sess = p->next_sess_;
   p->next_sess_ = NULL;
 
+  // Sessions always come from the context the connection started out with,
+  // even after SNI switched it to another one.
+  if (sess == NULL) {
+    SecureContext* sc = static_cast<SecureContext*>(
+        SSL_CTX_get_app_data(s->session_ctx));
+    if (sc != NULL && sc->session_cache_ != NULL) {
+      sess = sc->session_cache_->Get(key, len);
+    }
+  }
+
   return sess;
 }
 
@@ -278,6 +298,12 @@ int SecureContext::NewSessionCallback(SSL* s, SSL_SESSION* sess) {
 
   Connection* p = static_cast<Connection*>(SSL_get_app_data(s));
 
+  SecureContext* sc = static_cast<SecureContext*>(
+      SSL_CTX_get_app_data(s->session_ctx));
+  if (sc != NULL && sc->session_cache_ != NULL) {
+    sc->session_cache_->Put(sess);
+  }
+
   // Check if session is small enough to be stored
   int size = i2d_SSL_SESSION(sess, NULL);
   if (size > kMaxSessionSize) return 0;
@@ -648,10 +674,133 @@ Handle<Value> SecureContext::SetSessionIdContext(const Arguments& args) {
   return True();
 }
 
+Handle<Value> SecureContext::SetSessionCache(const Arguments& args) {
+  HandleScope scope;
+
+  SecureContext *sc = ObjectWrap::Unwrap<SecureContext>(args.Holder());
+
+  if (args.Length() != 1 || !SharedSessionCache::HasInstance(args[0])) {
+    return ThrowException(Exception::TypeError(String::New("Bad parameter")));
+  }
+
+  if (!sc->session_cache_obj_.IsEmpty()) sc->session_cache_obj_.Dispose();
+  sc->session_cache_obj_ = Persistent<Object>::New(args[0].As<Object>());
+  sc->session_cache_ = SharedSessionCache::Unwrap(args[0]);
+
+  return True();
+}
+
+
+void SecureContext::RemoveSessionCallback(SSL_CTX* ctx, SSL_SESSION* sess) {
+  SecureContext* sc = static_cast<SecureContext*>(SSL_CTX_get_app_data(ctx));
+  if (sc != NULL && sc->session_cache_ != NULL) {
+    sc->session_cache_->Remove(sess->session_id, sess->session_id_length);
+  }
+}
+
+
+// Takes a buffer holding one or more keys, the first of which is used for
+// new tickets. An empty buffer goes back to OpenSSL's own random keys.
+Handle<Value> SecureContext::SetTicketKeys(const Arguments& args) {
+  HandleScope scope;
+
+  SecureContext *sc = ObjectWrap::Unwrap<SecureContext>(args.Holder());
+
+  if (args.Length() != 1 || !Buffer::HasInstance(args[0])) {
+    return ThrowException(Exception::TypeError(String::New("Bad parameter")));
+  }
+
+  size_t length = Buffer::Length(args[0]);
+  if (length % kTicketKeySize != 0) {
+    return ThrowException(Exception::TypeError(
+          String::New("Ticket keys length must be a multiple of 48 bytes")));
+  }
+
+  sc->FreeTicketKeys();
+
+  if (length == 0) {
+    SSL_CTX_set_tlsext_ticket_key_cb(sc->ctx_, NULL);
+    return True();
+  }
+
+  sc->ticket_keys_ = new unsigned char[length];
+  sc->ticket_key_count_ = length / kTicketKeySize;
+  memcpy(sc->ticket_keys_, Buffer::Data(args[0]), length);
+
+  SSL_CTX_set_tlsext_ticket_key_cb(sc->ctx_, TicketKeyCallback);
+
+  return True();
+}
+
+
+Handle<Value> SecureContext::GetTicketKeys(const Arguments& args) {
+  HandleScope scope;
+
+  SecureContext *sc = ObjectWrap::Unwrap<SecureContext>(args.Holder());
+
+  Buffer* buff = Buffer::New(reinterpret_cast<char*>(sc->ticket_keys_),
+                             sc->ticket_key_count_ * kTicketKeySize);
+  return scope.Close(buff->handle_);
+}
+
+
+int SecureContext::TicketKeyCallback(SSL* s,
+                                     unsigned char* name,
+                                     unsigned char* iv,
+                                     EVP_CIPHER_CTX* ectx,
+                                     HMAC_CTX* hctx,
+                                     int enc) {
+  // Like sessions, tickets belong to the context the connection started
+  // out with.
+  SecureContext* sc = static_cast<SecureContext*>(
+      SSL_CTX_get_app_data(s->session_ctx));
+  if (sc == NULL || sc->ticket_key_count_ == 0) return -1;
+
+  unsigned char* key = NULL;
+  int r;
+
+  if (enc) {
+    key = sc->ticket_keys_;
+    if (RAND_pseudo_bytes(iv, EVP_MAX_IV_LENGTH) < 0) return -1;
+    memcpy(name, key, kTicketKeyNameSize);
+    r = 1;
+  } else {
+    for (unsigned int i = 0; i < sc->ticket_key_count_; i++) {
+      unsigned char* candidate = sc->ticket_keys_ + i * kTicketKeySize;
+      if (memcmp(name, candidate, kTicketKeyNameSize) == 0) {
+        key = candidate;
+        // Tickets issued with an older key get renewed with the current one.
+        r = i == 0 ? 1 : 2;
+        break;
+      }
+    }
+
+    // Unknown key: fall back to a full handshake.
+    if (key == NULL) return 0;
+  }
+
+  HMAC_Init_ex(hctx,
+               key + kTicketKeyNameSize,
+               16,
+               EVP_sha256(),
+               NULL);
+
+  const unsigned char* aes_key = key + kTicketKeyNameSize + 16;
+  if (enc) {
+    EVP_EncryptInit_ex(ectx, EVP_aes_128_cbc(), NULL, aes_key, iv);
+  } else {
+    EVP_DecryptInit_ex(ectx, EVP_aes_128_cbc(), NULL, aes_key, iv);
+  }
+
+  return r;
+}
+
+
 Handle<Value> SecureContext::Close(const Arguments& args) {
   HandleScope scope;
   SecureContext *sc = ObjectWrap::Unwrap<SecureContext>(args.Holder());
   sc->FreeCTXMem();
+  sc->FreeTicketKeys();
   return False();
 }
 
@@ -1036,10 +1185,20 @@ void Connection::Initialize(Handle<Object> target) {
   NODE_SET_PROTOTYPE_METHOD(t, "setSNICallback",  Connection::SetSNICallback);
 #endif
 
+  connection_constructor = Persistent<FunctionTemplate>::New(t);
+
   target->Set(String::NewSymbol("Connection"), t->GetFunction());
 }
 
 
+Connection* Connection::FromValue(Handle<Value> value) {
+  if (!value->IsObject() || !connection_constructor->HasInstance(value))
+    return NULL;
+
+  return ObjectWrap::Unwrap<Connection>(value.As<Object>());
+}
+
+
 static int VerifyCallback(int preverify_ok, X509_STORE_CTX *ctx) {
   // Quoting SSL_set_verify(3ssl):
   //
@@ -1333,19 +1492,24 @@ Handle<Value> Connection::EncIn(const Arguments& args) {
           String::New("off + len > buffer.length")));
   }
 
+  int bytes_written = ss->DoEncIn(buffer_data + off, len);
+
+  return scope.Close(Integer::New(bytes_written));
+}
+
+
+int Connection::DoEncIn(char* data, size_t len) {
   int bytes_written;
-  char* data = buffer_data + off;
 
-  if (ss->is_server_ && !ss->hello_parser_.ended()) {
-    bytes_written = ss->hello_parser_.Write(reinterpret_cast<uint8_t*>(data),
-                                            len);
+  if (is_server_ && !hello_parser_.ended()) {
+    bytes_written = hello_parser_.Write(reinterpret_cast<uint8_t*>(data), len);
   } else {
-    bytes_written = BIO_write(ss->bio_read_, data, len);
-    ss->HandleBIOError(ss->bio_read_, "BIO_write", bytes_written);
-    ss->SetShutdownFlags();
+    bytes_written = BIO_write(bio_read_, data, len);
+    HandleBIOError(bio_read_, "BIO_write", bytes_written);
+    SetShutdownFlags();
   }
 
-  return scope.Close(Integer::New(bytes_written));
+  return bytes_written;
 }
 
 
@@ -1374,34 +1538,41 @@ Handle<Value> Connection::ClearOut(const Arguments& args) {
           String::New("off + len > buffer.length")));
   }
 
-  if (!SSL_is_init_finished(ss->ssl_)) {
+  int bytes_read = ss->DoClearOut(buffer_data + off, len);
+
+  return scope.Close(Integer::New(bytes_read));
+}
+
+
+int Connection::DoClearOut(char* data, size_t len) {
+  if (!SSL_is_init_finished(ssl_)) {
     int rv;
 
-    if (ss->is_server_) {
-      rv = SSL_accept(ss->ssl_);
-      ss->HandleSSLError("SSL_accept:ClearOut",
-                         rv,
-                         kZeroIsAnError,
-                         kSyscallError);
+    if (is_server_) {
+      rv = SSL_accept(ssl_);
+      HandleSSLError("SSL_accept:ClearOut",
+                     rv,
+                     kZeroIsAnError,
+                     kSyscallError);
     } else {
-      rv = SSL_connect(ss->ssl_);
-      ss->HandleSSLError("SSL_connect:ClearOut",
-                         rv,
-                         kZeroIsAnError,
-                         kSyscallError);
+      rv = SSL_connect(ssl_);
+      HandleSSLError("SSL_connect:ClearOut",
+                     rv,
+                     kZeroIsAnError,
+                     kSyscallError);
     }
 
-    if (rv < 0) return scope.Close(Integer::New(rv));
+    if (rv < 0) return rv;
   }
 
-  int bytes_read = SSL_read(ss->ssl_, buffer_data + off, len);
-  ss->HandleSSLError("SSL_read:ClearOut",
-                     bytes_read,
-                     kZeroIsNotAnError,
-                     kSyscallError);
-  ss->SetShutdownFlags();
+  int bytes_read = SSL_read(ssl_, data, len);
+  HandleSSLError("SSL_read:ClearOut",
+                 bytes_read,
+                 kZeroIsNotAnError,
+                 kSyscallError);
+  SetShutdownFlags();
 
-  return scope.Close(Integer::New(bytes_read));
+  return bytes_read;
 }
 
 
@@ -1450,15 +1621,22 @@ Handle<Value> Connection::EncOut(const Arguments& args) {
           String::New("off + len > buffer.length")));
   }
 
-  int bytes_read = BIO_read(ss->bio_write_, buffer_data + off, len);
-
-  ss->HandleBIOError(ss->bio_write_, "BIO_read:EncOut", bytes_read);
-  ss->SetShutdownFlags();
+  int bytes_read = ss->DoEncOut(buffer_data + off, len);
 
   return scope.Close(Integer::New(bytes_read));
 }
 
 
+int Connection::DoEncOut(char* data, size_t len) {
+  int bytes_read = BIO_read(bio_write_, data, len);
+
+  HandleBIOError(bio_write_, "BIO_read:EncOut", bytes_read);
+  SetShutdownFlags();
+
+  return bytes_read;
+}
+
+
 Handle<Value> Connection::ClearIn(const Arguments& args) {
   HandleScope scope;
 
@@ -1484,34 +1662,41 @@ Handle<Value> Connection::ClearIn(const Arguments& args) {
           String::New("off + len > buffer.length")));
   }
 
-  if (!SSL_is_init_finished(ss->ssl_)) {
+  int bytes_written = ss->DoClearIn(buffer_data + off, len);
+
+  return scope.Close(Integer::New(bytes_written));
+}
+
+
+int Connection::DoClearIn(const char* data, size_t len) {
+  if (!SSL_is_init_finished(ssl_)) {
     int rv;
-    if (ss->is_server_) {
-      rv = SSL_accept(ss->ssl_);
-      ss->HandleSSLError("SSL_accept:ClearIn",
-                         rv,
-                         kZeroIsAnError,
-                         kSyscallError);
+    if (is_server_) {
+      rv = SSL_accept(ssl_);
+      HandleSSLError("SSL_accept:ClearIn",
+                     rv,
+                     kZeroIsAnError,
+                     kSyscallError);
     } else {
-      rv = SSL_connect(ss->ssl_);
-      ss->HandleSSLError("SSL_connect:ClearIn",
-                         rv,
-                         kZeroIsAnError,
-                         kSyscallError);
+      rv = SSL_connect(ssl_);
+      HandleSSLError("SSL_connect:ClearIn",
+                     rv,
+                     kZeroIsAnError,
+                     kSyscallError);
     }
 
-    if (rv < 0) return scope.Close(Integer::New(rv));
+    if (rv < 0) return rv;
   }
 
-  int bytes_written = SSL_write(ss->ssl_, buffer_data + off, len);
+  int bytes_written = SSL_write(ssl_, data, len);
 
-  ss->HandleSSLError("SSL_write:ClearIn",
-                     bytes_written,
-                     len == 0 ? kZeroIsNotAnError : kZeroIsAnError,
-                     kSyscallError);
-  ss->SetShutdownFlags();
+  HandleSSLError("SSL_write:ClearIn",
+                 bytes_written,
+                 len == 0 ? kZeroIsNotAnError : kZeroIsAnError,
+                 kSyscallError);
+  SetShutdownFlags();
 
-  return scope.Close(Integer::New(bytes_written));
+  return bytes_written;
 }
 
 
@@ -1770,14 +1955,21 @@ Handle<Value> Connection::Shutdown(const Arguments& args) {
   Connection *ss = Connection::Unwrap(args);
 
   if (ss->ssl_ == NULL) return False();
-  int rv = SSL_shutdown(ss->ssl_);
-  ss->HandleSSLError("SSL_shutdown", rv, kZeroIsNotAnError, kIgnoreSyscall);
-  ss->SetShutdownFlags();
+  int rv = ss->DoShutdown();
 
   return scope.Close(Integer::New(rv));
 }
 
 
+int Connection::DoShutdown() {
+  int rv = SSL_shutdown(ssl_);
+  HandleSSLError("SSL_shutdown", rv, kZeroIsNotAnError, kIgnoreSyscall);
+  SetShutdownFlags();
+
+  return rv;
+}
+
+
 Handle<Value> Connection::ReceivedShutdown(const Arguments& args) {
   HandleScope scope;
 
@@ -2656,7 +2848,155 @@ class Decipher : public ObjectWrap {
 
 
 
-class Hmac : public ObjectWrap {
+// Base of Hash and Hmac for feeding data and taking the digest on the
+// thread pool. Jobs queue up in call order and run in batches, one batch at
+// a time, so the context only ever sees one thread and the updates apply in
+// order.
+class AsyncDigest : public ObjectWrap {
+ protected:
+  AsyncDigest() : ObjectWrap(), running_(false) {
+    ngx_queue_init(&pending_);
+    ngx_queue_init(&batch_);
+  }
+
+  // Both run on the thread pool.
+  virtual bool Update(const char* data, size_t len) = 0;
+  virtual bool Final(unsigned char* md_value, unsigned int* md_len) = 0;
+
+  // Synchronous use must wait until the queued jobs are done.
+  bool IsBusy() {
+    return running_ || !ngx_queue_empty(&pending_);
+  }
+
+  // `buffer` must be a Buffer; it is kept alive until the update ran.
+  void QueueUpdate(Handle<Value> buffer, Handle<Value> callback) {
+    Job* job = new Job(callback);
+    job->obj_->Set(String::NewSymbol("buffer"), buffer);
+    job->data_ = Buffer::Data(buffer);
+    job->len_ = Buffer::Length(buffer);
+    Queue(job);
+  }
+
+  void QueueDigest(Handle<Value> callback, enum encoding encoding) {
+    Job* job = new Job(callback);
+    job->final_ = true;
+    job->encoding_ = encoding;
+    Queue(job);
+  }
+
+ private:
+  struct Job {
+    explicit Job(Handle<Value> callback)
+        : data_(NULL),
+          len_(0),
+          final_(false),
+          encoding_(BUFFER),
+          md_len_(0),
+          ok_(false) {
+      obj_ = Persistent<Object>::New(Object::New());
+      obj_->Set(String::New("ondone"), callback);
+    }
+
+    ~Job() {
+      obj_.Dispose();
+      obj_.Clear();
+    }
+
+    ngx_queue_t member_;
+    Persistent<Object> obj_;
+    char* data_;
+    size_t len_;
+    bool final_;
+    enum encoding encoding_;
+    unsigned char md_value_[EVP_MAX_MD_SIZE];
+    unsigned int md_len_;
+    bool ok_;
+  };
+
+  void Queue(Job* job) {
+    ngx_queue_insert_tail(&pending_, &job->member_);
+    if (!running_) Dispatch();
+  }
+
+  void Dispatch() {
+    assert(!running_);
+    if (ngx_queue_empty(&pending_)) return;
+
+    ngx_queue_add(&batch_, &pending_);
+    ngx_queue_init(&pending_);
+
+    // The object must outlive the batch, its context is in use.
+    running_ = true;
+    Ref();
+    uv_queue_work_class(uv_default_loop(),
+                        &work_req_,
+                        UV_WORK_CPU,
+                        Work,
+                        After);
+  }
+
+  static void Work(uv_work_t* work_req) {
+    AsyncDigest* digest = container_of(work_req, AsyncDigest, work_req_);
+    ngx_queue_t* q;
+    ngx_queue_foreach(q, &digest->batch_) {
+      Job* job = ngx_queue_data(q, Job, member_);
+      if (job->final_) {
+        job->ok_ = digest->Final(job->md_value_, &job->md_len_);
+      } else {
+        job->ok_ = digest->Update(job->data_, job->len_);
+      }
+    }
+  }
+
+  static void After(uv_work_t* work_req, int status) {
+    assert(status == 0);
+    AsyncDigest* digest = container_of(work_req, AsyncDigest, work_req_);
+    HandleScope scope;
+
+    // Callbacks may queue more work, it goes out after this batch.
+    ngx_queue_t batch;
+    ngx_queue_init(&batch);
+    ngx_queue_add(&batch, &digest->batch_);
+    ngx_queue_init(&digest->batch_);
+    digest->running_ = false;
+    digest->Dispatch();
+
+    while (!ngx_queue_empty(&batch)) {
+      ngx_queue_t* q = ngx_queue_head(&batch);
+      ngx_queue_remove(q);
+      Job* job = ngx_queue_data(q, Job, member_);
+
+      Local<Value> argv[2];
+      if (!job->ok_) {
+        argv[0] = Exception::Error(String::New("Not initialized"));
+        argv[1] = Local<Value>::New(Null());
+      } else if (job->final_) {
+        argv[0] = Local<Value>::New(Null());
+        argv[1] = StringBytes::Encode(
+            reinterpret_cast<const char*>(job->md_value_),
+            job->md_len_,
+            job->encoding_);
+      } else {
+        argv[0] = Local<Value>::New(Null());
+        argv[1] = Local<Value>::New(Null());
+      }
+
+      MakeCallback(job->obj_, "ondone", ARRAY_SIZE(argv), argv);
+      delete job;
+    }
+
+    digest->Unref();
+  }
+
+  uv_work_t work_req_;
+  // Jobs waiting for the next batch, and the batch on the thread pool.
+  ngx_queue_t pending_;
+  ngx_queue_t batch_;
+  bool running_;
+};
+
+
+class Hmac : public AsyncDigest {
  public:
   static void Initialize (v8::Handle<v8::Object> target) {
     HandleScope scope;
@@ -2704,6 +3044,18 @@ class Hmac : public ObjectWrap {
     return 1;
   }
 
+  bool Update(const char* data, size_t len) {
+    return HmacUpdate(const_cast<char*>(data), len) == 1;
+  }
+
+  bool Final(unsigned char* md_value, unsigned int* md_len) {
+    if (!initialised_) return false;
+    HMAC_Final(&ctx, md_value, md_len);
+    HMAC_CTX_cleanup(&ctx);
+    initialised_ = false;
+    return true;
+  }
+
 
  protected:
 
@@ -2764,6 +3116,14 @@ class Hmac : public ObjectWrap {
 
     HandleScope scope;
 
+    if (args[2]->IsFunction()) {
+      ASSERT_IS_BUFFER(args[0]);
+      hmac->QueueUpdate(args[0], args[2]);
+      return args.This();
+    }
+
+    if (hmac->IsBusy()) return ThrowError("Asynchronous operation pending");
+
     ASSERT_IS_STRING_OR_BUFFER(args[0]);
 
     // Only copy the data if we have to, because it's a string
@@ -2802,6 +3162,13 @@ class Hmac : public ObjectWrap {
       encoding = ParseEncoding(args[0]->ToString(), BUFFER);
     }
 
+    if (args[1]->IsFunction()) {
+      hmac->QueueDigest(args[1], encoding);
+      return Undefined();
+    }
+
+    if (hmac->IsBusy()) return ThrowError("Asynchronous operation pending");
+
     unsigned char* md_value = NULL;
     unsigned int md_len = 0;
     Local<Value> outString;
@@ -2819,7 +3186,7 @@ class Hmac : public ObjectWrap {
     return scope.Close(outString);
   }
 
-  Hmac () : ObjectWrap () {
+  Hmac () : AsyncDigest () {
     initialised_ = false;
   }
 
@@ -2837,7 +3204,7 @@ class Hmac : public ObjectWrap {
 };
 
 
-class Hash : public ObjectWrap {
+class Hash : public AsyncDigest {
  public:
   static void Initialize (v8::Handle<v8::Object> target) {
     HandleScope scope;
@@ -2867,6 +3234,18 @@ class Hash : public ObjectWrap {
     return 1;
   }
 
+  bool Update(const char* data, size_t len) {
+    return HashUpdate(const_cast<char*>(data), len) == 1;
+  }
+
+  bool Final(unsigned char* md_value, unsigned int* md_len) {
+    if (!initialised_) return false;
+    EVP_DigestFinal_ex(&mdctx, md_value, md_len);
+    EVP_MD_CTX_cleanup(&mdctx);
+    initialised_ = false;
+    return true;
+  }
+
 
  protected:
 
@@ -2896,6 +3275,14 @@ class Hash : public ObjectWrap {
 
     Hash *hash = ObjectWrap::Unwrap<Hash>(args.This());
 
+    if (args[2]->IsFunction()) {
+      ASSERT_IS_BUFFER(args[0]);
+      hash->QueueUpdate(args[0], args[2]);
+      return args.This();
+    }
+
+    if (hash->IsBusy()) return ThrowError("Asynchronous operation pending");
+
     ASSERT_IS_STRING_OR_BUFFER(args[0]);
 
     // Only copy the data if we have to, because it's a string
@@ -2929,15 +3316,22 @@ class Hash : public ObjectWrap {
 
     Hash *hash = ObjectWrap::Unwrap<Hash>(args.This());
 
-    if (!hash->initialised_) {
-      return ThrowException(Exception::Error(String::New("Not initialized")));
-    }
-
     enum encoding encoding = BUFFER;
     if (args.Length() >= 1) {
       encoding = ParseEncoding(args[0]->ToString(), BUFFER);
     }
 
+    if (args[1]->IsFunction()) {
+      hash->QueueDigest(args[1], encoding);
+      return Undefined();
+    }
+
+    if (hash->IsBusy()) return ThrowError("Asynchronous operation pending");
+
+    if (!hash->initialised_) {
+      return ThrowException(Exception::Error(String::New("Not initialized")));
+    }
+
     unsigned char md_value[EVP_MAX_MD_SIZE];
     unsigned int md_len;
 
@@ -2949,7 +3343,7 @@ class Hash : public ObjectWrap {
           reinterpret_cast<const char*>(md_value), md_len, encoding));
   }
 
-  Hash () : ObjectWrap () {
+  Hash () : AsyncDigest () {
     initialised_ = false;
   }
 
@@ -2966,6 +3360,118 @@ class Hash : public ObjectWrap {
   bool initialised_;
 };
 
+// Requests for the sign, verify and Diffie-Hellman operations that can run
+// on the thread pool. The request owns everything the work touches, so the
+// JS object stays usable while the work is in flight.
+struct SignRequest {
+  SignRequest();
+  ~SignRequest();
+  Persistent<Object> obj_;
+  uv_work_t work_req_;
+  bool initialised_;
+  EVP_MD_CTX mdctx_;
+  char* key_pem_;
+  int key_pem_len_;
+  unsigned char* md_value_;
+  unsigned int md_len_;
+  bool ok_;
+};
+
+
+SignRequest::SignRequest()
+    : initialised_(false),
+      key_pem_(NULL),
+      key_pem_len_(0),
+      md_value_(NULL),
+      md_len_(0),
+      ok_(false) {
+}
+
+
+SignRequest::~SignRequest() {
+  if (initialised_) EVP_MD_CTX_cleanup(&mdctx_);
+  delete[] key_pem_;
+  delete[] md_value_;
+  if (obj_.IsEmpty()) return;
+  obj_.Dispose();
+  obj_.Clear();
+}
+
+
+struct VerifyRequest {
+  VerifyRequest();
+  ~VerifyRequest();
+  Persistent<Object> obj_;
+  uv_work_t work_req_;
+  bool initialised_;
+  EVP_MD_CTX mdctx_;
+  char* key_pem_;
+  int key_pem_len_;
+  unsigned char* sig_;
+  int sig_len_;
+  int result_;
+};
+
+
+VerifyRequest::VerifyRequest()
+    : initialised_(false),
+      key_pem_(NULL),
+      key_pem_len_(0),
+      sig_(NULL),
+      sig_len_(0),
+      result_(0) {
+}
+
+
+VerifyRequest::~VerifyRequest() {
+  if (initialised_) EVP_MD_CTX_cleanup(&mdctx_);
+  delete[] key_pem_;
+  delete[] sig_;
+  if (obj_.IsEmpty()) return;
+  obj_.Dispose();
+  obj_.Clear();
+}
+
+
+struct DiffieHellmanRequest {
+  DiffieHellmanRequest();
+  ~DiffieHellmanRequest();
+  Persistent<Object> obj_;
+  // The DiffieHellman object, generateKeys() stores its result there.
+  Persistent<Object> handle_;
+  uv_work_t work_req_;
+  // A copy of the parameters and private key, or the object's own DH when
+  // the work runs synchronously.
+  DH* dh_;
+  bool owns_dh_;
+  BIGNUM* key_;
+  char* data_;
+  int size_;
+  const char* error_;
+};
+
+
+DiffieHellmanRequest::DiffieHellmanRequest()
+    : dh_(NULL),
+      owns_dh_(false),
+      key_(NULL),
+      data_(NULL),
+      size_(0),
+      error_(NULL) {
+}
+
+
+DiffieHellmanRequest::~DiffieHellmanRequest() {
+  if (owns_dh_ && dh_ != NULL) DH_free(dh_);
+  if (key_ != NULL) BN_free(key_);
+  delete[] data_;
+  if (!handle_.IsEmpty()) handle_.Dispose();
+  if (obj_.IsEmpty()) return;
+  obj_.Dispose();
+  obj_.Clear();
+}
+
+
 class Sign : public ObjectWrap {
  public:
   static void
@@ -3002,26 +3508,48 @@ class Sign : public ObjectWrap {
     return 1;
   }
 
-  int SignFinal(unsigned char** md_value,
-                unsigned int *md_len,
-                char* key_pem,
-                int key_pemLen) {
-    if (!initialised_) return 0;
+  static void SignWork(uv_work_t* work_req) {
+    SignRequest* req = container_of(work_req, SignRequest, work_req_);
+    if (!req->initialised_) return;
+
+    ClearErrorOnReturn clear_error_on_return;
+    (void) &clear_error_on_return;  // Silence compiler warning.
 
     BIO *bp = NULL;
-    EVP_PKEY* pkey;
+    EVP_PKEY* pkey = NULL;
     bp = BIO_new(BIO_s_mem());
-    if(!BIO_write(bp, key_pem, key_pemLen)) return 0;
+    if (bp != NULL && BIO_write(bp, req->key_pem_, req->key_pem_len_)) {
+      pkey = PEM_read_bio_PrivateKey(bp, NULL, NULL, NULL);
+    }
+
+    if (pkey != NULL) {
+      req->ok_ = EVP_SignFinal(&req->mdctx_,
+                               req->md_value_,
+                               &req->md_len_,
+                               pkey) == 1;
+      EVP_PKEY_free(pkey);
+    }
 
-    pkey = PEM_read_bio_PrivateKey( bp, NULL, NULL, NULL );
-    if (pkey == NULL) return 0;
+    if (bp != NULL) BIO_free(bp);
+    EVP_MD_CTX_cleanup(&req->mdctx_);
+    req->initialised_ = false;
+  }
 
-    EVP_SignFinal(&mdctx, *md_value, md_len, pkey);
-    EVP_MD_CTX_cleanup(&mdctx);
-    initialised_ = false;
-    EVP_PKEY_free(pkey);
-    BIO_free(bp);
-    return 1;
+
+  static void SignAfter(uv_work_t* work_req, int status) {
+    assert(status == 0);
+    SignRequest* req = container_of(work_req, SignRequest, work_req_);
+    HandleScope scope;
+    Local<Value> argv[2];
+    if (req->ok_) {
+      argv[0] = Local<Value>::New(Null());
+      argv[1] = Encode(req->md_value_, req->md_len_, BUFFER);
+    } else {
+      argv[0] = Exception::Error(String::New("SignFinal error"));
+      argv[1] = Local<Value>::New(Null());
+    }
+    MakeCallback(req->obj_, "ondone", ARRAY_SIZE(argv), argv);
+    delete req;
   }
 
 
@@ -3095,37 +3623,50 @@ class Sign : public ObjectWrap {
 
     HandleScope scope;
 
-    unsigned char* md_value;
-    unsigned int md_len;
-    Local<Value> outString;
-
     ASSERT_IS_BUFFER(args[0]);
     ssize_t len = Buffer::Length(args[0]);
 
+    bool async = args[1]->IsFunction();
     enum encoding encoding = BUFFER;
-    if (args.Length() >= 2) {
+    if (args.Length() >= 2 && !async) {
       encoding = ParseEncoding(args[1]->ToString(), BUFFER);
     }
 
-    char* buf = new char[len];
-    ssize_t written = DecodeWrite(buf, len, args[0], BUFFER);
+    SignRequest* req = new SignRequest();
+    req->key_pem_ = new char[len];
+    req->key_pem_len_ = len;
+    ssize_t written = DecodeWrite(req->key_pem_, len, args[0], BUFFER);
     assert(written == len);
 
-    md_len = 8192; // Maximum key size is 8192 bits
-    md_value = new unsigned char[md_len];
+    req->md_len_ = 8192; // Maximum key size is 8192 bits
+    req->md_value_ = new unsigned char[req->md_len_];
 
-    int r = sign->SignFinal(&md_value, &md_len, buf, len);
-    if (r == 0) {
-      md_value = NULL;
-      md_len = r;
+    // The digest moves to the request, signing finishes the Sign object.
+    if (sign->initialised_) {
+      req->mdctx_ = sign->mdctx;
+      req->initialised_ = true;
+      sign->initialised_ = false;
     }
 
-    delete [] buf;
+    if (async) {
+      req->obj_ = Persistent<Object>::New(Object::New());
+      req->obj_->Set(String::New("ondone"), args[1]);
+      uv_queue_work_class(uv_default_loop(),
+                          &req->work_req_,
+                          UV_WORK_CPU,
+                          SignWork,
+                          SignAfter);
+      return Undefined();
+    }
 
-    outString = StringBytes::Encode(
-        reinterpret_cast<const char*>(md_value), md_len, encoding);
+    SignWork(&req->work_req_);
+
+    Local<Value> outString = StringBytes::Encode(
+        reinterpret_cast<const char*>(req->md_value_),
+        req->ok_ ? req->md_len_ : 0,
+        encoding);
 
-    delete [] md_value;
+    delete req;
     return scope.Close(outString);
   }
 
@@ -3183,9 +3724,11 @@ class Verify : public ObjectWrap {
   }
 
 
-  int VerifyFinal(char* key_pem, int key_pemLen, unsigned char* sig, int siglen) {
-    if (!initialised_) return 0;
-
+  static int VerifyFinal(EVP_MD_CTX* mdctx,
+                         char* key_pem,
+                         int key_pemLen,
+                         unsigned char* sig,
+                         int siglen) {
     ClearErrorOnReturn clear_error_on_return;
     (void) &clear_error_on_return;  // Silence compiler warning.
 
@@ -3239,7 +3782,7 @@ class Verify : public ObjectWrap {
       }
     }
 
-    r = EVP_VerifyFinal(&mdctx, sig, siglen, pkey);
+    r = EVP_VerifyFinal(mdctx, sig, siglen, pkey);
 
     if(pkey != NULL)
       EVP_PKEY_free (pkey);
@@ -3247,13 +3790,38 @@ class Verify : public ObjectWrap {
       X509_free(x509);
     if (bp != NULL)
       BIO_free(bp);
-    EVP_MD_CTX_cleanup(&mdctx);
-    initialised_ = false;
 
     return r;
   }
 
 
+  static void VerifyWork(uv_work_t* work_req) {
+    VerifyRequest* req = container_of(work_req, VerifyRequest, work_req_);
+    if (!req->initialised_) return;
+
+    req->result_ = VerifyFinal(&req->mdctx_,
+                               req->key_pem_,
+                               req->key_pem_len_,
+                               req->sig_,
+                               req->sig_len_);
+    EVP_MD_CTX_cleanup(&req->mdctx_);
+    req->initialised_ = false;
+  }
+
+
+  static void VerifyAfter(uv_work_t* work_req, int status) {
+    assert(status == 0);
+    VerifyRequest* req = container_of(work_req, VerifyRequest, work_req_);
+    HandleScope scope;
+    Local<Value> argv[2] = {
+      Local<Value>::New(Null()),
+      Local<Value>::New(Boolean::New(req->result_ && req->result_ != -1))
+    };
+    MakeCallback(req->obj_, "ondone", ARRAY_SIZE(argv), argv);
+    delete req;
+  }
+
+
  protected:
 
   static Handle<Value> New (const Arguments& args) {
@@ -3335,36 +3903,56 @@ class Verify : public ObjectWrap {
       return ThrowException(exception);
     }
 
-    char* kbuf = new char[klen];
-    ssize_t kwritten = DecodeWrite(kbuf, klen, args[0], BINARY);
-    assert(kwritten == klen);
-
     ASSERT_IS_STRING_OR_BUFFER(args[1]);
 
     // BINARY works for both buffers and binary strings.
+    bool async = args[2]->IsFunction();
     enum encoding encoding = BINARY;
-    if (args.Length() >= 3) {
+    if (args.Length() >= 3 && !async) {
       encoding = ParseEncoding(args[2]->ToString(), BINARY);
     }
 
     ssize_t hlen = StringBytes::Size(args[1], encoding);
 
     if (hlen < 0) {
-      delete[] kbuf;
       Local<Value> exception = Exception::TypeError(String::New("Bad argument"));
       return ThrowException(exception);
     }
 
-    unsigned char* hbuf = new unsigned char[hlen];
+    VerifyRequest* req = new VerifyRequest();
+
+    req->key_pem_ = new char[klen];
+    req->key_pem_len_ = klen;
+    ssize_t kwritten = DecodeWrite(req->key_pem_, klen, args[0], BINARY);
+    assert(kwritten == klen);
+
+    req->sig_ = new unsigned char[hlen];
+    req->sig_len_ = hlen;
     ssize_t hwritten = StringBytes::Write(
-        reinterpret_cast<char*>(hbuf), hlen, args[1], encoding);
+        reinterpret_cast<char*>(req->sig_), hlen, args[1], encoding);
     assert(hwritten == hlen);
 
-    int r;
-    r = verify->VerifyFinal(kbuf, klen, hbuf, hlen);
+    // The digest moves to the request, verifying finishes the Verify object.
+    if (verify->initialised_) {
+      req->mdctx_ = verify->mdctx;
+      req->initialised_ = true;
+      verify->initialised_ = false;
+    }
+
+    if (async) {
+      req->obj_ = Persistent<Object>::New(Object::New());
+      req->obj_->Set(String::New("ondone"), args[2]);
+      uv_queue_work_class(uv_default_loop(),
+                          &req->work_req_,
+                          UV_WORK_CPU,
+                          VerifyWork,
+                          VerifyAfter);
+      return Undefined();
+    }
 
-    delete[] kbuf;
-    delete[] hbuf;
+    VerifyWork(&req->work_req_);
+    int r = req->result_;
+    delete req;
 
     return Boolean::New(r && r != -1);
   }
@@ -3519,6 +4107,26 @@ class DiffieHellman : public ObjectWrap {
             String::New("Not initialized")));
     }
 
+    if (args[0]->IsFunction()) {
+      DiffieHellmanRequest* req = new DiffieHellmanRequest();
+      req->dh_ = diffieHellman->Clone();
+      req->owns_dh_ = true;
+      if (req->dh_ == NULL) {
+        delete req;
+        return ThrowException(Exception::Error(
+              String::New("Key generation failed")));
+      }
+      req->obj_ = Persistent<Object>::New(Object::New());
+      req->obj_->Set(String::New("ondone"), args[0]);
+      req->handle_ = Persistent<Object>::New(args.This());
+      uv_queue_work_class(uv_default_loop(),
+                          &req->work_req_,
+                          UV_WORK_CPU,
+                          GenerateKeysWork,
+                          GenerateKeysAfter);
+      return Undefined();
+    }
+
     if (!DH_generate_key(diffieHellman->dh)) {
       return ThrowException(Exception::Error(
             String::New("Key generation failed")));
@@ -3651,52 +4259,120 @@ class DiffieHellman : public ObjectWrap {
       return ThrowException(Exception::Error(String::New("Not initialized")));
     }
 
-    ClearErrorOnReturn clear_error_on_return;
-    (void) &clear_error_on_return;  // Silence compiler warning.
-    BIGNUM* key = 0;
-
     if (args.Length() == 0) {
       return ThrowException(Exception::Error(
             String::New("First argument must be other party's public key")));
+    }
+
+    ASSERT_IS_BUFFER(args[0]);
+
+    DiffieHellmanRequest* req = new DiffieHellmanRequest();
+    req->key_ = BN_bin2bn(
+      reinterpret_cast<unsigned char*>(Buffer::Data(args[0])),
+      Buffer::Length(args[0]), 0);
+
+    if (args[1]->IsFunction()) {
+      req->dh_ = diffieHellman->Clone();
+      req->owns_dh_ = true;
+      if (req->dh_ == NULL) {
+        delete req;
+        return ThrowException(Exception::Error(String::New("Invalid key")));
+      }
+      req->obj_ = Persistent<Object>::New(Object::New());
+      req->obj_->Set(String::New("ondone"), args[1]);
+      uv_queue_work_class(uv_default_loop(),
+                          &req->work_req_,
+                          UV_WORK_CPU,
+                          ComputeSecretWork,
+                          ComputeSecretAfter);
+      return Undefined();
+    }
+
+    req->dh_ = diffieHellman->dh;
+    ComputeSecretWork(&req->work_req_);
+
+    if (req->error_ != NULL) {
+      Local<Value> exception = Exception::Error(String::New(req->error_));
+      delete req;
+      return ThrowException(exception);
+    }
+
+    Local<Value> outString = Encode(req->data_, req->size_, BUFFER);
+    delete req;
+    return scope.Close(outString);
+  }
+
+
+  static void GenerateKeysWork(uv_work_t* work_req) {
+    DiffieHellmanRequest* req =
+        container_of(work_req, DiffieHellmanRequest, work_req_);
+    if (!DH_generate_key(req->dh_)) req->error_ = "Key generation failed";
+  }
+
+
+  static void GenerateKeysAfter(uv_work_t* work_req, int status) {
+    assert(status == 0);
+    DiffieHellmanRequest* req =
+        container_of(work_req, DiffieHellmanRequest, work_req_);
+    HandleScope scope;
+    Local<Value> argv[2];
+
+    if (req->error_ != NULL) {
+      argv[0] = Exception::Error(String::New(req->error_));
+      argv[1] = Local<Value>::New(Null());
     } else {
-      ASSERT_IS_BUFFER(args[0]);
-      key = BN_bin2bn(
-        reinterpret_cast<unsigned char*>(Buffer::Data(args[0])),
-        Buffer::Length(args[0]), 0);
+      // Hand the new keys over to the object.
+      DH* dh = ObjectWrap::Unwrap<DiffieHellman>(req->handle_)->dh;
+      if (dh->pub_key != NULL) BN_free(dh->pub_key);
+      if (dh->priv_key != NULL) BN_clear_free(dh->priv_key);
+      dh->pub_key = req->dh_->pub_key;
+      dh->priv_key = req->dh_->priv_key;
+      req->dh_->pub_key = NULL;
+      req->dh_->priv_key = NULL;
+
+      int dataSize = BN_num_bytes(dh->pub_key);
+      char* data = new char[dataSize];
+      BN_bn2bin(dh->pub_key, reinterpret_cast<unsigned char*>(data));
+      argv[0] = Local<Value>::New(Null());
+      argv[1] = Encode(data, dataSize, BUFFER);
+      delete[] data;
     }
 
-    int dataSize = DH_size(diffieHellman->dh);
+    MakeCallback(req->obj_, "ondone", ARRAY_SIZE(argv), argv);
+    delete req;
+  }
+
+
+  static void ComputeSecretWork(uv_work_t* work_req) {
+    DiffieHellmanRequest* req =
+        container_of(work_req, DiffieHellmanRequest, work_req_);
+
+    ClearErrorOnReturn clear_error_on_return;
+    (void) &clear_error_on_return;  // Silence compiler warning.
+
+    int dataSize = DH_size(req->dh_);
     char* data = new char[dataSize];
 
     int size = DH_compute_key(reinterpret_cast<unsigned char*>(data),
-      key, diffieHellman->dh);
+      req->key_, req->dh_);
 
     if (size == -1) {
       int checkResult;
       int checked;
 
-      checked = DH_check_pub_key(diffieHellman->dh, key, &checkResult);
-      BN_free(key);
+      checked = DH_check_pub_key(req->dh_, req->key_, &checkResult);
       delete[] data;
 
-      if (!checked) {
-        return ThrowException(Exception::Error(String::New("Invalid key")));
-      } else if (checkResult) {
-        if (checkResult & DH_CHECK_PUBKEY_TOO_SMALL) {
-          return ThrowException(Exception::Error(
-                String::New("Supplied key is too small")));
-        } else if (checkResult & DH_CHECK_PUBKEY_TOO_LARGE) {
-          return ThrowException(Exception::Error(
-                String::New("Supplied key is too large")));
-        } else {
-          return ThrowException(Exception::Error(String::New("Invalid key")));
-        }
+      if (checked && (checkResult & DH_CHECK_PUBKEY_TOO_SMALL)) {
+        req->error_ = "Supplied key is too small";
+      } else if (checked && (checkResult & DH_CHECK_PUBKEY_TOO_LARGE)) {
+        req->error_ = "Supplied key is too large";
       } else {
-        return ThrowException(Exception::Error(String::New("Invalid key")));
+        req->error_ = "Invalid key";
       }
+      return;
     }
 
-    BN_free(key);
     assert(size >= 0);
 
     // DH_size returns number of bytes in a prime number
@@ -3709,12 +4385,28 @@ class DiffieHellman : public ObjectWrap {
       memset(data, 0, dataSize - size);
     }
 
-    Local<Value> outString;
+    req->data_ = data;
+    req->size_ = dataSize;
+  }
 
-    outString = Encode(data, dataSize, BUFFER);
 
-    delete[] data;
-    return scope.Close(outString);
+  static void ComputeSecretAfter(uv_work_t* work_req, int status) {
+    assert(status == 0);
+    DiffieHellmanRequest* req =
+        container_of(work_req, DiffieHellmanRequest, work_req_);
+    HandleScope scope;
+    Local<Value> argv[2];
+
+    if (req->error_ != NULL) {
+      argv[0] = Exception::Error(String::New(req->error_));
+      argv[1] = Local<Value>::New(Null());
+    } else {
+      argv[0] = Local<Value>::New(Null());
+      argv[1] = Encode(req->data_, req->size_, BUFFER);
+    }
+
+    MakeCallback(req->obj_, "ondone", ARRAY_SIZE(argv), argv);
+    delete req;
   }
 
   static Handle<Value> SetPublicKey(const Arguments& args) {
@@ -3778,6 +4470,21 @@ class DiffieHellman : public ObjectWrap {
   }
 
  private:
+  // Parameters and private key for work on the thread pool, which must not
+  // touch the DH the object keeps using.
+  DH* Clone() {
+    DH* copy = DHparams_dup(dh);
+    if (copy == NULL) return NULL;
+    if (dh->priv_key != NULL) {
+      copy->priv_key = BN_dup(dh->priv_key);
+      if (copy->priv_key == NULL) {
+        DH_free(copy);
+        return NULL;
+      }
+    }
+    return copy;
+  }
+
   bool VerifyContext() {
     int codes;
     if (!DH_check(dh, &codes)) return false;
@@ -3932,10 +4639,11 @@ Handle<Value> PBKDF2(const Arguments& args) {
   if (args[4]->IsFunction()) {
     req->obj = Persistent<Object>::New(Object::New());
     req->obj->Set(String::New("ondone"), args[4]);
-    uv_queue_work(uv_default_loop(),
-                  &req->work_req,
-                  EIO_PBKDF2,
-                  EIO_PBKDF2After);
+    uv_queue_work_class(uv_default_loop(),
+                        &req->work_req,
+                        UV_WORK_CPU,
+                        EIO_PBKDF2,
+                        EIO_PBKDF2After);
     return Undefined();
   } else {
     Local<Value> argv[2];
@@ -3952,6 +4660,126 @@ err:
 }
 
 
+struct HashRequest {
+  HashRequest();
+  ~HashRequest();
+  Persistent<Object> obj_;
+  uv_work_t work_req_;
+  const EVP_MD* md_;
+  const char* data_;
+  size_t len_;
+  char* key_;  // NULL for a plain digest
+  size_t key_len_;
+  unsigned char md_value_[EVP_MAX_MD_SIZE];
+  unsigned int md_len_;
+  bool ok_;
+};
+
+
+HashRequest::HashRequest()
+    : md_(NULL),
+      data_(NULL),
+      len_(0),
+      key_(NULL),
+      key_len_(0),
+      md_len_(0),
+      ok_(false) {
+}
+
+
+HashRequest::~HashRequest() {
+  if (key_ != NULL) {
+    OPENSSL_cleanse(key_, key_len_);
+    delete[] key_;
+  }
+  if (obj_.IsEmpty()) return;
+  obj_.Dispose();
+  obj_.Clear();
+}
+
+
+void HashWork(uv_work_t* work_req) {
+  HashRequest* req = container_of(work_req, HashRequest, work_req_);
+
+  if (req->key_ != NULL) {
+    req->ok_ = HMAC(req->md_,
+                    req->key_,
+                    req->key_len_,
+                    reinterpret_cast<const unsigned char*>(req->data_),
+                    req->len_,
+                    req->md_value_,
+                    &req->md_len_) != NULL;
+  } else {
+    req->ok_ = EVP_Digest(req->data_,
+                          req->len_,
+                          req->md_value_,
+                          &req->md_len_,
+                          req->md_,
+                          NULL) == 1;
+  }
+}
+
+
+void HashAfter(uv_work_t* work_req, int status) {
+  assert(status == 0);
+  HashRequest* req = container_of(work_req, HashRequest, work_req_);
+  HandleScope scope;
+  Local<Value> argv[2];
+
+  if (req->ok_) {
+    argv[0] = Local<Value>::New(Null());
+    argv[1] = Encode(req->md_value_, req->md_len_, BUFFER);
+  } else {
+    argv[0] = Exception::Error(String::New("Hash error"));
+    argv[1] = Local<Value>::New(Null());
+  }
+
+  MakeCallback(req->obj_, "ondone", ARRAY_SIZE(argv), argv);
+  delete req;
+}
+
+
+// hash(algorithm, buffer, key, callback) digests the whole buffer on the
+// thread pool, as an HMAC when `key` is a buffer. The data is not copied,
+// it must not change until the callback ran.
+Handle<Value> HashBuffer(const Arguments& args) {
+  HandleScope scope;
+
+  if (args.Length() != 4 || !args[0]->IsString() || !args[3]->IsFunction()) {
+    return ThrowTypeError("Bad parameter");
+  }
+
+  ASSERT_IS_BUFFER(args[1]);
+
+  String::Utf8Value algorithm(args[0]);
+  const EVP_MD* md = EVP_get_digestbyname(*algorithm);
+  if (md == NULL) return ThrowError("Digest method not supported");
+
+  HashRequest* req = new HashRequest();
+  req->md_ = md;
+  req->data_ = Buffer::Data(args[1]);
+  req->len_ = Buffer::Length(args[1]);
+
+  if (Buffer::HasInstance(args[2])) {
+    req->key_len_ = Buffer::Length(args[2]);
+    req->key_ = new char[req->key_len_];
+    memcpy(req->key_, Buffer::Data(args[2]), req->key_len_);
+  }
+
+  req->obj_ = Persistent<Object>::New(Object::New());
+  req->obj_->Set(String::New("ondone"), args[3]);
+  req->obj_->Set(String::NewSymbol("buffer"), args[1]);
+
+  uv_queue_work_class(uv_default_loop(),
+                      &req->work_req_,
+                      UV_WORK_CPU,
+                      HashWork,
+                      HashAfter);
+
+  return Undefined();
+}
+
+
 struct RandomBytesRequest {
   ~RandomBytesRequest();
   Persistent<Object> obj_;
@@ -4057,10 +4885,11 @@ Handle<Value> RandomBytes(const Arguments& args) {
     req->obj_ = Persistent<Object>::New(Object::New());
     req->obj_->Set(String::New("ondone"), args[1]);
 
-    uv_queue_work(uv_default_loop(),
-                  &req->work_req_,
-                  RandomBytesWork<pseudoRandom>,
-                  RandomBytesAfter);
+    uv_queue_work_class(uv_default_loop(),
+                        &req->work_req_,
+                        UV_WORK_CPU,
+                        RandomBytesWork<pseudoRandom>,
+                        RandomBytesAfter);
 
     return req->obj_;
   }
@@ -4160,6 +4989,7 @@ void InitCrypto(Handle<Object> target) {
 #endif
 
   SecureContext::Initialize(target);
+  SharedSessionCache::Initialize(target);
   Connection::Initialize(target);
   Cipher::Initialize(target);
   Decipher::Initialize(target);
@@ -4170,6 +5000,7 @@ void InitCrypto(Handle<Object> target) {
   Verify::Initialize(target);
 
   NODE_SET_METHOD(target, "PBKDF2", PBKDF2);
+  NODE_SET_METHOD(target, "hash", HashBuffer);
   NODE_SET_METHOD(target, "randomBytes", RandomBytes<false>);
   NODE_SET_METHOD(target, "pseudoRandomBytes", RandomBytes<true>);
   NODE_SET_METHOD(target, "getSSLCiphers", GetSSLCiphers);
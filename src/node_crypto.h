@@ -25,6 +25,7 @@
 #include "node.h"
 
 #include "node_object_wrap.h"
+#include "node_crypto_session_cache.h"
 #include "v8.h"
 
 #include <openssl/ssl.h>
@@ -45,9 +46,13 @@
 
 
 namespace node {
+
+// Forward declaration
+class TLSCallbacks;
+
 namespace crypto {
 
-static X509_STORE* root_cert_store;
+extern X509_STORE* root_cert_store;
 
 // Forward declaration
 class Connection;
@@ -62,6 +67,10 @@ class SecureContext : ObjectWrap {
 
  protected:
   static const int kMaxSessionSize = 10 * 1024;
+  // A ticket key is a 16 byte name, a 16 byte HMAC secret and a 16 byte
+  // AES key, in that order.
+  static const int kTicketKeyNameSize = 16;
+  static const int kTicketKeySize = 48;
 
   static v8::Handle<v8::Value> New(const v8::Arguments& args);
   static v8::Handle<v8::Value> Init(const v8::Arguments& args);
@@ -73,6 +82,9 @@ class SecureContext : ObjectWrap {
   static v8::Handle<v8::Value> SetCiphers(const v8::Arguments& args);
   static v8::Handle<v8::Value> SetOptions(const v8::Arguments& args);
   static v8::Handle<v8::Value> SetSessionIdContext(const v8::Arguments& args);
+  static v8::Handle<v8::Value> SetSessionCache(const v8::Arguments& args);
+  static v8::Handle<v8::Value> SetTicketKeys(const v8::Arguments& args);
+  static v8::Handle<v8::Value> GetTicketKeys(const v8::Arguments& args);
   static v8::Handle<v8::Value> Close(const v8::Arguments& args);
   static v8::Handle<v8::Value> LoadPKCS12(const v8::Arguments& args);
 
@@ -81,10 +93,29 @@ class SecureContext : ObjectWrap {
                                          int len,
                                          int* copy);
   static int NewSessionCallback(SSL* s, SSL_SESSION* sess);
+  static void RemoveSessionCallback(SSL_CTX* ctx, SSL_SESSION* sess);
+  static int TicketKeyCallback(SSL* s,
+                               unsigned char* name,
+                               unsigned char* iv,
+                               EVP_CIPHER_CTX* ectx,
+                               HMAC_CTX* hctx,
+                               int enc);
 
   SecureContext() : ObjectWrap() {
     ctx_ = NULL;
     ca_store_ = NULL;
+    session_cache_ = NULL;
+    ticket_keys_ = NULL;
+    ticket_key_count_ = 0;
+  }
+
+  void FreeTicketKeys() {
+    if (ticket_keys_ != NULL) {
+      OPENSSL_cleanse(ticket_keys_, ticket_key_count_ * kTicketKeySize);
+      delete[] ticket_keys_;
+      ticket_keys_ = NULL;
+    }
+    ticket_key_count_ = 0;
   }
 
   void FreeCTXMem() {
@@ -106,9 +137,20 @@ class SecureContext : ObjectWrap {
 
   ~SecureContext() {
     FreeCTXMem();
+    FreeTicketKeys();
+    if (!session_cache_obj_.IsEmpty()) session_cache_obj_.Dispose();
   }
 
  private:
+  // Optional external store for server sessions, kept alive through its
+  // JS object.
+  SessionCache* session_cache_;
+  v8::Persistent<v8::Object> session_cache_obj_;
+
+  // Ring of ticket keys. New tickets are issued with the first one, tickets
+  // issued with any of them are accepted.
+  unsigned char* ticket_keys_;
+  unsigned int ticket_key_count_;
 };
 
 class ClientHelloParser {
@@ -158,6 +200,9 @@ class Connection : ObjectWrap {
  public:
   static void Initialize(v8::Handle<v8::Object> target);
 
+  // Returns NULL if `value` is not a Connection.
+  static Connection* FromValue(v8::Handle<v8::Value> value);
+
 #ifdef OPENSSL_NPN_NEGOTIATED
   v8::Persistent<v8::Object> npnProtos_;
   v8::Persistent<v8::Value> selectedNPNProto_;
@@ -211,6 +256,14 @@ class Connection : ObjectWrap {
   static int SelectSNIContextCallback_(SSL *s, int *ad, void* arg);
 #endif
 
+  // The work behind EncIn, ClearOut, EncOut, ClearIn and Shutdown. Errors
+  // are reported through the `error` property of the JS object.
+  int DoEncIn(char* data, size_t len);
+  int DoClearOut(char* data, size_t len);
+  int DoEncOut(char* data, size_t len);
+  int DoClearIn(const char* data, size_t len);
+  int DoShutdown();
+
   int HandleBIOError(BIO *bio, const char* func, int rv);
 
   enum ZeroStatus {
@@ -277,6 +330,7 @@ class Connection : ObjectWrap {
 
   friend class ClientHelloParser;
   friend class SecureContext;
+  friend class node::TLSCallbacks;
 };
 
 void InitCrypto(v8::Handle<v8::Object> target);
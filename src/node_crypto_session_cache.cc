@@ -0,0 +1,455 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "node_crypto_session_cache.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef _WIN32
+# include <fcntl.h>
+# include <sched.h>
+# include <signal.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+namespace node {
+namespace crypto {
+
+using v8::Arguments;
+using v8::Exception;
+using v8::FunctionTemplate;
+using v8::Handle;
+using v8::HandleScope;
+using v8::Integer;
+using v8::Local;
+using v8::Number;
+using v8::Object;
+using v8::Persistent;
+using v8::String;
+using v8::Undefined;
+using v8::Value;
+
+static Persistent<FunctionTemplate> shared_session_cache_constructor;
+
+// Header and bucket headers each take a cache line of their own.
+static const size_t kHeaderSize = 64;
+static const size_t kBucketHeaderSize = 64;
+
+
+void SharedSessionCache::Initialize(Handle<Object> target) {
+  HandleScope scope;
+
+  Local<FunctionTemplate> t = FunctionTemplate::New(SharedSessionCache::New);
+  shared_session_cache_constructor = Persistent<FunctionTemplate>::New(t);
+
+  t->InstanceTemplate()->SetInternalFieldCount(1);
+  t->SetClassName(String::NewSymbol("SharedSessionCache"));
+
+  NODE_SET_PROTOTYPE_METHOD(t, "getStats", SharedSessionCache::GetStats);
+  NODE_SET_PROTOTYPE_METHOD(t, "unlink", SharedSessionCache::Unlink);
+
+  target->Set(String::NewSymbol("SharedSessionCache"), t->GetFunction());
+}
+
+
+bool SharedSessionCache::HasInstance(Handle<Value> value) {
+  return value->IsObject() &&
+         shared_session_cache_constructor->HasInstance(value);
+}
+
+
+SharedSessionCache* SharedSessionCache::Unwrap(Handle<Value> value) {
+  assert(HasInstance(value));
+  return ObjectWrap::Unwrap<SharedSessionCache>(value.As<Object>());
+}
+
+
+Handle<Value> SharedSessionCache::New(const Arguments& args) {
+  HandleScope scope;
+
+  if (args.Length() < 2 || !args[0]->IsString() || !args[1]->IsNumber()) {
+    return ThrowException(Exception::TypeError(
+          String::New("Takes a name and a number of sessions")));
+  }
+
+  String::Utf8Value name(args[0]);
+  int64_t sessions = args[1]->IntegerValue();
+  if (name.length() == 0 || name.length() >= 255 || sessions <= 0 ||
+      sessions > 1024 * 1024) {
+    return ThrowException(Exception::RangeError(
+          String::New("Bad name or number of sessions")));
+  }
+
+  SharedSessionCache* cache = new SharedSessionCache();
+  cache->Wrap(args.Holder());
+
+  const char* syscall = NULL;
+  int err = cache->Open(*name, static_cast<uint32_t>(sessions), &syscall);
+  if (err != 0) {
+    return ThrowException(ErrnoException(err, syscall));
+  }
+
+  return args.This();
+}
+
+
+#ifndef _WIN32
+
+int SharedSessionCache::Open(const char* name,
+                             uint32_t sessions,
+                             const char** syscall) {
+  // shm_open() wants a name with exactly one leading slash.
+  snprintf(name_, sizeof(name_), "%s%s", name[0] == '/' ? "" : "/", name);
+
+  uint32_t bucket_count = (sessions + kWays - 1) / kWays;
+  size_t size = kHeaderSize +
+                bucket_count * (kBucketHeaderSize + kWays * kSlotSize);
+
+  bool creator = true;
+  int fd = shm_open(name_, O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd == -1 && errno == EEXIST) {
+    creator = false;
+    fd = shm_open(name_, O_RDWR, 0600);
+  }
+  if (fd == -1) {
+    *syscall = "shm_open";
+    return errno;
+  }
+
+  if (creator) {
+    if (ftruncate(fd, size) == -1) {
+      int err = errno;
+      close(fd);
+      shm_unlink(name_);
+      *syscall = "ftruncate";
+      return err;
+    }
+  } else {
+    // Someone else created the segment. It may still be being sized, and
+    // its geometry wins over ours.
+    struct stat s;
+    for (int i = 0; ; i++) {
+      if (fstat(fd, &s) == -1) {
+        int err = errno;
+        close(fd);
+        *syscall = "fstat";
+        return err;
+      }
+      if (static_cast<size_t>(s.st_size) >= kHeaderSize) break;
+      if (i == 1000) {
+        close(fd);
+        *syscall = "shm_open";
+        return EAGAIN;
+      }
+      usleep(1000);
+    }
+    size = s.st_size;
+  }
+
+  void* base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    *syscall = "mmap";
+    return errno;
+  }
+
+  base_ = static_cast<char*>(base);
+  size_ = size;
+  header_ = reinterpret_cast<Header*>(base_);
+
+  if (creator) {
+    // ftruncate() zero-fills, so all that is left is the header. The magic
+    // goes in last, it tells the other processes the segment is ready.
+    header_->bucket_count = bucket_count;
+    __sync_synchronize();
+    header_->magic = kMagic;
+  } else {
+    for (int i = 0; header_->magic != kMagic; i++) {
+      if (i == 1000) {
+        *syscall = "shm_open";
+        return EAGAIN;
+      }
+      usleep(1000);
+    }
+    __sync_synchronize();
+
+    size_t expected = kHeaderSize + header_->bucket_count *
+                      (kBucketHeaderSize + kWays * kSlotSize);
+    if (expected > size_) {
+      *syscall = "shm_open";
+      return EINVAL;
+    }
+  }
+
+  return 0;
+}
+
+
+SharedSessionCache::~SharedSessionCache() {
+  if (base_ != NULL) {
+    munmap(base_, size_);
+    base_ = NULL;
+    header_ = NULL;
+  }
+}
+
+
+SharedSessionCache::Bucket* SharedSessionCache::BucketFor(
+    const unsigned char* id,
+    unsigned int id_len) {
+  // FNV-1a, session ids are random but their length is not fixed.
+  uint32_t hash = 2166136261u;
+  for (unsigned int i = 0; i < id_len; i++) {
+    hash ^= id[i];
+    hash *= 16777619u;
+  }
+
+  size_t index = hash % header_->bucket_count;
+  return reinterpret_cast<Bucket*>(
+      base_ + kHeaderSize +
+      index * (kBucketHeaderSize + kWays * kSlotSize));
+}
+
+
+SharedSessionCache::Slot* SharedSessionCache::SlotAt(Bucket* bucket,
+                                                     unsigned int way) {
+  return reinterpret_cast<Slot*>(
+      reinterpret_cast<char*>(bucket) + kBucketHeaderSize + way * kSlotSize);
+}
+
+
+SharedSessionCache::Slot* SharedSessionCache::Find(Bucket* bucket,
+                                                   const unsigned char* id,
+                                                   unsigned int id_len) {
+  for (unsigned int way = 0; way < kWays; way++) {
+    Slot* slot = SlotAt(bucket, way);
+    if (slot->stamp != 0 &&
+        slot->id_length == id_len &&
+        memcmp(slot->id, id, id_len) == 0) {
+      return slot;
+    }
+  }
+  return NULL;
+}
+
+
+bool SharedSessionCache::Lock(Bucket* bucket) {
+  uint32_t self = getpid();
+
+  for (unsigned int i = 0; i < kMaxSpins; i++) {
+    uint32_t owner = __sync_val_compare_and_swap(&bucket->lock, 0, self);
+    if (owner == 0) return true;
+
+    // Take over locks of processes that died holding them.
+    if (kill(owner, 0) == -1 && errno == ESRCH &&
+        __sync_bool_compare_and_swap(&bucket->lock, owner, self)) {
+      return true;
+    }
+
+    if (i >= 16) sched_yield();
+  }
+
+  return false;
+}
+
+
+void SharedSessionCache::Unlock(Bucket* bucket) {
+  __sync_lock_release(&bucket->lock);
+}
+
+
+SSL_SESSION* SharedSessionCache::Get(const unsigned char* id,
+                                     unsigned int id_len) {
+  if (header_ == NULL || id_len > SSL_MAX_SSL_SESSION_ID_LENGTH) return NULL;
+
+  unsigned char data[kMaxDataSize];
+  size_t data_length = 0;
+
+  Bucket* bucket = BucketFor(id, id_len);
+  if (Lock(bucket)) {
+    Slot* slot = Find(bucket, id, id_len);
+    if (slot != NULL) {
+      data_length = slot->data_length;
+      memcpy(data, reinterpret_cast<char*>(slot) + sizeof(*slot), data_length);
+    }
+    Unlock(bucket);
+  }
+
+  SSL_SESSION* sess = NULL;
+  if (data_length > 0) {
+    const unsigned char* p = data;
+    sess = d2i_SSL_SESSION(NULL, &p, data_length);
+  }
+
+  // OpenSSL would refuse an expired session anyway, drop it for good.
+  if (sess != NULL &&
+      SSL_SESSION_get_time(sess) + SSL_SESSION_get_timeout(sess) <
+          time(NULL)) {
+    SSL_SESSION_free(sess);
+    sess = NULL;
+    Remove(id, id_len);
+  }
+
+  __sync_fetch_and_add(sess != NULL ? &header_->hits : &header_->misses, 1);
+
+  return sess;
+}
+
+
+void SharedSessionCache::Put(SSL_SESSION* sess) {
+  if (header_ == NULL ||
+      sess->session_id_length > SSL_MAX_SSL_SESSION_ID_LENGTH) {
+    return;
+  }
+
+  int size = i2d_SSL_SESSION(sess, NULL);
+  if (size <= 0 || static_cast<size_t>(size) > kMaxDataSize) return;
+
+  // Serialize outside of the lock.
+  unsigned char data[kMaxDataSize];
+  unsigned char* p = data;
+  i2d_SSL_SESSION(sess, &p);
+
+  const unsigned char* id = sess->session_id;
+  unsigned int id_len = sess->session_id_length;
+
+  Bucket* bucket = BucketFor(id, id_len);
+  if (!Lock(bucket)) return;
+
+  Slot* slot = Find(bucket, id, id_len);
+  if (slot == NULL) {
+    // Take an empty slot, or evict the oldest one.
+    for (unsigned int way = 0; way < kWays; way++) {
+      Slot* candidate = SlotAt(bucket, way);
+      if (candidate->stamp == 0) {
+        slot = candidate;
+        break;
+      }
+      if (slot == NULL || candidate->stamp < slot->stamp) slot = candidate;
+    }
+    if (slot->stamp != 0) __sync_fetch_and_add(&header_->evictions, 1);
+  }
+
+  // Stamps only need to be ordered within a bucket. When the clock wraps
+  // the bucket simply evicts in a different order for a while.
+  if (++bucket->clock == 0) bucket->clock = 1;
+  slot->stamp = bucket->clock;
+  slot->id_length = id_len;
+  memcpy(slot->id, id, id_len);
+  slot->data_length = size;
+  memcpy(reinterpret_cast<char*>(slot) + sizeof(*slot), data, size);
+
+  Unlock(bucket);
+
+  __sync_fetch_and_add(&header_->stores, 1);
+}
+
+
+void SharedSessionCache::Remove(const unsigned char* id, unsigned int id_len) {
+  if (header_ == NULL || id_len > SSL_MAX_SSL_SESSION_ID_LENGTH) return;
+
+  Bucket* bucket = BucketFor(id, id_len);
+  if (!Lock(bucket)) return;
+
+  Slot* slot = Find(bucket, id, id_len);
+  if (slot != NULL) slot->stamp = 0;
+
+  Unlock(bucket);
+}
+
+#else  // _WIN32
+
+// No POSIX shared memory. Opening a cache fails, so none of the others are
+// ever called on a usable instance.
+
+int SharedSessionCache::Open(const char* name,
+                             uint32_t sessions,
+                             const char** syscall) {
+  *syscall = "shm_open";
+  return ENOSYS;
+}
+
+
+SharedSessionCache::~SharedSessionCache() {
+}
+
+
+SSL_SESSION* SharedSessionCache::Get(const unsigned char* id,
+                                     unsigned int id_len) {
+  return NULL;
+}
+
+
+void SharedSessionCache::Put(SSL_SESSION* sess) {
+}
+
+
+void SharedSessionCache::Remove(const unsigned char* id, unsigned int id_len) {
+}
+
+#endif  // _WIN32
+
+
+Handle<Value> SharedSessionCache::GetStats(const Arguments& args) {
+  HandleScope scope;
+
+  SharedSessionCache* cache =
+      ObjectWrap::Unwrap<SharedSessionCache>(args.Holder());
+  Header* header = cache->header_;
+
+  Local<Object> stats = Object::New();
+  if (header == NULL) return scope.Close(stats);
+
+  stats->Set(String::NewSymbol("hits"), Number::New(header->hits));
+  stats->Set(String::NewSymbol("misses"), Number::New(header->misses));
+  stats->Set(String::NewSymbol("stores"), Number::New(header->stores));
+  stats->Set(String::NewSymbol("evictions"), Number::New(header->evictions));
+  stats->Set(String::NewSymbol("capacity"),
+             Number::New(static_cast<double>(header->bucket_count) * kWays));
+
+  return scope.Close(stats);
+}
+
+
+Handle<Value> SharedSessionCache::Unlink(const Arguments& args) {
+  HandleScope scope;
+
+  SharedSessionCache* cache =
+      ObjectWrap::Unwrap<SharedSessionCache>(args.Holder());
+
+#ifndef _WIN32
+  // Existing mappings stay valid until every process lets go of them.
+  if (shm_unlink(cache->name_) == -1 && errno != ENOENT) {
+    return ThrowException(ErrnoException(errno, "shm_unlink"));
+  }
+#endif
+
+  return Undefined();
+}
+
+}  // namespace crypto
+}  // namespace node
@@ -0,0 +1,132 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SRC_NODE_CRYPTO_SESSION_CACHE_H_
+#define SRC_NODE_CRYPTO_SESSION_CACHE_H_
+
+#include "node.h"
+#include "node_object_wrap.h"
+#include "v8.h"
+
+#include <openssl/ssl.h>
+#include <stdint.h>
+
+namespace node {
+namespace crypto {
+
+// External store for server sessions. A SecureContext with a cache set
+// consults it from the SSL_CTX new/get/remove session callbacks instead of
+// only handing sessions to JS.
+class SessionCache {
+ public:
+  virtual ~SessionCache() {}
+
+  // Returns a new reference, or NULL if the session is not cached.
+  virtual SSL_SESSION* Get(const unsigned char* id, unsigned int id_len) = 0;
+  virtual void Put(SSL_SESSION* sess) = 0;
+  virtual void Remove(const unsigned char* id, unsigned int id_len) = 0;
+};
+
+
+// SessionCache kept in a named POSIX shared memory segment. Every process on
+// the host that opens the same name - typically all workers of a cluster -
+// sees the same sessions.
+//
+// The segment is a set-associative table: a session id hashes to a bucket
+// of kWays slots, and a full bucket evicts its oldest entry. Buckets are
+// guarded by spinlocks that record the owner's pid, so a lock held by a
+// process that died is taken over instead of blocking everyone else. A
+// lock that cannot be taken in time turns the lookup into a miss; this is
+// a cache, never a reason to stall a handshake.
+//
+// ObjectWrap has to stay the first base, ObjectWrap::Unwrap() casts the raw
+// internal field pointer without adjusting it.
+class SharedSessionCache : ObjectWrap, public SessionCache {
+ public:
+  static void Initialize(v8::Handle<v8::Object> target);
+  static bool HasInstance(v8::Handle<v8::Value> value);
+  static SharedSessionCache* Unwrap(v8::Handle<v8::Value> value);
+
+  SSL_SESSION* Get(const unsigned char* id, unsigned int id_len);
+  void Put(SSL_SESSION* sess);
+  void Remove(const unsigned char* id, unsigned int id_len);
+
+ protected:
+  static const uint32_t kMagic = 0x6e736331;  // "nsc1"
+  static const unsigned int kWays = 4;
+  static const size_t kSlotSize = 4096;
+  static const unsigned int kMaxSpins = 1000;
+
+  struct Header {
+    uint32_t magic;
+    uint32_t bucket_count;
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t stores;
+    uint32_t evictions;
+  };
+
+  struct Bucket {
+    uint32_t lock;  // pid of the owner, 0 if unlocked
+    uint32_t clock;
+  };
+
+  struct Slot {
+    uint32_t stamp;  // 0 if empty, otherwise the bucket clock at insertion
+    uint32_t data_length;
+    uint32_t id_length;
+    unsigned char id[SSL_MAX_SSL_SESSION_ID_LENGTH];
+  };
+
+  static const size_t kMaxDataSize = kSlotSize - sizeof(Slot);
+
+  static v8::Handle<v8::Value> New(const v8::Arguments& args);
+  static v8::Handle<v8::Value> GetStats(const v8::Arguments& args);
+  static v8::Handle<v8::Value> Unlink(const v8::Arguments& args);
+
+  SharedSessionCache() : ObjectWrap(),
+                         SessionCache(),
+                         base_(NULL),
+                         size_(0),
+                         header_(NULL) {
+  }
+
+  ~SharedSessionCache();
+
+  // Returns 0 or an errno value, `syscall` names the call that failed.
+  int Open(const char* name, uint32_t sessions, const char** syscall);
+
+  Bucket* BucketFor(const unsigned char* id, unsigned int id_len);
+  Slot* SlotAt(Bucket* bucket, unsigned int way);
+  Slot* Find(Bucket* bucket, const unsigned char* id, unsigned int id_len);
+  bool Lock(Bucket* bucket);
+  void Unlock(Bucket* bucket);
+
+  char name_[256];
+  char* base_;
+  size_t size_;
+  Header* header_;
+};
+
+}  // namespace crypto
+}  // namespace node
+
+#endif  // SRC_NODE_CRYPTO_SESSION_CACHE_H_
@@ -0,0 +1,473 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "node_dir.h"
+#include "node_internals.h"
+#include "req_wrap.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+#include <stdlib.h>
+
+namespace node {
+
+using namespace v8;
+
+#define TYPE_ERROR(msg) \
+    ThrowException(Exception::TypeError(String::New(msg)));
+
+// The entry types passed to JS. lib/fs.js has the same list.
+enum DirentType {
+  kDirentUnknown,
+  kDirentFile,
+  kDirentDir,
+  kDirentLink,
+  kDirentFifo,
+  kDirentSocket,
+  kDirentChar,
+  kDirentBlock
+};
+
+Persistent<FunctionTemplate> DirHandle::constructor_template;
+static Persistent<String> oncomplete_sym;
+
+
+// The entries read from a directory, filled in on a threadpool thread and
+// turned into JS values on the main thread.
+class DirEntries {
+ public:
+  DirEntries() : entries_(NULL), count_(0), size_(0) {
+  }
+
+  ~DirEntries() {
+    for (unsigned int i = 0; i < count_; i++)
+      free(entries_[i].name);
+    free(entries_);
+  }
+
+  unsigned int count() const { return count_; }
+
+#ifndef _WIN32
+  // Reads up to `max` entries from `dir`, or all of them if `max` is 0.
+  // Returns 0 or an errno. At the end of the directory count() stays 0.
+  int Read(DIR* dir, unsigned int max) {
+    while (max == 0 || count_ < max) {
+      errno = 0;
+      struct dirent* ent = readdir(dir);
+      if (ent == NULL)
+        return errno;
+
+      const char* name = ent->d_name;
+      if (name[0] == '.' &&
+          (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+        continue;
+      }
+
+      if (!Add(name, TypeOf(ent)))
+        return ENOMEM;
+    }
+    return 0;
+  }
+#endif
+
+  // Sorts the entries by name, in the same order as fs.readdir().
+  void Sort() {
+    qsort(entries_, count_, sizeof(entries_[0]), Compare);
+  }
+
+  // Returns [names, types] where types[i] is the DirentType of names[i].
+  Local<Array> ToArray() {
+    HandleScope scope;
+    Local<Array> names = Array::New(count_);
+    Local<Array> types = Array::New(count_);
+
+    for (unsigned int i = 0; i < count_; i++) {
+      names->Set(i, String::New(entries_[i].name));
+      types->Set(i, Integer::New(entries_[i].type));
+    }
+
+    Local<Array> result = Array::New(2);
+    result->Set(0, names);
+    result->Set(1, types);
+    return scope.Close(result);
+  }
+
+ private:
+  struct Entry {
+    char* name;
+    int type;
+  };
+
+  bool Add(const char* name, int type) {
+    if (count_ == size_) {
+      unsigned int size = size_ ? 2 * size_ : 64;
+      Entry* entries =
+          static_cast<Entry*>(realloc(entries_, size * sizeof(entries_[0])));
+      if (entries == NULL)
+        return false;
+      entries_ = entries;
+      size_ = size;
+    }
+
+    char* copy = strdup(name);
+    if (copy == NULL)
+      return false;
+
+    entries_[count_].name = copy;
+    entries_[count_].type = type;
+    count_++;
+    return true;
+  }
+
+#ifndef _WIN32
+  // Not every file system fills in d_type, and some platforms (QNX) don't have
+  // it at all. lib/fs.js lstat()s the entries that come back unknown.
+  static int TypeOf(const struct dirent* ent) {
+#ifdef DT_UNKNOWN
+    switch (ent->d_type) {
+      case DT_REG: return kDirentFile;
+      case DT_DIR: return kDirentDir;
+      case DT_LNK: return kDirentLink;
+      case DT_FIFO: return kDirentFifo;
+      case DT_SOCK: return kDirentSocket;
+      case DT_CHR: return kDirentChar;
+      case DT_BLK: return kDirentBlock;
+    }
+#endif
+    return kDirentUnknown;
+  }
+#endif
+
+  static int Compare(const void* a, const void* b) {
+    return strcoll(static_cast<const Entry*>(a)->name,
+                   static_cast<const Entry*>(b)->name);
+  }
+
+  Entry* entries_;
+  unsigned int count_;
+  unsigned int size_;
+};
+
+
+// One directory operation. The sync forms call Run() directly, the async
+// forms queue it and call oncomplete(err, result) when it is done.
+class DirReqWrap: public ReqWrap<uv_work_t> {
+ public:
+  enum Op {
+    kOpen,   // opendir(), the result is a new DirHandle
+    kRead,   // up to max entries from handle, or null at the end
+    kScan,   // every entry of path, sorted
+    kClose
+  };
+
+  DirReqWrap(Op op, const char* path, DirHandle* handle, unsigned int max)
+      : op_(op),
+        path_(strdup(path)),
+        handle_(handle),
+        dir_(handle ? handle->dir_ : NULL),
+        max_(max),
+        errorno_(0) {
+    if (handle_ != NULL) {
+      handle_->busy_ = true;
+      // The directory stream belongs to the request until it is closed.
+      if (op_ == kClose)
+        handle_->dir_ = NULL;
+    }
+  }
+
+  ~DirReqWrap() {
+    if (handle_ != NULL)
+      handle_->busy_ = false;
+    free(path_);
+  }
+
+  // Runs the operation, on any thread.
+  void Run() {
+#ifdef _WIN32
+    errorno_ = ENOSYS;
+#else
+    switch (op_) {
+      case kOpen:
+        dir_ = opendir(path_);
+        if (dir_ == NULL)
+          errorno_ = errno;
+        break;
+
+      case kRead:
+        errorno_ = entries_.Read(dir_, max_);
+        break;
+
+      case kScan:
+        dir_ = opendir(path_);
+        if (dir_ == NULL) {
+          errorno_ = errno;
+          break;
+        }
+        errorno_ = entries_.Read(dir_, 0);
+        closedir(dir_);
+        if (errorno_ == 0)
+          entries_.Sort();
+        break;
+
+      case kClose:
+        if (closedir(dir_))
+          errorno_ = errno;
+        break;
+    }
+#endif
+  }
+
+  // Returns the error of the operation, or an empty handle if it succeeded.
+  Local<Value> Error() {
+    static const char* const syscalls[] = {
+      "opendir",
+      "readdir",
+      "readdir",
+      "closedir"
+    };
+    if (errorno_ == 0)
+      return Local<Value>();
+    return ErrnoException(errorno_, syscalls[op_], "", path_);
+  }
+
+  Local<Value> Result() {
+    HandleScope scope;
+
+    switch (op_) {
+      case kOpen:
+        {
+          Local<Object> obj =
+              DirHandle::constructor_template->GetFunction()->NewInstance();
+          if (obj.IsEmpty()) {
+#ifndef _WIN32
+            closedir(dir_);
+#endif
+            return scope.Close(Undefined());
+          }
+          DirHandle* handle = ObjectWrap::Unwrap<DirHandle>(obj);
+          handle->dir_ = dir_;
+          handle->path_ = strdup(path_);
+          return scope.Close(obj);
+        }
+
+      case kRead:
+        if (entries_.count() == 0)
+          return scope.Close(Null());
+        return scope.Close(entries_.ToArray());
+
+      case kScan:
+        return scope.Close(entries_.ToArray());
+
+      case kClose:
+        break;
+    }
+
+    return scope.Close(Undefined());
+  }
+
+  // Runs the operation right away if `callback` isn't a function, queues it
+  // otherwise.
+  Handle<Value> Dispatch(Handle<Value> callback) {
+    HandleScope scope;
+
+    Dispatched();
+
+    if (!callback->IsFunction()) {
+      Run();
+      Local<Value> err = Error();
+      Local<Value> result;
+      if (err.IsEmpty())
+        result = Result();
+      delete this;
+      if (!err.IsEmpty())
+        return ThrowException(err);
+      return scope.Close(result);
+    }
+
+    object_->Set(oncomplete_sym, callback);
+    if (handle_ != NULL)
+      handle_->Ref();
+    uv_queue_work_class(uv_default_loop(),
+                        &req_,
+                        UV_WORK_FS,
+                        DoWork,
+                        AfterWork);
+    return scope.Close(object_);
+  }
+
+ private:
+  static void DoWork(uv_work_t* req) {
+    DirReqWrap* wrap = static_cast<DirReqWrap*>(req->data);
+    wrap->Run();
+  }
+
+  static void AfterWork(uv_work_t* req, int status) {
+    HandleScope scope;
+
+    DirReqWrap* wrap = static_cast<DirReqWrap*>(req->data);
+    assert(status == 0);
+
+    Local<Value> argv[2];
+    argv[0] = wrap->Error();
+    if (argv[0].IsEmpty()) {
+      argv[0] = Local<Value>::New(Null());
+      argv[1] = wrap->Result();
+    } else {
+      argv[1] = Local<Value>::New(Undefined());
+    }
+
+    // Let the callback issue the next read.
+    DirHandle* handle = wrap->handle_;
+    if (handle != NULL) {
+      wrap->handle_ = NULL;
+      handle->busy_ = false;
+      handle->Unref();
+    }
+
+    MakeCallback(wrap->object_, oncomplete_sym, ARRAY_SIZE(argv), argv);
+
+    delete wrap;
+  }
+
+  Op op_;
+  char* path_;
+  DirHandle* handle_;
+  DIR* dir_;
+  unsigned int max_;
+  int errorno_;
+  DirEntries entries_;
+};
+
+
+DirHandle::DirHandle()
+  : ObjectWrap()
+  , dir_(NULL)
+  , path_(NULL)
+  , busy_(false)
+{
+}
+
+
+DirHandle::~DirHandle() {
+#ifndef _WIN32
+  if (dir_ != NULL)
+    closedir(dir_);
+#endif
+  free(path_);
+}
+
+
+Handle<Value> DirHandle::New(const Arguments& args) {
+  HandleScope scope;
+  assert(args.IsConstructCall());
+
+  DirHandle* handle = new DirHandle();
+  handle->Wrap(args.Holder());
+
+  return args.This();
+}
+
+
+// read(max[, callback]) reads up to max entries, see DirReqWrap::kRead.
+Handle<Value> DirHandle::Read(const Arguments& args) {
+  HandleScope scope;
+
+  DirHandle* handle = ObjectWrap::Unwrap<DirHandle>(args.Holder());
+
+  if (!args[0]->IsUint32() || args[0]->Uint32Value() == 0)
+    return TYPE_ERROR("count must be a positive integer");
+  if (handle->busy_)
+    return ThrowException(Exception::Error(
+        String::New("Another operation on this directory is in progress")));
+  if (handle->dir_ == NULL)
+    return ThrowException(ErrnoException(EBADF, "readdir", "", handle->path_));
+
+  DirReqWrap* wrap = new DirReqWrap(DirReqWrap::kRead,
+                                    handle->path_,
+                                    handle,
+                                    args[0]->Uint32Value());
+  return scope.Close(wrap->Dispatch(args[1]));
+}
+
+
+Handle<Value> DirHandle::Close(const Arguments& args) {
+  HandleScope scope;
+
+  DirHandle* handle = ObjectWrap::Unwrap<DirHandle>(args.Holder());
+
+  if (handle->busy_)
+    return ThrowException(Exception::Error(
+        String::New("Another operation on this directory is in progress")));
+  if (handle->dir_ == NULL)
+    return ThrowException(ErrnoException(EBADF, "closedir", "", handle->path_));
+
+  DirReqWrap* wrap = new DirReqWrap(DirReqWrap::kClose,
+                                    handle->path_,
+                                    handle,
+                                    0);
+  return scope.Close(wrap->Dispatch(args[0]));
+}
+
+
+// opendir(path[, callback])
+static Handle<Value> OpenDir(const Arguments& args) {
+  HandleScope scope;
+
+  if (!args[0]->IsString()) return TYPE_ERROR("path must be a string");
+
+  String::Utf8Value path(args[0]);
+  DirReqWrap* wrap = new DirReqWrap(DirReqWrap::kOpen, *path, NULL, 0);
+  return scope.Close(wrap->Dispatch(args[1]));
+}
+
+
+// readdirTypes(path[, callback]) is readdir() plus the type of each entry,
+// as [names, types].
+static Handle<Value> ReadDirTypes(const Arguments& args) {
+  HandleScope scope;
+
+  if (!args[0]->IsString()) return TYPE_ERROR("path must be a string");
+
+  String::Utf8Value path(args[0]);
+  DirReqWrap* wrap = new DirReqWrap(DirReqWrap::kScan, *path, NULL, 0);
+  return scope.Close(wrap->Dispatch(args[1]));
+}
+
+
+void DirHandle::Initialize(Handle<Object> target) {
+  HandleScope scope;
+
+  Local<FunctionTemplate> t = FunctionTemplate::New(DirHandle::New);
+  constructor_template = Persistent<FunctionTemplate>::New(t);
+  constructor_template->InstanceTemplate()->SetInternalFieldCount(1);
+  constructor_template->SetClassName(String::NewSymbol("DirHandle"));
+
+  NODE_SET_PROTOTYPE_METHOD(constructor_template, "read", DirHandle::Read);
+  NODE_SET_PROTOTYPE_METHOD(constructor_template, "close", DirHandle::Close);
+
+  NODE_SET_METHOD(target, "opendir", OpenDir);
+  NODE_SET_METHOD(target, "readdirTypes", ReadDirTypes);
+
+  oncomplete_sym = NODE_PSYMBOL("oncomplete");
+}
+
+}  // namespace node
@@ -22,13 +22,16 @@
 
 NODE_EXT_LIST_START
 NODE_EXT_LIST_ITEM(node_buffer)
+NODE_EXT_LIST_ITEM(node_buffer_pool)
 #if HAVE_OPENSSL
 NODE_EXT_LIST_ITEM(node_crypto)
+NODE_EXT_LIST_ITEM(node_tls_wrap)
 #endif
 NODE_EXT_LIST_ITEM(node_evals)
 NODE_EXT_LIST_ITEM(node_fs)
 NODE_EXT_LIST_ITEM(node_http_parser)
 NODE_EXT_LIST_ITEM(node_os)
+NODE_EXT_LIST_ITEM(node_threadpool)
 NODE_EXT_LIST_ITEM(node_zlib)
 
 // libuv rewrite
@@ -22,6 +22,8 @@
 #include "node.h"
 #include "node_file.h"
 #include "node_buffer.h"
+#include "node_dir.h"
+#include "node_internals.h"
 #include "node_stat_watcher.h"
 #include "req_wrap.h"
 
@@ -35,6 +37,9 @@
 
 #if defined(__MINGW32__) || defined(_MSC_VER)
 # include <io.h>
+#else
+# include <sys/mman.h>
+# include <unistd.h>
 #endif
 
 namespace node {
@@ -62,6 +67,7 @@ class FSReqWrap: public ReqWrap<uv_fs_t> {
 
 
 static Persistent<String> oncomplete_sym;
+static Persistent<String> stat_values_sym;
 
 
 #define ASSERT_OFFSET(a) \
@@ -80,6 +86,64 @@ static inline int IsInt64(double x) {
 }
 
 
+// Layout of one stat record in the Float64Array that stat() and statMany()
+// fill in.
+enum StatField {
+  kStatDev,
+  kStatIno,
+  kStatMode,
+  kStatNlink,
+  kStatUid,
+  kStatGid,
+  kStatRdev,
+  kStatSize,
+  kStatBlksize,
+  kStatBlocks,
+  kStatAtime,
+  kStatMtime,
+  kStatCtime,
+  kStatFieldCount
+};
+
+
+static void FillStatsArray(double* fields, const uv_statbuf_t* s) {
+  fields[kStatDev] = static_cast<double>(s->st_dev);
+  fields[kStatIno] = static_cast<double>(s->st_ino);
+  fields[kStatMode] = static_cast<double>(s->st_mode);
+  fields[kStatNlink] = static_cast<double>(s->st_nlink);
+  fields[kStatUid] = static_cast<double>(s->st_uid);
+  fields[kStatGid] = static_cast<double>(s->st_gid);
+  fields[kStatRdev] = static_cast<double>(s->st_rdev);
+  fields[kStatSize] = static_cast<double>(s->st_size);
+# if defined(__POSIX__)
+  fields[kStatBlksize] = static_cast<double>(s->st_blksize);
+  fields[kStatBlocks] = static_cast<double>(s->st_blocks);
+# else
+  fields[kStatBlksize] = 0;
+  fields[kStatBlocks] = 0;
+# endif
+  // Milliseconds, like the Dates in a Stats object.
+  fields[kStatAtime] = 1000 * static_cast<double>(s->st_atime);
+  fields[kStatMtime] = 1000 * static_cast<double>(s->st_mtime);
+  fields[kStatCtime] = 1000 * static_cast<double>(s->st_ctime);
+}
+
+
+// Returns the data of `value` if it is a Float64Array with room for one stat
+// record, NULL otherwise.
+static double* StatValuesData(Handle<Value> value) {
+  if (!value->IsObject()) return NULL;
+  Local<Object> values = value->ToObject();
+  if (values->GetIndexedPropertiesExternalArrayDataType() !=
+          kExternalDoubleArray ||
+      values->GetIndexedPropertiesExternalArrayDataLength() < kStatFieldCount) {
+    return NULL;
+  }
+  return static_cast<double*>(
+      values->GetIndexedPropertiesExternalArrayData());
+}
+
+
 static void After(uv_fs_t *req) {
   HandleScope scope;
 
@@ -151,7 +215,17 @@ static void After(uv_fs_t *req) {
       case UV_FS_STAT:
       case UV_FS_LSTAT:
       case UV_FS_FSTAT:
-        argv[1] = BuildStatsObject(static_cast<const uv_statbuf_t*>(req->ptr));
+        {
+          const uv_statbuf_t* s = static_cast<const uv_statbuf_t*>(req->ptr);
+          Local<Value> values =
+              req_wrap->object_->GetHiddenValue(stat_values_sym);
+          if (values.IsEmpty()) {
+            argv[1] = BuildStatsObject(s);
+          } else {
+            FillStatsArray(StatValuesData(values), s);
+            argv[1] = values;
+          }
+        }
         break;
 
       case UV_FS_READLINK:
@@ -213,10 +287,17 @@ struct fs_req_wrap {
 
 
 #define ASYNC_CALL(func, callback, ...)                           \
+  ASYNC_STAT_CALL(func, callback, Local<Object>(), __VA_ARGS__)
+
+// Like ASYNC_CALL but After() fills in `values`, a Float64Array, instead of
+// creating a Stats object if `values` is not empty.
+#define ASYNC_STAT_CALL(func, callback, values, ...)              \
   FSReqWrap* req_wrap = new FSReqWrap(#func);                     \
   int r = uv_fs_##func(uv_default_loop(), &req_wrap->req_,        \
       __VA_ARGS__, After);                                        \
   req_wrap->object_->Set(oncomplete_sym, callback);               \
+  if (!(values).IsEmpty())                                        \
+    req_wrap->object_->SetHiddenValue(stat_values_sym, values);   \
   req_wrap->Dispatched();                                         \
   if (r < 0) {                                                    \
     uv_fs_t* req = &req_wrap->req_;                               \
@@ -270,9 +351,9 @@ static Persistent<String> rdev_symbol;
 static Persistent<String> size_symbol;
 static Persistent<String> blksize_symbol;
 static Persistent<String> blocks_symbol;
-static Persistent<String> atime_symbol;
-static Persistent<String> mtime_symbol;
-static Persistent<String> ctime_symbol;
+static Persistent<String> atime_ms_symbol;
+static Persistent<String> mtime_ms_symbol;
+static Persistent<String> ctime_ms_symbol;
 
 Local<Object> BuildStatsObject(const uv_statbuf_t* s) {
   HandleScope scope;
@@ -288,9 +369,9 @@ Local<Object> BuildStatsObject(const uv_statbuf_t* s) {
     size_symbol = NODE_PSYMBOL("size");
     blksize_symbol = NODE_PSYMBOL("blksize");
     blocks_symbol = NODE_PSYMBOL("blocks");
-    atime_symbol = NODE_PSYMBOL("atime");
-    mtime_symbol = NODE_PSYMBOL("mtime");
-    ctime_symbol = NODE_PSYMBOL("ctime");
+    atime_ms_symbol = NODE_PSYMBOL("_atime");
+    mtime_ms_symbol = NODE_PSYMBOL("_mtime");
+    ctime_ms_symbol = NODE_PSYMBOL("_ctime");
   }
 
   Local<Object> stats =
@@ -339,11 +420,13 @@ Local<Object> BuildStatsObject(const uv_statbuf_t* s) {
 # endif
 #undef X
 
+  // The times are stored in milliseconds. The atime, mtime and ctime
+  // accessors (see GetStatsTime) turn them into Dates on first use.
 #define X(name)                                                               \
   {                                                                           \
-    Local<Value> val = NODE_UNIXTIME_V8(s->st_##name);                        \
+    Local<Value> val = Number::New(1000 * static_cast<double>(s->st_##name)); \
     if (val.IsEmpty()) return Local<Object>();                                \
-    stats->Set(name##_symbol, val);                                           \
+    stats->ForceSet(name##_ms_symbol, val, DontEnum);                         \
   }
   X(atime)
   X(mtime)
@@ -353,6 +436,219 @@ Local<Object> BuildStatsObject(const uv_statbuf_t* s) {
   return scope.Close(stats);
 }
 
+// Getter for the atime, mtime and ctime properties of a Stats object. The
+// Date is only created when the property is first read and then replaces the
+// accessor, so stats.mtime === stats.mtime.
+static Handle<Value> GetStatsTime(Local<String> property,
+                                  const AccessorInfo& info) {
+  HandleScope scope;
+  Local<Value> ms = info.This()->Get(info.Data());
+  if (!ms->IsNumber()) return Undefined();
+  Local<Value> date = Date::New(ms->NumberValue());
+  if (date.IsEmpty()) return Undefined();
+  info.This()->ForceSet(property, date);
+  return scope.Close(date);
+}
+
+static void SetStatsTime(Local<String> property,
+                         Local<Value> value,
+                         const AccessorInfo& info) {
+  info.This()->ForceSet(property, value);
+}
+
+// statMany() splits its paths over at most this many threadpool jobs...
+static const unsigned int kStatManyMaxJobs = 4;
+// ...and doesn't bother with another job for fewer paths than this.
+static const unsigned int kStatManyMinBatch = 64;
+
+
+class StatManyWrap: public ReqWrap<uv_work_t> {
+ public:
+  struct Job {
+    uv_work_t req;
+    StatManyWrap* wrap;
+    unsigned int begin;
+    unsigned int end;
+  };
+
+  StatManyWrap(Handle<Array> paths, bool lstat, Handle<Object> data)
+      : count_(paths->Length()),
+        lstat_(lstat),
+        pending_(0),
+        data_(Persistent<Object>::New(data)) {
+    fields_ = static_cast<double*>(
+        data->GetIndexedPropertiesExternalArrayData());
+    errors_ = new int[count_];
+    paths_ = new char*[count_];
+    for (unsigned int i = 0; i < count_; i++) {
+      String::Utf8Value path(paths->Get(i));
+      paths_[i] = strdup(*path);
+    }
+  }
+
+  ~StatManyWrap() {
+    for (unsigned int i = 0; i < count_; i++)
+      free(paths_[i]);
+    delete[] paths_;
+    delete[] errors_;
+    data_.Dispose();
+    data_.Clear();
+  }
+
+  // Runs the stats of paths [begin, end), on any thread.
+  void Run(unsigned int begin, unsigned int end) {
+    for (unsigned int i = begin; i < end; i++) {
+      uv_statbuf_t s;
+      int r;
+#ifdef _WIN32
+      r = _stati64(paths_[i], &s);
+#else
+      if (lstat_)
+        r = lstat(paths_[i], &s);
+      else
+        r = stat(paths_[i], &s);
+#endif
+      double* fields = fields_ + i * kStatFieldCount;
+      if (r == 0) {
+        errors_[i] = 0;
+        FillStatsArray(fields, &s);
+      } else {
+        errors_[i] = errno;
+        for (int j = 0; j < kStatFieldCount; j++)
+          fields[j] = 0;
+      }
+    }
+  }
+
+  // null when every path could be stat'ed, otherwise an array with the
+  // error for each path that couldn't.
+  Local<Value> Errors() {
+    HandleScope scope;
+    Local<Array> errors;
+
+    for (unsigned int i = 0; i < count_; i++) {
+      if (errors_[i] == 0)
+        continue;
+      if (errors.IsEmpty())
+        errors = Array::New(count_);
+      errors->Set(i, ErrnoException(errors_[i],
+                                    lstat_ ? "lstat" : "stat",
+                                    "",
+                                    paths_[i]));
+    }
+
+    if (errors.IsEmpty())
+      return scope.Close(Null());
+    return scope.Close(errors);
+  }
+
+  void Queue() {
+    unsigned int njobs = (count_ + kStatManyMinBatch - 1) / kStatManyMinBatch;
+    if (njobs > kStatManyMaxJobs)
+      njobs = kStatManyMaxJobs;
+    if (njobs == 0)
+      njobs = 1;
+
+    jobs_ = new Job[njobs];
+    pending_ = njobs;
+
+    for (unsigned int i = 0; i < njobs; i++) {
+      jobs_[i].wrap = this;
+      jobs_[i].begin = count_ * i / njobs;
+      jobs_[i].end = count_ * (i + 1) / njobs;
+      uv_queue_work_class(uv_default_loop(),
+                          &jobs_[i].req,
+                          UV_WORK_FS,
+                          DoWork,
+                          AfterWork);
+    }
+  }
+
+  static void DoWork(uv_work_t* req) {
+    Job* job = container_of(req, Job, req);
+    job->wrap->Run(job->begin, job->end);
+  }
+
+  static void AfterWork(uv_work_t* req, int status) {
+    HandleScope scope;
+
+    Job* job = container_of(req, Job, req);
+    StatManyWrap* wrap = job->wrap;
+    assert(status == 0);
+
+    if (--wrap->pending_ > 0)
+      return;
+
+    delete[] wrap->jobs_;
+
+    Local<Value> argv[2] = {
+      Local<Value>::New(Null()),
+      wrap->Errors()
+    };
+
+    MakeCallback(wrap->object_, oncomplete_sym, ARRAY_SIZE(argv), argv);
+
+    delete wrap;
+  }
+
+ private:
+  unsigned int count_;
+  bool lstat_;
+  unsigned int pending_;
+  Job* jobs_;
+  char** paths_;
+  int* errors_;
+  double* fields_;
+  Persistent<Object> data_;
+};
+
+
+// statMany(paths, lstat, data[, callback]) stats every path in `paths` and
+// stores the results in `data`, a Float64Array with room for kStatFieldCount
+// values per path. The async form runs in a few threadpool jobs and calls
+// back with (null, errors), the sync form returns errors; see Errors().
+static Handle<Value> StatMany(const Arguments& args) {
+  HandleScope scope;
+
+  if (!args[0]->IsArray()) return TYPE_ERROR("paths must be an array");
+
+  Local<Array> paths = Local<Array>::Cast(args[0]);
+  bool lstat = args[1]->IsTrue();
+  unsigned int count = paths->Length();
+
+  for (unsigned int i = 0; i < count; i++) {
+    if (!paths->Get(i)->IsString())
+      return TYPE_ERROR("path must be a string");
+  }
+
+  if (!args[2]->IsObject()) return TYPE_ERROR("data must be a Float64Array");
+  Local<Object> data = args[2]->ToObject();
+  if (data->GetIndexedPropertiesExternalArrayDataType() !=
+          kExternalDoubleArray ||
+      static_cast<unsigned int>(
+          data->GetIndexedPropertiesExternalArrayDataLength()) <
+          count * kStatFieldCount) {
+    return TYPE_ERROR("data must be a Float64Array");
+  }
+
+  StatManyWrap* wrap = new StatManyWrap(paths, lstat, data);
+
+  if (!args[3]->IsFunction()) {
+    wrap->Dispatched();
+    wrap->Run(0, count);
+    Local<Value> errors = wrap->Errors();
+    delete wrap;
+    return scope.Close(errors);
+  }
+
+  wrap->object_->Set(oncomplete_sym, args[3]);
+  wrap->Dispatched();
+  wrap->Queue();
+
+  return scope.Close(wrap->object_);
+}
+
+
 static Handle<Value> Stat(const Arguments& args) {
   HandleScope scope;
 
@@ -361,12 +657,22 @@ static Handle<Value> Stat(const Arguments& args) {
 
   String::Utf8Value path(args[0]);
 
-  if (args[1]->IsFunction()) {
-    ASYNC_CALL(stat, args[1], *path)
+  // An optional Float64Array to fill in instead of returning a Stats object.
+  Local<Object> values;
+  int cb = 1;
+  if (StatValuesData(args[1]) != NULL) {
+    values = args[1]->ToObject();
+    cb = 2;
+  }
+
+  if (args[cb]->IsFunction()) {
+    ASYNC_STAT_CALL(stat, args[cb], values, *path)
   } else {
     SYNC_CALL(stat, *path, *path)
-    return scope.Close(
-        BuildStatsObject(static_cast<const uv_statbuf_t*>(SYNC_REQ.ptr)));
+    const uv_statbuf_t* s = static_cast<const uv_statbuf_t*>(SYNC_REQ.ptr);
+    if (values.IsEmpty()) return scope.Close(BuildStatsObject(s));
+    FillStatsArray(StatValuesData(values), s);
+    return scope.Close(values);
   }
 }
 
@@ -378,12 +684,21 @@ static Handle<Value> LStat(const Arguments& args) {
 
   String::Utf8Value path(args[0]);
 
-  if (args[1]->IsFunction()) {
-    ASYNC_CALL(lstat, args[1], *path)
+  Local<Object> values;
+  int cb = 1;
+  if (StatValuesData(args[1]) != NULL) {
+    values = args[1]->ToObject();
+    cb = 2;
+  }
+
+  if (args[cb]->IsFunction()) {
+    ASYNC_STAT_CALL(lstat, args[cb], values, *path)
   } else {
     SYNC_CALL(lstat, *path, *path)
-    return scope.Close(
-        BuildStatsObject(static_cast<const uv_statbuf_t*>(SYNC_REQ.ptr)));
+    const uv_statbuf_t* s = static_cast<const uv_statbuf_t*>(SYNC_REQ.ptr);
+    if (values.IsEmpty()) return scope.Close(BuildStatsObject(s));
+    FillStatsArray(StatValuesData(values), s);
+    return scope.Close(values);
   }
 }
 
@@ -396,12 +711,21 @@ static Handle<Value> FStat(const Arguments& args) {
 
   int fd = args[0]->Int32Value();
 
-  if (args[1]->IsFunction()) {
-    ASYNC_CALL(fstat, args[1], fd)
+  Local<Object> values;
+  int cb = 1;
+  if (StatValuesData(args[1]) != NULL) {
+    values = args[1]->ToObject();
+    cb = 2;
+  }
+
+  if (args[cb]->IsFunction()) {
+    ASYNC_STAT_CALL(fstat, args[cb], values, fd)
   } else {
     SYNC_CALL(fstat, 0, fd)
-    return scope.Close(
-        BuildStatsObject(static_cast<const uv_statbuf_t*>(SYNC_REQ.ptr)));
+    const uv_statbuf_t* s = static_cast<const uv_statbuf_t*>(SYNC_REQ.ptr);
+    if (values.IsEmpty()) return scope.Close(BuildStatsObject(s));
+    FillStatsArray(StatValuesData(values), s);
+    return scope.Close(values);
   }
 }
 
@@ -772,6 +1096,408 @@ static Handle<Value> Read(const Arguments& args) {
   }
 }
 
+#ifndef _WIN32
+// readFile() and writeFile() run the whole open, read or write, close
+// sequence of fs.readFile() and fs.writeFile() in a single threadpool job.
+class FileWrap: public ReqWrap<uv_work_t> {
+ public:
+  // For readFile().
+  FileWrap(const char* path, int flags, int mode)
+      : path_(strdup(path)),
+        flags_(flags),
+        mode_(mode),
+        data_(NULL),
+        length_(0),
+        errorno_(0),
+        syscall_(NULL) {
+  }
+
+  // For writeFile(), `buffer` is kept alive until the job is done.
+  FileWrap(const char* path, int flags, int mode, Handle<Object> buffer)
+      : path_(strdup(path)),
+        flags_(flags),
+        mode_(mode),
+        buffer_(Persistent<Object>::New(buffer)),
+        data_(Buffer::Data(buffer)),
+        length_(Buffer::Length(buffer)),
+        errorno_(0),
+        syscall_(NULL) {
+  }
+
+  ~FileWrap() {
+    // The data that was read, unless a Buffer took it over.
+    if (buffer_.IsEmpty()) {
+      free(data_);
+    } else {
+      buffer_.Dispose();
+      buffer_.Clear();
+    }
+    free(path_);
+  }
+
+  // Runs the job, on any thread.
+  void Run() {
+    int fd;
+    do
+      fd = open(path_, flags_, mode_);
+    while (fd == -1 && errno == EINTR);
+
+    if (fd == -1) {
+      Fail("open");
+      return;
+    }
+
+    if (buffer_.IsEmpty())
+      ReadAll(fd);
+    else
+      WriteAll(fd);
+
+    if (close(fd) && errorno_ == 0)
+      Fail("close");
+  }
+
+  // Returns the error of the job, or an empty handle if it succeeded.
+  Local<Value> Error() {
+    if (errorno_ == 0)
+      return Local<Value>();
+    return ErrnoException(errorno_, syscall_, "", path_);
+  }
+
+  // The Buffer with the file contents for readFile(), undefined otherwise.
+  Local<Value> Result() {
+    HandleScope scope;
+    if (!buffer_.IsEmpty())
+      return scope.Close(Undefined());
+    // Buffer::New() only reports memory it allocates itself to V8.
+    V8::AdjustAmountOfExternalAllocatedMemory(length_);
+    Buffer* buffer = Buffer::New(data_,
+                                 length_,
+                                 FreeData,
+                                 reinterpret_cast<void*>(length_));
+    data_ = NULL;
+    return scope.Close(buffer->handle_);
+  }
+
+  // Runs the job right away if `callback` isn't a function, queues it
+  // otherwise.
+  Handle<Value> Dispatch(Handle<Value> callback) {
+    HandleScope scope;
+
+    Dispatched();
+
+    if (!callback->IsFunction()) {
+      Run();
+      Local<Value> err = Error();
+      Local<Value> result;
+      if (err.IsEmpty())
+        result = Result();
+      delete this;
+      if (!err.IsEmpty())
+        return ThrowException(err);
+      return scope.Close(result);
+    }
+
+    object_->Set(oncomplete_sym, callback);
+    uv_queue_work_class(uv_default_loop(),
+                        &req_,
+                        UV_WORK_FS,
+                        DoWork,
+                        AfterWork);
+    return scope.Close(object_);
+  }
+
+ private:
+  void Fail(const char* syscall) {
+    errorno_ = errno;
+    syscall_ = syscall;
+  }
+
+  // Reads until EOF, like fs.readFile() did with one fs.read() at a time.
+  // Files that report a size of zero (the kernel lies about many files, see
+  // /proc) are read in growing chunks.
+  void ReadAll(int fd) {
+    struct stat s;
+    if (fstat(fd, &s)) {
+      Fail("fstat");
+      return;
+    }
+
+    if (static_cast<uint64_t>(s.st_size) > Buffer::kMaxLength) {
+      errno = EFBIG;
+      Fail("read");
+      return;
+    }
+
+    size_t size = s.st_size;
+    size_t capacity = size ? size : 8192;
+    data_ = static_cast<char*>(malloc(capacity));
+    if (data_ == NULL) {
+      errno = ENOMEM;
+      Fail("read");
+      return;
+    }
+
+    for (;;) {
+      if (length_ == capacity) {
+        if (size != 0)
+          break;
+        if (capacity == Buffer::kMaxLength) {
+          errno = EFBIG;
+          Fail("read");
+          return;
+        }
+        capacity = MIN(2 * capacity, Buffer::kMaxLength);
+        char* data = static_cast<char*>(realloc(data_, capacity));
+        if (data == NULL) {
+          errno = ENOMEM;
+          Fail("read");
+          return;
+        }
+        data_ = data;
+      }
+
+      ssize_t n = read(fd, data_ + length_, capacity - length_);
+      if (n == -1 && errno == EINTR)
+        continue;
+      if (n == -1) {
+        Fail("read");
+        return;
+      }
+      if (n == 0)
+        break;
+      length_ += n;
+    }
+  }
+
+  // Writes at the start of the file, or at the end for O_APPEND.
+  void WriteAll(int fd) {
+    size_t written = 0;
+
+    while (written < length_) {
+      ssize_t n;
+      if (flags_ & O_APPEND)
+        n = write(fd, data_ + written, length_ - written);
+      else
+        n = pwrite(fd, data_ + written, length_ - written, written);
+      if (n == -1 && errno == EINTR)
+        continue;
+      if (n == -1) {
+        Fail("write");
+        return;
+      }
+      written += n;
+    }
+  }
+
+  // `hint` is the length of the data.
+  static void FreeData(char* data, void* hint) {
+    V8::AdjustAmountOfExternalAllocatedMemory(
+        -reinterpret_cast<intptr_t>(hint));
+    free(data);
+  }
+
+  static void DoWork(uv_work_t* req) {
+    FileWrap* wrap = static_cast<FileWrap*>(req->data);
+    wrap->Run();
+  }
+
+  static void AfterWork(uv_work_t* req, int status) {
+    HandleScope scope;
+
+    FileWrap* wrap = static_cast<FileWrap*>(req->data);
+    assert(status == 0);
+
+    Local<Value> argv[2];
+    argv[0] = wrap->Error();
+    if (argv[0].IsEmpty()) {
+      argv[0] = Local<Value>::New(Null());
+      argv[1] = wrap->Result();
+    } else {
+      argv[1] = Local<Value>::New(Undefined());
+    }
+
+    MakeCallback(wrap->object_, oncomplete_sym, ARRAY_SIZE(argv), argv);
+
+    delete wrap;
+  }
+
+  char* path_;
+  int flags_;
+  int mode_;
+  Persistent<Object> buffer_;
+  char* data_;
+  size_t length_;
+  int errorno_;
+  const char* syscall_;
+};
+
+
+// buffer = readFile(path, flags, mode[, callback])
+static Handle<Value> ReadFile(const Arguments& args) {
+  HandleScope scope;
+
+  if (!args[0]->IsString()) return TYPE_ERROR("path must be a string");
+  if (!args[1]->IsInt32()) return TYPE_ERROR("flags must be an int");
+  if (!args[2]->IsInt32()) return TYPE_ERROR("mode must be an int");
+
+  String::Utf8Value path(args[0]);
+  FileWrap* wrap = new FileWrap(*path,
+                                args[1]->Int32Value(),
+                                args[2]->Int32Value());
+  return scope.Close(wrap->Dispatch(args[3]));
+}
+
+
+// writeFile(path, buffer, flags, mode[, callback])
+static Handle<Value> WriteFile(const Arguments& args) {
+  HandleScope scope;
+
+  if (!args[0]->IsString()) return TYPE_ERROR("path must be a string");
+  if (!Buffer::HasInstance(args[1])) return TYPE_ERROR("data must be a buffer");
+  if (!args[2]->IsInt32()) return TYPE_ERROR("flags must be an int");
+  if (!args[3]->IsInt32()) return TYPE_ERROR("mode must be an int");
+
+  String::Utf8Value path(args[0]);
+  FileWrap* wrap = new FileWrap(*path,
+                                args[2]->Int32Value(),
+                                args[3]->Int32Value(),
+                                args[1]->ToObject());
+  return scope.Close(wrap->Dispatch(args[4]));
+}
+
+// The region behind a Buffer from mmap(). It is unmapped when the Buffer is
+// garbage collected.
+struct Mapping {
+  char* addr;
+  size_t length;
+  int prot;
+};
+
+static Persistent<String> mapping_sym;
+
+static void Unmap(char* data, void* hint) {
+  Mapping* mapping = static_cast<Mapping*>(hint);
+  munmap(mapping->addr, mapping->length);
+  delete mapping;
+}
+
+// Returns the Mapping of a SlowBuffer from mmap(), NULL for other values.
+static Mapping* GetMapping(Handle<Value> value) {
+  if (!Buffer::HasInstance(value)) return NULL;
+  Local<Value> mapping = value->ToObject()->GetHiddenValue(mapping_sym);
+  if (mapping.IsEmpty()) return NULL;
+  return static_cast<Mapping*>(External::Unwrap(mapping));
+}
+
+static size_t PageSize() {
+  static size_t page_size = sysconf(_SC_PAGESIZE);
+  return page_size;
+}
+
+
+// buffer = mmap(fd, offset, length, prot) maps the file shared, so processes
+// that map the same file use the same pages of the page cache.
+static Handle<Value> Mmap(const Arguments& args) {
+  HandleScope scope;
+
+  if (!args[0]->IsInt32()) return TYPE_ERROR("fd must be an int");
+  if (!args[1]->IsNumber() || !IsInt64(args[1]->NumberValue()) ||
+      args[1]->IntegerValue() < 0) {
+    return TYPE_ERROR("offset must be a non-negative integer");
+  }
+  if (!args[2]->IsUint32() || args[2]->Uint32Value() == 0 ||
+      args[2]->Uint32Value() > Buffer::kMaxLength) {
+    return ThrowException(Exception::RangeError(
+        String::New("length must be between 1 and kMaxLength")));
+  }
+  if (!args[3]->IsInt32()) return TYPE_ERROR("prot must be an int");
+
+  int fd = args[0]->Int32Value();
+  int64_t offset = args[1]->IntegerValue();
+  size_t length = args[2]->Uint32Value();
+  int prot = args[3]->Int32Value();
+
+  // mmap() happily maps pages past the end of a regular file, but touching
+  // them raises SIGBUS, so refuse that up front. Devices have no size.
+  struct stat s;
+  if (fstat(fd, &s))
+    return ThrowException(ErrnoException(errno, "fstat"));
+  if (S_ISREG(s.st_mode) &&
+      (offset > s.st_size ||
+       static_cast<int64_t>(length) > s.st_size - offset)) {
+    return ThrowException(Exception::RangeError(
+        String::New("offset + length extends beyond the end of the file")));
+  }
+
+  // The offset that mmap() takes has to be a multiple of the page size.
+  size_t skew = offset % PageSize();
+  void* addr = mmap(NULL, skew + length, prot, MAP_SHARED, fd, offset - skew);
+  if (addr == MAP_FAILED)
+    return ThrowException(ErrnoException(errno, "mmap"));
+
+  Mapping* mapping = new Mapping;
+  mapping->addr = static_cast<char*>(addr);
+  mapping->length = skew + length;
+  mapping->prot = prot;
+
+  Buffer* buffer = Buffer::New(mapping->addr + skew, length, Unmap, mapping);
+  buffer->handle_->SetHiddenValue(mapping_sym, External::Wrap(mapping));
+  return scope.Close(buffer->handle_);
+}
+
+
+// munmap(buffer) releases the mapping of a buffer from mmap() right away.
+// The address range stays reserved with zero pages until the buffer is
+// garbage collected, so code that still uses the buffer reads zeros instead
+// of crashing.
+static Handle<Value> Munmap(const Arguments& args) {
+  HandleScope scope;
+
+  Mapping* mapping = GetMapping(args[0]);
+  if (mapping == NULL) return TYPE_ERROR("buffer is not memory-mapped");
+
+  void* addr = mmap(mapping->addr,
+                    mapping->length,
+                    mapping->prot,
+                    MAP_FIXED | MAP_PRIVATE | MAP_ANON,
+                    -1,
+                    0);
+  if (addr == MAP_FAILED)
+    return ThrowException(ErrnoException(errno, "munmap"));
+
+  return Undefined();
+}
+
+
+// madvise(buffer, offset, length, advice) for the pages that hold bytes
+// [offset, offset + length) of a buffer from mmap().
+static Handle<Value> Madvise(const Arguments& args) {
+  HandleScope scope;
+
+  if (GetMapping(args[0]) == NULL)
+    return TYPE_ERROR("buffer is not memory-mapped");
+  if (!args[1]->IsUint32()) return TYPE_ERROR("offset must be an int");
+  if (!args[2]->IsUint32()) return TYPE_ERROR("length must be an int");
+  if (!args[3]->IsInt32()) return TYPE_ERROR("advice must be an int");
+
+  size_t offset = args[1]->Uint32Value();
+  size_t length = args[2]->Uint32Value();
+  if (offset + length > Buffer::Length(args[0]))
+    return ThrowException(Exception::RangeError(
+        String::New("offset + length extends beyond buffer")));
+
+  char* start = Buffer::Data(args[0]) + offset;
+  char* end = start + length;
+  uintptr_t skew = reinterpret_cast<uintptr_t>(start) % PageSize();
+  start -= skew;
+
+  if (madvise(start, end - start, args[3]->Int32Value()))
+    return ThrowException(ErrnoException(errno, "madvise"));
+
+  return Undefined();
+}
+#endif  // !_WIN32
+
 
 /* fs.chmod(path, mode);
  * Wrapper for chmod(1) / EIO_CHMOD
@@ -932,11 +1658,19 @@ void File::Initialize(Handle<Object> target) {
   NODE_SET_METHOD(target, "stat", Stat);
   NODE_SET_METHOD(target, "lstat", LStat);
   NODE_SET_METHOD(target, "fstat", FStat);
+  NODE_SET_METHOD(target, "statMany", StatMany);
   NODE_SET_METHOD(target, "link", Link);
   NODE_SET_METHOD(target, "symlink", Symlink);
   NODE_SET_METHOD(target, "readlink", ReadLink);
   NODE_SET_METHOD(target, "unlink", Unlink);
   NODE_SET_METHOD(target, "write", Write);
+#ifndef _WIN32
+  NODE_SET_METHOD(target, "readFile", ReadFile);
+  NODE_SET_METHOD(target, "writeFile", WriteFile);
+  NODE_SET_METHOD(target, "mmap", Mmap);
+  NODE_SET_METHOD(target, "munmap", Munmap);
+  NODE_SET_METHOD(target, "madvise", Madvise);
+#endif
 
   NODE_SET_METHOD(target, "chmod", Chmod);
   NODE_SET_METHOD(target, "fchmod", FChmod);
@@ -954,14 +1688,26 @@ void InitFs(Handle<Object> target) {
   HandleScope scope;
   // Initialize the stats object
   Local<FunctionTemplate> stat_templ = FunctionTemplate::New();
+  Local<ObjectTemplate> stat_inst = stat_templ->InstanceTemplate();
+  stat_inst->SetAccessor(String::NewSymbol("atime"), GetStatsTime,
+                         SetStatsTime, String::NewSymbol("_atime"));
+  stat_inst->SetAccessor(String::NewSymbol("mtime"), GetStatsTime,
+                         SetStatsTime, String::NewSymbol("_mtime"));
+  stat_inst->SetAccessor(String::NewSymbol("ctime"), GetStatsTime,
+                         SetStatsTime, String::NewSymbol("_ctime"));
   stats_constructor_template = Persistent<FunctionTemplate>::New(stat_templ);
   target->Set(String::NewSymbol("Stats"),
                stats_constructor_template->GetFunction());
   File::Initialize(target);
 
   oncomplete_sym = NODE_PSYMBOL("oncomplete");
+  stat_values_sym = NODE_PSYMBOL("statValues");
+#ifndef _WIN32
+  mapping_sym = NODE_PSYMBOL("mapping");
+#endif
 
   StatWatcher::Initialize(target);
+  DirHandle::Initialize(target);
 }
 
 }  // end namespace node
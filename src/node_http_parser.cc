@@ -27,9 +27,10 @@
 
 #include <string.h>  /* strdup() */
 #if !defined(_MSC_VER)
-#include <strings.h>  /* strcasecmp() */
+#include <strings.h>  /* strcasecmp(), strncasecmp() */
 #else
 #define strcasecmp _stricmp
+#define strncasecmp _strnicmp
 #endif
 #include <stdlib.h>  /* free() */
 
@@ -63,6 +64,10 @@ static Persistent<String> should_keep_alive_sym;
 static Persistent<String> upgrade_sym;
 static Persistent<String> headers_sym;
 static Persistent<String> url_sym;
+static Persistent<String> body_sym;
+static Persistent<String> trailers_sym;
+static Persistent<String> complete_sym;
+static Persistent<String> continued_sym;
 
 static Persistent<String> unknown_method_sym;
 
@@ -108,59 +113,192 @@ method_to_str(unsigned short m) {
 }
 
 
-// helper class for the Parser
-struct StringPtr {
-  StringPtr() {
-    on_heap_ = false;
+// Header names that show up in nearly every message. Each one is created
+// once, in its canonical and its all lowercase spelling, and shared by all
+// parsers instead of allocating a new String per header line.
+static const char* const interned_header_names[] = {
+  "Accept",
+  "Accept-Charset",
+  "Accept-Encoding",
+  "Accept-Language",
+  "Authorization",
+  "Cache-Control",
+  "Connection",
+  "Content-Encoding",
+  "Content-Length",
+  "Content-Type",
+  "Cookie",
+  "Date",
+  "ETag",
+  "Expect",
+  "Host",
+  "If-Modified-Since",
+  "If-None-Match",
+  "Keep-Alive",
+  "Last-Modified",
+  "Location",
+  "Origin",
+  "Pragma",
+  "Referer",
+  "Server",
+  "Set-Cookie",
+  "Transfer-Encoding",
+  "Upgrade",
+  "User-Agent",
+  "Vary",
+  "X-Forwarded-For",
+  "X-Forwarded-Proto",
+  "X-Requested-With"
+};
+
+static size_t interned_header_lengths[ARRAY_SIZE(interned_header_names)];
+static Persistent<String> interned_header_syms[
+    ARRAY_SIZE(interned_header_names)];
+static Persistent<String> interned_header_lower_syms[
+    ARRAY_SIZE(interned_header_names)];
+
+
+static inline char ToLower(char c) {
+  return c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c;
+}
+
+
+// Returns the shared String for the header name, or an empty handle if the
+// name is not interned.
+static Local<String> InternedHeaderName(const char* str, size_t size) {
+  for (size_t i = 0; i < ARRAY_SIZE(interned_header_names); i++) {
+    const char* name = interned_header_names[i];
+
+    if (interned_header_lengths[i] != size || strncasecmp(name, str, size))
+      continue;
+
+    if (memcmp(name, str, size) == 0)
+      return Local<String>::New(interned_header_syms[i]);
+
+    size_t k = 0;
+    while (k < size && str[k] == ToLower(name[k]))
+      k++;
+
+    if (k == size)
+      return Local<String>::New(interned_header_lower_syms[i]);
+
+    return Local<String>();
+  }
+
+  return Local<String>();
+}
+
+
+// Bump allocator for header bytes that have to outlive the buffer they
+// arrived in. Everything is released at once with Reset() after the headers
+// have been handed to JS, instead of one delete[] per string.
+class HeaderArena {
+public:
+  HeaderArena() : blocks_(NULL) {
     Reset();
   }
 
 
-  ~StringPtr() {
+  ~HeaderArena() {
     Reset();
   }
 
 
-  // If str_ does not point to a heap string yet, this function makes it do
+  char* Allocate(size_t size) {
+    if (size > capacity_ - used_) {
+      size_t block_size = size > kBlockSize ? size : kBlockSize;
+      char* block = new char[sizeof(Block) + block_size];
+      reinterpret_cast<Block*>(block)->next = blocks_;
+      blocks_ = reinterpret_cast<Block*>(block);
+      data_ = block + sizeof(Block);
+      capacity_ = block_size;
+      used_ = 0;
+    }
+
+    char* ptr = data_ + used_;
+    used_ += size;
+    return ptr;
+  }
+
+
+  // Grows the most recent allocation in place, if there is room for it.
+  bool Extend(const char* ptr, size_t size, size_t extra) {
+    if (ptr + size != data_ + used_ || extra > capacity_ - used_)
+      return false;
+    used_ += extra;
+    return true;
+  }
+
+
+  void Reset() {
+    while (blocks_ != NULL) {
+      Block* next = blocks_->next;
+      delete[] reinterpret_cast<char*>(blocks_);
+      blocks_ = next;
+    }
+
+    data_ = storage_;
+    capacity_ = sizeof(storage_);
+    used_ = 0;
+  }
+
+
+private:
+  static const size_t kBlockSize = 8192;
+
+  struct Block {
+    Block* next;
+  };
+
+  Block* blocks_;
+  char* data_;
+  size_t capacity_;
+  size_t used_;
+  char storage_[2048];
+};
+
+
+// helper class for the Parser
+struct StringPtr {
+  StringPtr() {
+    Reset();
+  }
+
+
+  // If str_ does not point to arena memory yet, this function makes it do
   // so. This is called at the end of each http_parser_execute() so as not
   // to leak references. See issue #2438 and test-http-parser-bad-ref.js.
-  void Save() {
-    if (!on_heap_ && size_ > 0) {
-      char* s = new char[size_];
+  void Save(HeaderArena* arena) {
+    if (!in_arena_ && size_ > 0) {
+      char* s = arena->Allocate(size_);
       memcpy(s, str_, size_);
       str_ = s;
-      on_heap_ = true;
+      in_arena_ = true;
     }
   }
 
 
+  // The memory belongs to the arena, which is reset by the parser once
+  // all strings that point into it have been converted.
   void Reset() {
-    if (on_heap_) {
-      delete[] str_;
-      on_heap_ = false;
-    }
-
+    in_arena_ = false;
     str_ = NULL;
     size_ = 0;
   }
 
 
-  void Update(const char* str, size_t size) {
+  void Update(const char* str, size_t size, HeaderArena* arena) {
     if (str_ == NULL)
       str_ = str;
-    else if (on_heap_ || str_ + size_ != str) {
-      // Non-consecutive input, make a copy on the heap.
-      // TODO Use slab allocation, O(n) allocs is bad.
-      char* s = new char[size_ + size];
+    else if (in_arena_ && arena->Extend(str_, size_, size))
+      memcpy(const_cast<char*>(str_) + size_, str, size);
+    else if (in_arena_ || str_ + size_ != str) {
+      // Non-consecutive input, make a copy in the arena.
+      char* s = arena->Allocate(size_ + size);
       memcpy(s, str_, size_);
       memcpy(s + size_, str, size);
-
-      if (on_heap_)
-        delete[] str_;
-      else
-        on_heap_ = true;
-
       str_ = s;
+      in_arena_ = true;
     }
     size_ += size;
   }
@@ -174,8 +312,18 @@ struct StringPtr {
   }
 
 
+  Local<String> ToHeaderName() const {
+    if (str_) {
+      Local<String> name = InternedHeaderName(str_, size_);
+      if (!name.IsEmpty())
+        return name;
+    }
+    return ToString();
+  }
+
+
   const char* str_;
-  bool on_heap_;
+  bool in_arena_;
   size_t size_;
 };
 
@@ -188,18 +336,21 @@ public:
 
 
   ~Parser() {
+    ClearPending();
   }
 
 
   HTTP_CB(on_message_begin) {
+    batch_in_message_ = false;
     num_fields_ = num_values_ = 0;
     url_.Reset();
+    arena_.Reset();
     return 0;
   }
 
 
   HTTP_DATA_CB(on_url) {
-    url_.Update(at, length);
+    url_.Update(at, length, &arena_);
     return 0;
   }
 
@@ -220,7 +371,7 @@ public:
     assert(num_fields_ < (int)ARRAY_SIZE(fields_));
     assert(num_fields_ == num_values_ + 1);
 
-    fields_[num_fields_ - 1].Update(at, length);
+    fields_[num_fields_ - 1].Update(at, length, &arena_);
 
     return 0;
   }
@@ -236,13 +387,24 @@ public:
     assert(num_values_ < (int)ARRAY_SIZE(values_));
     assert(num_values_ == num_fields_);
 
-    values_[num_values_ - 1].Update(at, length);
+    values_[num_values_ - 1].Update(at, length, &arena_);
 
     return 0;
   }
 
 
   HTTP_CB(on_headers_complete) {
+    if (!batch_.IsEmpty()) {
+      // Batch mode, record the message instead of calling into JS.
+      Local<Object> message_info = Object::New();
+      message_info->Set(headers_sym, TakeBatchHeaders());
+      if (parser_.type == HTTP_REQUEST)
+        message_info->Set(url_sym, TakeBatchUrl());
+      SetMessageInfo(message_info);
+      AddBatchMessage(message_info);
+      return 0;
+    }
+
     Local<Value> cb = handle_->Get(on_headers_complete_sym);
 
     if (!cb->IsFunction())
@@ -262,30 +424,7 @@ public:
     }
     num_fields_ = num_values_ = 0;
 
-    // METHOD
-    if (parser_.type == HTTP_REQUEST) {
-      message_info->Set(method_sym, method_to_str(parser_.method));
-    }
-
-    // STATUS
-    if (parser_.type == HTTP_RESPONSE) {
-      message_info->Set(status_code_sym,
-                        Integer::New(parser_.status_code));
-    }
-
-    // VERSION
-    message_info->Set(version_major_sym,
-                      Integer::New(parser_.http_major));
-    message_info->Set(version_minor_sym,
-                      Integer::New(parser_.http_minor));
-
-    message_info->Set(should_keep_alive_sym,
-                      http_should_keep_alive(&parser_) ? True()
-                                                       : False());
-
-    message_info->Set(upgrade_sym,
-                      parser_.upgrade ? True()
-                                      : False());
+    SetMessageInfo(message_info);
 
     Local<Value> argv[1] = { message_info };
 
@@ -302,6 +441,17 @@ public:
 
 
   HTTP_DATA_CB(on_body) {
+    if (!batch_.IsEmpty()) {
+      // Record where the chunk sits in the buffer, as [offset, length].
+      // No HandleScope, the handles belong to the executeBatch() call.
+      if (!batch_in_message_)
+        AddBatchContinuation();
+      batch_body_->Set(batch_body_length_++,
+                       Integer::New(at - current_buffer_data));
+      batch_body_->Set(batch_body_length_++, Integer::New(length));
+      return 0;
+    }
+
     HandleScope scope;
 
     Local<Value> cb = handle_->Get(on_body_sym);
@@ -326,6 +476,16 @@ public:
 
 
   HTTP_CB(on_message_complete) {
+    if (!batch_.IsEmpty()) {
+      if (!batch_in_message_)
+        AddBatchContinuation();
+      if (num_fields_ || !pending_headers_.IsEmpty())
+        batch_message_->Set(trailers_sym, TakeBatchHeaders());
+      batch_message_->Set(complete_sym, True());
+      batch_in_message_ = false;
+      return 0;
+    }
+
     HandleScope scope;
 
     if (num_fields_)
@@ -366,19 +526,29 @@ public:
 
 
   void Save() {
-    url_.Save();
+    url_.Save(&arena_);
 
     for (int i = 0; i < num_fields_; i++) {
-      fields_[i].Save();
+      fields_[i].Save(&arena_);
     }
 
     for (int i = 0; i < num_values_; i++) {
-      values_[i].Save();
+      values_[i].Save(&arena_);
     }
   }
 
 
   // var bytesParsed = parser->execute(buffer, off, len);
+  //
+  // var result = parser->executeBatch(buffer, off, len);
+  //
+  // The batch variant never calls back into JS. It parses every message in
+  // the buffer and returns { bytesParsed, messages[, error] }, where each
+  // message carries the fields onHeadersComplete() would have received, plus
+  // `body` ([offset, length, ...] into the buffer), `trailers` if there were
+  // any and `complete`. A message that was started by an earlier call shows
+  // up as { continued: true, body, complete }. Bodies are never skipped.
+  template <bool batch>
   static Handle<Value> Execute(const Arguments& args) {
     HandleScope scope;
 
@@ -421,6 +591,12 @@ public:
     current_buffer_len = buffer_len;
     parser->got_exception_ = false;
 
+    if (batch) {
+      parser->batch_ = Array::New();
+      parser->batch_length_ = 0;
+      parser->batch_in_message_ = false;
+    }
+
     size_t nparsed =
       http_parser_execute(&parser->parser_, &settings, buffer_data + off, len);
 
@@ -435,19 +611,35 @@ public:
     if (parser->got_exception_) return Local<Value>();
 
     Local<Integer> nparsed_obj = Integer::New(nparsed);
+    Local<Value> e;
+
     // If there was a parse error in one of the callbacks
     // TODO What if there is an error on EOF?
     if (!parser->parser_.upgrade && nparsed != len) {
       enum http_errno err = HTTP_PARSER_ERRNO(&parser->parser_);
 
-      Local<Value> e = Exception::Error(String::NewSymbol("Parse Error"));
+      e = Exception::Error(String::NewSymbol("Parse Error"));
       Local<Object> obj = e->ToObject();
       obj->Set(String::NewSymbol("bytesParsed"), nparsed_obj);
       obj->Set(String::NewSymbol("code"), String::New(http_errno_name(err)));
+    }
+
+    if (batch) {
+      Local<Object> result = Object::New();
+      result->Set(String::NewSymbol("bytesParsed"), nparsed_obj);
+      result->Set(String::NewSymbol("messages"), parser->batch_);
+      if (!e.IsEmpty())
+        result->Set(String::NewSymbol("error"), e);
+      parser->batch_ = Local<Array>();
+      parser->batch_message_ = Local<Object>();
+      parser->batch_body_ = Local<Array>();
+      return scope.Close(result);
+    }
+
+    if (!e.IsEmpty())
       return scope.Close(e);
-    } else {
+    else
       return scope.Close(nparsed_obj);
-    }
   }
 
 
@@ -506,13 +698,101 @@ public:
 
 private:
 
+  void SetMessageInfo(Local<Object> message_info) {
+    // METHOD
+    if (parser_.type == HTTP_REQUEST) {
+      message_info->Set(method_sym, method_to_str(parser_.method));
+    }
+
+    // STATUS
+    if (parser_.type == HTTP_RESPONSE) {
+      message_info->Set(status_code_sym,
+                        Integer::New(parser_.status_code));
+    }
+
+    // VERSION
+    message_info->Set(version_major_sym,
+                      Integer::New(parser_.http_major));
+    message_info->Set(version_minor_sym,
+                      Integer::New(parser_.http_minor));
+
+    message_info->Set(should_keep_alive_sym,
+                      http_should_keep_alive(&parser_) ? True()
+                                                       : False());
+
+    message_info->Set(upgrade_sym,
+                      parser_.upgrade ? True()
+                                      : False());
+  }
+
+
+  // Appends a message to the batch and makes it the current one.
+  void AddBatchMessage(Local<Object> message_info) {
+    batch_body_ = Array::New();
+    batch_body_length_ = 0;
+    message_info->Set(body_sym, batch_body_);
+    message_info->Set(complete_sym, False());
+    batch_->Set(batch_length_++, message_info);
+    batch_message_ = message_info;
+    batch_in_message_ = true;
+  }
+
+
+  // The headers of the current message were returned by an earlier
+  // executeBatch(), start an entry for the rest of it.
+  void AddBatchContinuation() {
+    Local<Object> message_info = Object::New();
+    message_info->Set(continued_sym, True());
+    AddBatchMessage(message_info);
+  }
+
+
+  // Collects the headers spilled by Flush() and the ones still held by the
+  // parser into one flat array.
+  Local<Array> TakeBatchHeaders() {
+    HandleScope scope;
+
+    Local<Array> headers = CreateHeaders();
+    num_fields_ = num_values_ = 0;
+
+    if (pending_headers_.IsEmpty())
+      return scope.Close(headers);
+
+    uint32_t length = pending_headers_->Length();
+    for (uint32_t i = 0; i < headers->Length(); i++)
+      pending_headers_->Set(length + i, headers->Get(i));
+
+    headers = Local<Array>::New(pending_headers_);
+    pending_headers_.Dispose();
+    pending_headers_.Clear();
+
+    return scope.Close(headers);
+  }
+
+
+  Local<String> TakeBatchUrl() {
+    HandleScope scope;
+
+    Local<String> url = url_.ToString();
+
+    if (pending_url_.IsEmpty())
+      return scope.Close(url);
+
+    url = String::Concat(Local<String>::New(pending_url_), url);
+    pending_url_.Dispose();
+    pending_url_.Clear();
+
+    return scope.Close(url);
+  }
+
+
   Local<Array> CreateHeaders() {
     // num_values_ is either -1 or the entry # of the last header
     // so num_values_ == 0 means there's a single header
     Local<Array> headers = Array::New(2 * num_values_);
 
     for (int i = 0; i < num_values_; ++i) {
-      headers->Set(2 * i, fields_[i].ToString());
+      headers->Set(2 * i, fields_[i].ToHeaderName());
       headers->Set(2 * i + 1, values_[i].ToString());
     }
 
@@ -524,6 +804,30 @@ private:
   void Flush() {
     HandleScope scope;
 
+    if (!batch_.IsEmpty()) {
+      // Batch mode, park them until the message's headers are complete.
+      Local<Array> headers = CreateHeaders();
+      Local<String> url = url_.ToString();
+
+      if (pending_headers_.IsEmpty()) {
+        pending_headers_ = Persistent<Array>::New(headers);
+        pending_url_ = Persistent<String>::New(url);
+      } else {
+        uint32_t length = pending_headers_->Length();
+        for (uint32_t i = 0; i < headers->Length(); i++)
+          pending_headers_->Set(length + i, headers->Get(i));
+
+        Local<String> joined =
+            String::Concat(Local<String>::New(pending_url_), url);
+        pending_url_.Dispose();
+        pending_url_ = Persistent<String>::New(joined);
+      }
+
+      url_.Reset();
+      arena_.Reset();
+      return;
+    }
+
     Local<Value> cb = handle_->Get(on_headers_sym);
 
     if (!cb->IsFunction())
@@ -539,7 +843,10 @@ private:
     if (r.IsEmpty())
       got_exception_ = true;
 
+    // Every header string has been copied into JS land now, the parser
+    // starts over with fresh fields.
     url_.Reset();
+    arena_.Reset();
     have_flushed_ = true;
   }
 
@@ -547,10 +854,25 @@ private:
   void Init(enum http_parser_type type) {
     http_parser_init(&parser_, type);
     url_.Reset();
+    arena_.Reset();
     num_fields_ = 0;
     num_values_ = 0;
     have_flushed_ = false;
     got_exception_ = false;
+    batch_in_message_ = false;
+    ClearPending();
+  }
+
+
+  void ClearPending() {
+    if (!pending_headers_.IsEmpty()) {
+      pending_headers_.Dispose();
+      pending_headers_.Clear();
+    }
+    if (!pending_url_.IsEmpty()) {
+      pending_url_.Dispose();
+      pending_url_.Clear();
+    }
   }
 
 
@@ -558,10 +880,21 @@ private:
   StringPtr fields_[32];  // header fields
   StringPtr values_[32];  // header values
   StringPtr url_;
+  HeaderArena arena_;  // backing store for saved header and url bytes
   int num_fields_;
   int num_values_;
   bool have_flushed_;
   bool got_exception_;
+  // executeBatch() state. The handles are only set while it runs, the
+  // pending headers can carry over to the next call.
+  Local<Array> batch_;
+  Local<Object> batch_message_;
+  Local<Array> batch_body_;
+  uint32_t batch_length_;
+  uint32_t batch_body_length_;
+  bool batch_in_message_;
+  Persistent<Array> pending_headers_;
+  Persistent<String> pending_url_;
 };
 
 
@@ -580,7 +913,8 @@ void InitHttpParser(Handle<Object> target) {
          Integer::New(HTTP_RESPONSE),
          attrib);
 
-  NODE_SET_PROTOTYPE_METHOD(t, "execute", Parser::Execute);
+  NODE_SET_PROTOTYPE_METHOD(t, "execute", Parser::Execute<false>);
+  NODE_SET_PROTOTYPE_METHOD(t, "executeBatch", Parser::Execute<true>);
   NODE_SET_PROTOTYPE_METHOD(t, "finish", Parser::Finish);
   NODE_SET_PROTOTYPE_METHOD(t, "reinitialize", Parser::Reinitialize);
   NODE_SET_PROTOTYPE_METHOD(t, "pause", Parser::Pause<true>);
@@ -598,6 +932,19 @@ void InitHttpParser(Handle<Object> target) {
 #undef X
   unknown_method_sym = NODE_PSYMBOL("UNKNOWN_METHOD");
 
+  for (size_t i = 0; i < ARRAY_SIZE(interned_header_names); i++) {
+    const char* name = interned_header_names[i];
+    char lower[32];
+    size_t k;
+    assert(strlen(name) < sizeof(lower));
+    for (k = 0; name[k] != '\0'; k++)
+      lower[k] = ToLower(name[k]);
+    lower[k] = '\0';
+    interned_header_lengths[i] = k;
+    interned_header_syms[i] = NODE_PSYMBOL(name);
+    interned_header_lower_syms[i] = NODE_PSYMBOL(lower);
+  }
+
   method_sym = NODE_PSYMBOL("method");
   status_code_sym = NODE_PSYMBOL("statusCode");
   http_version_sym = NODE_PSYMBOL("httpVersion");
@@ -607,6 +954,10 @@ void InitHttpParser(Handle<Object> target) {
   upgrade_sym = NODE_PSYMBOL("upgrade");
   headers_sym = NODE_PSYMBOL("headers");
   url_sym = NODE_PSYMBOL("url");
+  body_sym = NODE_PSYMBOL("body");
+  trailers_sym = NODE_PSYMBOL("trailers");
+  complete_sym = NODE_PSYMBOL("complete");
+  continued_sym = NODE_PSYMBOL("continued");
 
   settings.on_message_begin    = Parser::on_message_begin;
   settings.on_url              = Parser::on_url;
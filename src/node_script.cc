@@ -20,6 +20,7 @@
 // USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "node.h"
+#include "node_compile_cache.h"
 #include "node_script.h"
 #include <assert.h>
 
@@ -27,6 +28,7 @@ namespace node {
 
 using v8::Context;
 using v8::Script;
+using v8::ScriptOrigin;
 using v8::Value;
 using v8::Handle;
 using v8::HandleScope;
@@ -131,6 +133,22 @@ void CloneObject(Handle<Object> recv,
 }
 
 
+// Every context is deserialized from the startup snapshot. In builds
+// configured with --with-core-snapshot that includes the __nodeSnapshot
+// holder with the compiled core modules, which node::Load() only removes
+// from the main context. Take it off here too, before a sandbox is copied
+// in or out.
+static Persistent<Context> NewContext() {
+  HandleScope scope;
+
+  Persistent<Context> context = Context::New();
+  Context::Scope context_scope(context);
+  context->Global()->Delete(String::NewSymbol("__nodeSnapshot"));
+
+  return context;
+}
+
+
 void WrappedContext::Initialize(Handle<Object> target) {
   HandleScope scope;
 
@@ -160,7 +178,7 @@ Handle<Value> WrappedContext::New(const Arguments& args) {
 
 
 WrappedContext::WrappedContext() : ObjectWrap() {
-  context_ = Context::New();
+  context_ = NewContext();
 }
 
 
@@ -362,7 +380,7 @@ Handle<Value> WrappedScript::EvalMachine(const Arguments& args) {
     // function. Here we grab a temporary handle to the new context, assign it
     // to a local handle, and then dispose the persistent handle. This ensures
     // that when this function exits the context will be disposed.
-    Persistent<Context> tmp = Context::New();
+    Persistent<Context> tmp = NewContext();
     context = Local<Context>::New(tmp);
     tmp.Dispose();
 
@@ -388,10 +406,13 @@ Handle<Value> WrappedScript::EvalMachine(const Arguments& args) {
   Handle<Script> script;
 
   if (input_flag == compileCode) {
+    CompileCacheData pre_data(code);
+    ScriptOrigin origin(filename);
     // well, here WrappedScript::New would suffice in all cases, but maybe
     // Compile has a little better performance where possible
-    script = output_flag == returnResult ? Script::Compile(code, filename)
-                                         : Script::New(code, filename);
+    script = output_flag == returnResult
+        ? Script::Compile(code, &origin, pre_data.data())
+        : Script::New(code, &origin, pre_data.data());
     if (script.IsEmpty()) {
       // FIXME UGLY HACK TO DISPLAY SYNTAX ERRORS.
       if (display_error) DisplayExceptionLine(try_catch);
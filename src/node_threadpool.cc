@@ -0,0 +1,152 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "node.h"
+#include "node_internals.h"
+#include "node_threadpool.h"
+#include "uv.h"
+
+#include <string.h>
+
+namespace node {
+
+using v8::Arguments;
+using v8::Array;
+using v8::Handle;
+using v8::HandleScope;
+using v8::Integer;
+using v8::Local;
+using v8::Number;
+using v8::Object;
+using v8::String;
+using v8::Undefined;
+using v8::Value;
+
+// Indexed by uv_work_class_t.
+static const char* const class_names[] = { "fs", "dns", "cpu", "user" };
+
+
+static int ClassFromName(Handle<Value> name) {
+  String::Utf8Value s(name);
+
+  for (unsigned int i = 0; i < ARRAY_SIZE(class_names); i++) {
+    if (strcmp(*s, class_names[i]) == 0)
+      return i;
+  }
+
+  return -1;
+}
+
+
+static Local<Array> HistogramToJS(const uint64_t* hist) {
+  HandleScope scope;
+  Local<Array> array = Array::New(UV_THREADPOOL_HIST_BUCKETS);
+
+  for (unsigned int i = 0; i < UV_THREADPOOL_HIST_BUCKETS; i++)
+    array->Set(i, Number::New(static_cast<double>(hist[i])));
+
+  return scope.Close(array);
+}
+
+
+// getStats() returns { size, classes: { fs, dns, cpu, user } }. Histogram
+// bucket i counts the jobs that took 2^i to 2^(i+1) microseconds.
+Handle<Value> ThreadPool::GetStats(const Arguments& args) {
+  HandleScope scope;
+
+  Local<Object> stats = Object::New();
+  Local<Object> classes = Object::New();
+
+  for (int i = 0; i < UV_WORK_CLASS_MAX; i++) {
+    uv_threadpool_stats_t s;
+    uv_err_t err = uv_threadpool_get_stats(static_cast<uv_work_class_t>(i),
+                                           &s);
+    if (err.code != UV_OK)
+      return ThrowException(UVException(err.code, "uv_threadpool_get_stats"));
+
+    Local<Object> entry = Object::New();
+    entry->Set(String::New("limit"), Integer::NewFromUnsigned(s.limit));
+    entry->Set(String::New("running"), Integer::NewFromUnsigned(s.running));
+    entry->Set(String::New("queued"), Integer::NewFromUnsigned(s.queued));
+    entry->Set(String::New("submitted"),
+               Number::New(static_cast<double>(s.submitted)));
+    entry->Set(String::New("completed"),
+               Number::New(static_cast<double>(s.completed)));
+    entry->Set(String::New("waitHistogram"), HistogramToJS(s.wait_hist));
+    entry->Set(String::New("runHistogram"), HistogramToJS(s.run_hist));
+    classes->Set(String::New(class_names[i]), entry);
+  }
+
+  stats->Set(String::New("size"),
+             Integer::NewFromUnsigned(uv_threadpool_size()));
+  stats->Set(String::New("classes"), classes);
+
+  return scope.Close(stats);
+}
+
+
+// setLimit(className, limit), a limit of 0 means no limit.
+Handle<Value> ThreadPool::SetLimit(const Arguments& args) {
+  HandleScope scope;
+
+  int work_class = ClassFromName(args[0]);
+  if (work_class == -1)
+    return ThrowTypeError("Unknown work class");
+
+  if (!args[1]->IsUint32())
+    return ThrowTypeError("Limit must be a non-negative integer");
+
+  uv_err_t err = uv_threadpool_set_limit(
+      static_cast<uv_work_class_t>(work_class), args[1]->Uint32Value());
+  if (err.code != UV_OK)
+    return ThrowException(UVException(err.code, "uv_threadpool_set_limit"));
+
+  return Undefined();
+}
+
+
+// resize(nthreads)
+Handle<Value> ThreadPool::Resize(const Arguments& args) {
+  HandleScope scope;
+
+  if (!args[0]->IsUint32())
+    return ThrowTypeError("Size must be a positive integer");
+
+  uv_err_t err = uv_threadpool_resize(args[0]->Uint32Value());
+  if (err.code != UV_OK)
+    return ThrowException(UVException(err.code, "uv_threadpool_resize"));
+
+  return Undefined();
+}
+
+
+void ThreadPool::Initialize(Handle<Object> target) {
+  HandleScope scope;
+
+  NODE_SET_METHOD(target, "getStats", GetStats);
+  NODE_SET_METHOD(target, "setLimit", SetLimit);
+  NODE_SET_METHOD(target, "resize", Resize);
+}
+
+
+}  // namespace node
+
+NODE_MODULE(node_threadpool, node::ThreadPool::Initialize)
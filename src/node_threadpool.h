@@ -19,31 +19,26 @@
 // OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
 // USE OR OTHER DEALINGS IN THE SOFTWARE.
 
+#ifndef NODE_THREADPOOL_H_
+#define NODE_THREADPOOL_H_
+
+#include "node.h"
 #include "v8.h"
 
 namespace node {
 
-class SlabAllocator {
-public:
-  SlabAllocator(unsigned int size = 10485760); // default to 10M
-  ~SlabAllocator();
-
-  // allocate memory from slab, attaches the slice to `obj`
-  char* Allocate(v8::Handle<v8::Object> obj, unsigned int size);
+// process.binding('threadpool'): sizing, per-class limits and statistics of
+// the libuv thread pool.
+class ThreadPool {
+ public:
+  static void Initialize(v8::Handle<v8::Object> target);
 
-  // return excess memory to the slab, returns a handle to the parent buffer
-  v8::Local<v8::Object> Shrink(v8::Handle<v8::Object> obj,
-                               char* ptr,
-                               unsigned int size);
-
-private:
-  void Initialize();
-  bool initialized_;
-  v8::Persistent<v8::Object> slab_;
-  v8::Persistent<v8::String> slab_sym_;
-  unsigned int offset_;
-  unsigned int size_;
-  char* last_ptr_;
+ private:
+  static v8::Handle<v8::Value> GetStats(const v8::Arguments& args);
+  static v8::Handle<v8::Value> SetLimit(const v8::Arguments& args);
+  static v8::Handle<v8::Value> Resize(const v8::Arguments& args);
 };
 
-} // namespace node
+}  // namespace node
+
+#endif  // NODE_THREADPOOL_H_
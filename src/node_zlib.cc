@@ -178,10 +178,11 @@ class ZCtx : public ObjectWrap {
     // set this so that later on, I can easily tell how much was written.
     ctx->chunk_size_ = out_len;
 
-    uv_queue_work(uv_default_loop(),
-                  work_req,
-                  ZCtx::Process,
-                  ZCtx::After);
+    uv_queue_work_class(uv_default_loop(),
+                        work_req,
+                        UV_WORK_CPU,
+                        ZCtx::Process,
+                        ZCtx::After);
 
     return ctx->handle_;
   }
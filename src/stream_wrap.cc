@@ -22,7 +22,7 @@
 #include "node.h"
 #include "node_buffer.h"
 #include "handle_wrap.h"
-#include "slab_allocator.h"
+#include "buffer_pool.h"
 #include "stream_wrap.h"
 #include "pipe_wrap.h"
 #include "tcp_wrap.h"
@@ -33,13 +33,12 @@
 #include <stdlib.h> // abort()
 #include <limits.h> // INT_MAX
 
-#define SLAB_SIZE (1024 * 1024)
-
 
 namespace node {
 
 using v8::AccessorInfo;
 using v8::Arguments;
+using v8::Array;
 using v8::Context;
 using v8::Exception;
 using v8::Function;
@@ -55,46 +54,22 @@ using v8::String;
 using v8::TryCatch;
 using v8::Value;
 
-typedef class ReqWrap<uv_shutdown_t> ShutdownWrap;
-
-class WriteWrap: public ReqWrap<uv_write_t> {
- public:
-  void* operator new(size_t size, char* storage) { return storage; }
-
-  // This is just to keep the compiler happy. It should never be called, since
-  // we don't use exceptions in node.
-  void operator delete(void* ptr, char* storage) { assert(0); }
-
- protected:
-  // People should not be using the non-placement new and delete operator on a
-  // WriteWrap. Ensure this never happens.
-  void* operator new (size_t size) { assert(0); };
-  void operator delete(void* ptr) { assert(0); };
-};
-
-
 static Persistent<String> buffer_sym;
 static Persistent<String> bytes_sym;
 static Persistent<String> write_queue_size_sym;
 static Persistent<String> onread_sym;
 static Persistent<String> oncomplete_sym;
 static Persistent<String> handle_sym;
-static SlabAllocator* slab_allocator;
+static Persistent<String> onpipe_sym;
+static BufferPool* buffer_pool;
 static bool initialized;
 
 
-static void DeleteSlabAllocator(void*) {
-  delete slab_allocator;
-  slab_allocator = NULL;
-}
-
-
 void StreamWrap::Initialize(Handle<Object> target) {
   if (initialized) return;
   initialized = true;
 
-  slab_allocator = new SlabAllocator(SLAB_SIZE);
-  AtExit(DeleteSlabAllocator, NULL);
+  buffer_pool = BufferPool::GetDefault();
 
   HandleScope scope;
 
@@ -105,11 +80,36 @@ void StreamWrap::Initialize(Handle<Object> target) {
   write_queue_size_sym = NODE_PSYMBOL("writeQueueSize");
   onread_sym = NODE_PSYMBOL("onread");
   oncomplete_sym = NODE_PSYMBOL("oncomplete");
+  onpipe_sym = NODE_PSYMBOL("onpipe");
 }
 
 
+// A uv_splice_t that keeps both stream objects alive until it finishes.
+class SpliceWrap {
+ public:
+  SpliceWrap(Handle<Object> src, Handle<Object> dst)
+      : src_(Persistent<Object>::New(src)),
+        dst_(Persistent<Object>::New(dst)) {
+    req_.data = this;
+  }
+
+  ~SpliceWrap() {
+    src_.Dispose();
+    src_.Clear();
+    dst_.Dispose();
+    dst_.Clear();
+  }
+
+  uv_splice_t req_;
+  Persistent<Object> src_;
+  Persistent<Object> dst_;
+};
+
+
 StreamWrap::StreamWrap(Handle<Object> object, uv_stream_t* stream)
-    : HandleWrap(object, (uv_handle_t*)stream) {
+    : HandleWrap(object, (uv_handle_t*)stream),
+      default_callbacks_(this),
+      callbacks_(&default_callbacks_) {
   stream_ = stream;
   if (stream) {
     stream->data = this;
@@ -117,6 +117,21 @@ StreamWrap::StreamWrap(Handle<Object> object, uv_stream_t* stream)
 }
 
 
+StreamWrap::~StreamWrap() {
+  if (callbacks_ != &default_callbacks_) {
+    delete callbacks_;
+    callbacks_ = NULL;
+  }
+}
+
+
+void StreamWrap::OverrideCallbacks(StreamWrapCallbacks* callbacks) {
+  if (callbacks_ != &default_callbacks_)
+    delete callbacks_;
+  callbacks_ = callbacks;
+}
+
+
 Handle<Value> StreamWrap::GetFD(Local<String>, const AccessorInfo& args) {
 #if defined(_WIN32)
   return v8::Null();
@@ -140,7 +155,7 @@ void StreamWrap::SetHandle(uv_handle_t* h) {
 void StreamWrap::UpdateWriteQueueSize() {
   HandleScope scope;
   object_->Set(write_queue_size_sym,
-               Integer::New(stream_->write_queue_size));
+               Integer::New(callbacks_->WriteQueueSize()));
 }
 
 
@@ -182,8 +197,7 @@ Handle<Value> StreamWrap::ReadStop(const Arguments& args) {
 uv_buf_t StreamWrap::OnAlloc(uv_handle_t* handle, size_t suggested_size) {
   StreamWrap* wrap = static_cast<StreamWrap*>(handle->data);
   assert(wrap->stream_ == reinterpret_cast<uv_stream_t*>(handle));
-  char* buf = slab_allocator->Allocate(wrap->object_, suggested_size);
-  return uv_buf_init(buf, suggested_size);
+  return buffer_pool->Allocate(suggested_size);
 }
 
 
@@ -211,64 +225,13 @@ static Local<Object> AcceptHandle(uv_stream_t* pipe) {
 
 void StreamWrap::OnReadCommon(uv_stream_t* handle, ssize_t nread,
     uv_buf_t buf, uv_handle_type pending) {
-  HandleScope scope;
-
   StreamWrap* wrap = static_cast<StreamWrap*>(handle->data);
 
   // We should not be getting this callback if someone as already called
   // uv_close() on the handle.
   assert(wrap->object_.IsEmpty() == false);
 
-  if (nread < 0)  {
-    // If libuv reports an error or EOF it *may* give us a buffer back. In that
-    // case, return the space to the slab.
-    if (buf.base != NULL) {
-      slab_allocator->Shrink(wrap->object_, buf.base, 0);
-    }
-
-    SetErrno(uv_last_error(uv_default_loop()));
-    MakeCallback(wrap->object_, onread_sym, 0, NULL);
-    return;
-  }
-
-  assert(buf.base != NULL);
-  Local<Object> slab = slab_allocator->Shrink(wrap->object_,
-                                              buf.base,
-                                              nread);
-
-  if (nread == 0) return;
-  assert(static_cast<size_t>(nread) <= buf.len);
-
-  int argc = 3;
-  Local<Value> argv[4] = {
-    slab,
-    Integer::NewFromUnsigned(buf.base - Buffer::Data(slab)),
-    Integer::NewFromUnsigned(nread)
-  };
-
-  Local<Object> pending_obj;
-  if (pending == UV_TCP) {
-    pending_obj = AcceptHandle<TCPWrap, uv_tcp_t>(handle);
-  } else if (pending == UV_NAMED_PIPE) {
-    pending_obj = AcceptHandle<PipeWrap, uv_pipe_t>(handle);
-  } else if (pending == UV_UDP) {
-    pending_obj = AcceptHandle<UDPWrap, uv_udp_t>(handle);
-  } else {
-    assert(pending == UV_UNKNOWN_HANDLE);
-  }
-
-  if (!pending_obj.IsEmpty()) {
-    argv[3] = pending_obj;
-    argc++;
-  }
-
-  if (wrap->stream_->type == UV_TCP) {
-    NODE_COUNT_NET_BYTES_RECV(nread);
-  } else if (wrap->stream_->type == UV_NAMED_PIPE) {
-    NODE_COUNT_PIPE_BYTES_RECV(nread);
-  }
-
-  MakeCallback(wrap->object_, onread_sym, argc, argv);
+  wrap->callbacks_->DoRead(handle, nread, buf, pending);
 }
 
 
@@ -302,11 +265,11 @@ Handle<Value> StreamWrap::WriteBuffer(const Arguments& args) {
   buf.base = Buffer::Data(buffer_obj) + offset;
   buf.len = length;
 
-  int r = uv_write(&req_wrap->req_,
-                   wrap->stream_,
-                   &buf,
-                   1,
-                   StreamWrap::AfterWrite);
+  int r = wrap->callbacks_->DoWrite(req_wrap,
+                                    &buf,
+                                    1,
+                                    NULL,
+                                    StreamWrap::AfterWrite);
 
   req_wrap->Dispatched();
   req_wrap->object_->Set(bytes_sym,
@@ -378,11 +341,11 @@ Handle<Value> StreamWrap::WriteStringImpl(const Arguments& args) {
                   ((uv_pipe_t*)wrap->stream_)->ipc;
 
   if (!ipc_pipe) {
-    r = uv_write(&req_wrap->req_,
-                 wrap->stream_,
-                 &buf,
-                 1,
-                 StreamWrap::AfterWrite);
+    r = wrap->callbacks_->DoWrite(req_wrap,
+                                  &buf,
+                                  1,
+                                  NULL,
+                                  StreamWrap::AfterWrite);
 
   } else {
     uv_handle_t* send_handle = NULL;
@@ -403,12 +366,11 @@ Handle<Value> StreamWrap::WriteStringImpl(const Arguments& args) {
       req_wrap->object_->Set(handle_sym, send_handle_obj);
     }
 
-    r = uv_write2(&req_wrap->req_,
-                  wrap->stream_,
-                  &buf,
-                  1,
-                  reinterpret_cast<uv_stream_t*>(send_handle),
-                  StreamWrap::AfterWrite);
+    r = wrap->callbacks_->DoWrite(req_wrap,
+                                  &buf,
+                                  1,
+                                  reinterpret_cast<uv_stream_t*>(send_handle),
+                                  StreamWrap::AfterWrite);
   }
 
   req_wrap->Dispatched();
@@ -448,6 +410,272 @@ Handle<Value> StreamWrap::WriteUcs2String(const Arguments& args) {
 }
 
 
+Handle<Value> StreamWrap::Writev(const Arguments& args) {
+  HandleScope scope;
+
+  UNWRAP(StreamWrap)
+
+  if (args.Length() < 1 || !args[0]->IsArray())
+    return ThrowTypeError("First argument must be an array");
+
+  // The array holds (chunk, encoding) pairs. Buffers are written in place,
+  // strings are flattened into a single storage block that trails the
+  // WriteWrap, so that the whole batch is one uv_write() with one request.
+  Local<Array> chunks = Local<Array>::Cast(args[0]);
+  size_t count = chunks->Length() >> 1;
+
+  if (count == 0)
+    return ThrowTypeError("Not enough chunks");
+
+  uv_buf_t bufs_[16];
+  uv_buf_t* bufs = bufs_;
+
+  // Determine storage size first.
+  size_t storage_size = 0;
+  for (size_t i = 0; i < count; i++) {
+    Local<Value> chunk = chunks->Get(i * 2);
+
+    // Buffer chunk, no additional storage required.
+    if (Buffer::HasInstance(chunk))
+      continue;
+
+    Local<String> string = chunk->ToString();
+    enum encoding encoding = ParseEncoding(chunks->Get(i * 2 + 1));
+    size_t chunk_size;
+    if (encoding == UTF8 && string->Length() > 65535)
+      chunk_size = StringBytes::Size(string, encoding);
+    else
+      chunk_size = StringBytes::StorageSize(string, encoding);
+
+    // Every string chunk starts on a 16 byte boundary.
+    storage_size += chunk_size + 15;
+  }
+
+  if (storage_size > INT_MAX) {
+    uv_err_t err;
+    err.code = UV_ENOBUFS;
+    SetErrno(err);
+    return scope.Close(v8::Null());
+  }
+
+  if (ARRAY_SIZE(bufs_) < count)
+    bufs = new uv_buf_t[count];
+
+  char* storage = new char[sizeof(WriteWrap) + storage_size];
+  WriteWrap* req_wrap = new (storage) WriteWrap();
+
+  // Keep the chunk array, and with it every Buffer, alive until AfterWrite.
+  req_wrap->object_->SetHiddenValue(buffer_sym, chunks);
+
+  uintptr_t offset = reinterpret_cast<uintptr_t>(storage) + sizeof(WriteWrap);
+  uintptr_t limit = offset + storage_size;
+  size_t bytes = 0;
+  for (size_t i = 0; i < count; i++) {
+    Local<Value> chunk = chunks->Get(i * 2);
+
+    // Write buffer
+    if (Buffer::HasInstance(chunk)) {
+      bufs[i].base = Buffer::Data(chunk);
+      bufs[i].len = Buffer::Length(chunk);
+      bytes += bufs[i].len;
+      continue;
+    }
+
+    // Write string
+    offset = ROUND_UP(offset, 16);
+    assert(offset <= limit);
+
+    char* data = reinterpret_cast<char*>(offset);
+    Local<String> string = chunk->ToString();
+    enum encoding encoding = ParseEncoding(chunks->Get(i * 2 + 1));
+    size_t str_size = StringBytes::Write(data,
+                                         limit - offset,
+                                         string,
+                                         encoding);
+
+    bufs[i].base = data;
+    bufs[i].len = str_size;
+    offset += str_size;
+    bytes += str_size;
+  }
+
+  int r = wrap->callbacks_->DoWrite(req_wrap,
+                                    bufs,
+                                    count,
+                                    NULL,
+                                    StreamWrap::AfterWrite);
+
+  // DoWrite() copies the uv_buf_t array, the request does not need it.
+  if (bufs != bufs_)
+    delete[] bufs;
+
+  req_wrap->Dispatched();
+  req_wrap->object_->Set(bytes_sym, Number::New(bytes));
+
+  wrap->UpdateWriteQueueSize();
+
+  if (r) {
+    SetErrno(uv_last_error(uv_default_loop()));
+    req_wrap->~WriteWrap();
+    delete[] storage;
+    return scope.Close(v8::Null());
+  } else {
+    if (wrap->stream_->type == UV_TCP) {
+      NODE_COUNT_NET_BYTES_SENT(bytes);
+    } else if (wrap->stream_->type == UV_NAMED_PIPE) {
+      NODE_COUNT_PIPE_BYTES_SENT(bytes);
+    }
+
+    return scope.Close(req_wrap->object_);
+  }
+}
+
+
+// sendFile(fd, offset, length) queues a segment of a file behind the writes
+// already on the stream. The caller keeps fd open until oncomplete.
+Handle<Value> StreamWrap::SendFile(const Arguments& args) {
+  HandleScope scope;
+
+  UNWRAP(StreamWrap)
+
+  if (args.Length() < 3)
+    return ThrowTypeError("Not enough arguments");
+
+  int fd = args[0]->Int32Value();
+  int64_t offset = args[1]->IntegerValue();
+  int64_t length = args[2]->IntegerValue();
+
+  if (fd < 0 || offset < 0 || length < 0)
+    return ThrowTypeError("Bad argument");
+
+  // The file data goes to the socket as is, which is only right when
+  // nothing transforms the stream (e.g. TLS).
+  if (wrap->callbacks_ != &wrap->default_callbacks_) {
+    uv_err_t err;
+    err.code = UV_ENOTSUP;
+    err.sys_errno_ = 0;
+    SetErrno(err);
+    return scope.Close(v8::Null());
+  }
+
+  char* storage = new char[sizeof(WriteWrap)];
+  WriteWrap* req_wrap = new (storage) WriteWrap();
+
+  int r = uv_write_sendfile(&req_wrap->req_,
+                            wrap->stream_,
+                            fd,
+                            offset,
+                            static_cast<size_t>(length),
+                            StreamWrap::AfterWrite);
+
+  req_wrap->Dispatched();
+  req_wrap->object_->Set(bytes_sym, Number::New(static_cast<double>(length)));
+
+  wrap->UpdateWriteQueueSize();
+
+  if (r) {
+    SetErrno(uv_last_error(uv_default_loop()));
+    req_wrap->~WriteWrap();
+    delete[] storage;
+    return scope.Close(v8::Null());
+  } else {
+    if (wrap->stream_->type == UV_TCP) {
+      NODE_COUNT_NET_BYTES_SENT(length);
+    } else if (wrap->stream_->type == UV_NAMED_PIPE) {
+      NODE_COUNT_PIPE_BYTES_SENT(length);
+    }
+
+    return scope.Close(req_wrap->object_);
+  }
+}
+
+
+// pipe(dest) moves everything read from this stream to `dest` without
+// calling into JS, until EOF or an error. The stream must not be reading.
+// When it's done, onpipe(status, bytes) is called on this handle; `dest` is
+// left open and is not shut down.
+Handle<Value> StreamWrap::Pipe(const Arguments& args) {
+  HandleScope scope;
+
+  UNWRAP(StreamWrap)
+
+  if (args.Length() < 1 || !args[0]->IsObject())
+    return ThrowTypeError("Bad argument");
+
+  Local<Object> dest_obj = args[0]->ToObject();
+  if (dest_obj->InternalFieldCount() == 0)
+    return ThrowTypeError("Bad argument");
+
+  HandleWrap* dest_handle_wrap = static_cast<HandleWrap*>(
+      dest_obj->GetPointerFromInternalField(0));
+  if (dest_handle_wrap == NULL)
+    return ThrowTypeError("Bad argument");
+
+  // GetHandle() is NULL once the handle has been closed.
+  uv_handle_t* dest_handle = dest_handle_wrap->GetHandle();
+  if (dest_handle == NULL)
+    return ThrowTypeError("Bad argument");
+  if (dest_handle->type != UV_TCP &&
+      dest_handle->type != UV_NAMED_PIPE &&
+      dest_handle->type != UV_TTY) {
+    return ThrowTypeError("Bad argument");
+  }
+
+  StreamWrap* dest = static_cast<StreamWrap*>(dest_handle_wrap);
+
+  // The bytes are moved as is, which is only right when neither stream
+  // transforms its data (e.g. TLS).
+  if (wrap->callbacks_ != &wrap->default_callbacks_ ||
+      dest->callbacks_ != &dest->default_callbacks_) {
+    uv_err_t err;
+    err.code = UV_ENOTSUP;
+    err.sys_errno_ = 0;
+    SetErrno(err);
+    return scope.Close(Integer::New(-1));
+  }
+
+  SpliceWrap* splice_wrap = new SpliceWrap(wrap->object_, dest->object_);
+
+  int r = uv_splice_start(&splice_wrap->req_,
+                          wrap->stream_,
+                          dest->stream_,
+                          StreamWrap::AfterPipe);
+
+  if (r) {
+    SetErrno(uv_last_error(uv_default_loop()));
+    delete splice_wrap;
+  }
+
+  return scope.Close(Integer::New(r));
+}
+
+
+void StreamWrap::AfterPipe(uv_splice_t* req, int status) {
+  SpliceWrap* splice_wrap = static_cast<SpliceWrap*>(req->data);
+
+  HandleScope scope;
+
+  if (status) {
+    SetErrno(uv_last_error(uv_default_loop()));
+  }
+
+  if (req->dst->type == UV_TCP) {
+    NODE_COUNT_NET_BYTES_SENT(req->nbytes);
+  } else if (req->dst->type == UV_NAMED_PIPE) {
+    NODE_COUNT_PIPE_BYTES_SENT(req->nbytes);
+  }
+
+  Local<Value> argv[] = {
+    Integer::New(status),
+    Number::New(static_cast<double>(req->nbytes))
+  };
+
+  MakeCallback(splice_wrap->src_, onpipe_sym, ARRAY_SIZE(argv), argv);
+
+  delete splice_wrap;
+}
+
+
 void StreamWrap::AfterWrite(uv_write_t* req, int status) {
   WriteWrap* req_wrap = (WriteWrap*) req->data;
   StreamWrap* wrap = (StreamWrap*) req->handle->data;
@@ -489,7 +717,7 @@ Handle<Value> StreamWrap::Shutdown(const Arguments& args) {
 
   ShutdownWrap* req_wrap = new ShutdownWrap();
 
-  int r = uv_shutdown(&req_wrap->req_, wrap->stream_, AfterShutdown);
+  int r = wrap->callbacks_->DoShutdown(req_wrap, AfterShutdown);
 
   req_wrap->Dispatched();
 
@@ -529,4 +757,85 @@ void StreamWrap::AfterShutdown(uv_shutdown_t* req, int status) {
 }
 
 
+int StreamWrapCallbacks::DoWrite(WriteWrap* w,
+                                 uv_buf_t* bufs,
+                                 size_t count,
+                                 uv_stream_t* send_handle,
+                                 uv_write_cb cb) {
+  if (send_handle == NULL)
+    return uv_write(&w->req_, wrap_->stream_, bufs, count, cb);
+
+  return uv_write2(&w->req_, wrap_->stream_, bufs, count, send_handle, cb);
+}
+
+
+void StreamWrapCallbacks::DoRead(uv_stream_t* handle,
+                                 ssize_t nread,
+                                 uv_buf_t buf,
+                                 uv_handle_type pending) {
+  HandleScope scope;
+
+  StreamWrap* wrap = wrap_;
+
+  if (nread < 0)  {
+    // If libuv reports an error or EOF it *may* give us a buffer back. In that
+    // case, return the space to the pool.
+    buffer_pool->Release(buf);
+
+    SetErrno(uv_last_error(uv_default_loop()));
+    MakeCallback(wrap->object_, onread_sym, 0, NULL);
+    return;
+  }
+
+  assert(buf.base != NULL);
+
+  if (nread == 0) {
+    buffer_pool->Release(buf);
+    return;
+  }
+  assert(static_cast<size_t>(nread) <= buf.len);
+
+  int argc = 3;
+  Local<Value> argv[4] = {
+    buffer_pool->ToBuffer(buf, nread),
+    Integer::NewFromUnsigned(0),
+    Integer::NewFromUnsigned(nread)
+  };
+
+  Local<Object> pending_obj;
+  if (pending == UV_TCP) {
+    pending_obj = AcceptHandle<TCPWrap, uv_tcp_t>(handle);
+  } else if (pending == UV_NAMED_PIPE) {
+    pending_obj = AcceptHandle<PipeWrap, uv_pipe_t>(handle);
+  } else if (pending == UV_UDP) {
+    pending_obj = AcceptHandle<UDPWrap, uv_udp_t>(handle);
+  } else {
+    assert(pending == UV_UNKNOWN_HANDLE);
+  }
+
+  if (!pending_obj.IsEmpty()) {
+    argv[3] = pending_obj;
+    argc++;
+  }
+
+  if (wrap->stream_->type == UV_TCP) {
+    NODE_COUNT_NET_BYTES_RECV(nread);
+  } else if (wrap->stream_->type == UV_NAMED_PIPE) {
+    NODE_COUNT_PIPE_BYTES_RECV(nread);
+  }
+
+  MakeCallback(wrap->object_, onread_sym, argc, argv);
+}
+
+
+int StreamWrapCallbacks::DoShutdown(ShutdownWrap* req_wrap, uv_shutdown_cb cb) {
+  return uv_shutdown(&req_wrap->req_, wrap_->stream_, cb);
+}
+
+
+size_t StreamWrapCallbacks::WriteQueueSize() {
+  return wrap_->stream_->write_queue_size;
+}
+
+
 }
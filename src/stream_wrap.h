@@ -25,13 +25,70 @@
 #include "v8.h"
 #include "node.h"
 #include "handle_wrap.h"
+#include "req_wrap.h"
 #include "string_bytes.h"
 
 namespace node {
 
+// Forward declaration
+class StreamWrap;
+
+typedef class ReqWrap<uv_shutdown_t> ShutdownWrap;
+
+class WriteWrap: public ReqWrap<uv_write_t> {
+ public:
+  void* operator new(size_t size, char* storage) { return storage; }
+
+  // This is just to keep the compiler happy. It should never be called, since
+  // we don't use exceptions in node.
+  void operator delete(void* ptr, char* storage) { assert(0); }
+
+ protected:
+  // People should not be using the non-placement new and delete operator on a
+  // WriteWrap. Ensure this never happens.
+  void* operator new (size_t size) { assert(0); };
+  void operator delete(void* ptr) { assert(0); };
+};
+
+
+// The I/O a StreamWrap does on its uv_stream_t. The default implementation
+// talks to libuv directly; a wrap can be given another implementation that
+// transforms the data on its way to and from the stream (see tls_wrap.h).
+class StreamWrapCallbacks {
+ public:
+  explicit StreamWrapCallbacks(StreamWrap* wrap) : wrap_(wrap) {
+  }
+
+  virtual ~StreamWrapCallbacks() {
+  }
+
+  // Must eventually call `cb` with `&w->req_`, and never synchronously.
+  virtual int DoWrite(WriteWrap* w,
+                      uv_buf_t* bufs,
+                      size_t count,
+                      uv_stream_t* send_handle,
+                      uv_write_cb cb);
+  virtual void DoRead(uv_stream_t* handle,
+                      ssize_t nread,
+                      uv_buf_t buf,
+                      uv_handle_type pending);
+  virtual int DoShutdown(ShutdownWrap* req_wrap, uv_shutdown_cb cb);
+
+  // Bytes accepted by DoWrite() that have not been written out yet.
+  virtual size_t WriteQueueSize();
+
+ protected:
+  StreamWrap* wrap_;
+};
+
+
 class StreamWrap : public HandleWrap {
  public:
   uv_stream_t* GetStream() { return stream_; }
+  v8::Handle<v8::Object> GetObject() { return object_; }
+
+  // Takes ownership of `callbacks`.
+  void OverrideCallbacks(StreamWrapCallbacks* callbacks);
 
   static void Initialize(v8::Handle<v8::Object> target);
 
@@ -47,9 +104,13 @@ class StreamWrap : public HandleWrap {
   static v8::Handle<v8::Value> WriteAsciiString(const v8::Arguments& args);
   static v8::Handle<v8::Value> WriteUtf8String(const v8::Arguments& args);
   static v8::Handle<v8::Value> WriteUcs2String(const v8::Arguments& args);
+  static v8::Handle<v8::Value> Writev(const v8::Arguments& args);
+  static v8::Handle<v8::Value> SendFile(const v8::Arguments& args);
+  static v8::Handle<v8::Value> Pipe(const v8::Arguments& args);
 
  protected:
   StreamWrap(v8::Handle<v8::Object> object, uv_stream_t* stream);
+  virtual ~StreamWrap();
   virtual void SetHandle(uv_handle_t* h);
   void StateChange() { }
   void UpdateWriteQueueSize();
@@ -59,6 +120,7 @@ class StreamWrap : public HandleWrap {
 
   // Callbacks for libuv
   static void AfterWrite(uv_write_t* req, int status);
+  static void AfterPipe(uv_splice_t* req, int status);
   static uv_buf_t OnAlloc(uv_handle_t* handle, size_t suggested_size);
   static void AfterShutdown(uv_shutdown_t* req, int status);
 
@@ -73,6 +135,11 @@ class StreamWrap : public HandleWrap {
 
   size_t slab_offset_;
   uv_stream_t* stream_;
+
+  StreamWrapCallbacks default_callbacks_;
+  StreamWrapCallbacks* callbacks_;
+
+  friend class StreamWrapCallbacks;
 };
 
 
@@ -32,6 +32,7 @@
 namespace node {
 
 using v8::Arguments;
+using v8::Array;
 using v8::Context;
 using v8::Function;
 using v8::FunctionTemplate;
@@ -48,6 +49,9 @@ using v8::TryCatch;
 using v8::Undefined;
 using v8::Value;
 
+// bind(ip, port, flags) flag bits; lib/net.js keeps a copy of these.
+static const unsigned kBindReusePort = 1;
+
 static Persistent<Function> tcpConstructor;
 static Persistent<String> oncomplete_sym;
 static Persistent<String> onconnection_sym;
@@ -103,6 +107,9 @@ void TCPWrap::Initialize(Handle<Object> target) {
   NODE_SET_PROTOTYPE_METHOD(t, "writeAsciiString", StreamWrap::WriteAsciiString);
   NODE_SET_PROTOTYPE_METHOD(t, "writeUtf8String", StreamWrap::WriteUtf8String);
   NODE_SET_PROTOTYPE_METHOD(t, "writeUcs2String", StreamWrap::WriteUcs2String);
+  NODE_SET_PROTOTYPE_METHOD(t, "writev", StreamWrap::Writev);
+  NODE_SET_PROTOTYPE_METHOD(t, "sendFile", StreamWrap::SendFile);
+  NODE_SET_PROTOTYPE_METHOD(t, "pipe", StreamWrap::Pipe);
 
   NODE_SET_PROTOTYPE_METHOD(t, "open", Open);
   NODE_SET_PROTOTYPE_METHOD(t, "bind", Bind);
@@ -273,9 +280,16 @@ Handle<Value> TCPWrap::Bind(const Arguments& args) {
 
   String::AsciiValue ip_address(args[0]);
   int port = args[1]->Int32Value();
+  const unsigned flags = args[2]->Uint32Value();
 
-  struct sockaddr_in address = uv_ip4_addr(*ip_address, port);
-  int r = uv_tcp_bind(&wrap->handle_, address);
+  int r = 0;
+  if (flags & kBindReusePort)
+    r = uv_tcp_reuseport(&wrap->handle_, 1);
+
+  if (r == 0) {
+    struct sockaddr_in address = uv_ip4_addr(*ip_address, port);
+    r = uv_tcp_bind(&wrap->handle_, address);
+  }
 
   // Error starting the tcp.
   if (r) SetErrno(uv_last_error(uv_default_loop()));
@@ -291,9 +305,16 @@ Handle<Value> TCPWrap::Bind6(const Arguments& args) {
 
   String::AsciiValue ip6_address(args[0]);
   int port = args[1]->Int32Value();
+  const unsigned flags = args[2]->Uint32Value();
 
-  struct sockaddr_in6 address = uv_ip6_addr(*ip6_address, port);
-  int r = uv_tcp_bind6(&wrap->handle_, address);
+  int r = 0;
+  if (flags & kBindReusePort)
+    r = uv_tcp_reuseport(&wrap->handle_, 1);
+
+  if (r == 0) {
+    struct sockaddr_in6 address = uv_ip6_addr(*ip6_address, port);
+    r = uv_tcp_bind6(&wrap->handle_, address);
+  }
 
   // Error starting the tcp.
   if (r) SetErrno(uv_last_error(uv_default_loop()));
@@ -308,8 +329,22 @@ Handle<Value> TCPWrap::Listen(const Arguments& args) {
   UNWRAP(TCPWrap)
 
   int backlog = args[0]->Int32Value();
+  unsigned int batch = args[1]->Uint32Value();
+
+  // listen(backlog, batch) with batch > 1 accepts up to batch connections
+  // per wakeup and reports them in one onconnection call. Fall back to
+  // one call per connection where that isn't supported.
+  int r = -1;
+  if (batch > 1) {
+    if (batch > UV_TCP_ACCEPT_BATCH_MAX) batch = UV_TCP_ACCEPT_BATCH_MAX;
+    r = uv_tcp_listen_batch(&wrap->handle_, backlog, batch, OnConnectionBatch);
+    if (r && uv_last_error(uv_default_loop()).code != UV_ENOSYS) {
+      SetErrno(uv_last_error(uv_default_loop()));
+      return scope.Close(Integer::New(r));
+    }
+  }
 
-  int r = uv_listen((uv_stream_t*)&wrap->handle_, backlog, OnConnection);
+  if (r) r = uv_listen((uv_stream_t*)&wrap->handle_, backlog, OnConnection);
 
   // Error starting the tcp.
   if (r) SetErrno(uv_last_error(uv_default_loop()));
@@ -352,6 +387,46 @@ void TCPWrap::OnConnection(uv_stream_t* handle, int status) {
 }
 
 
+void TCPWrap::OnConnectionBatch(uv_tcp_t* handle, int count, int pending) {
+  HandleScope scope;
+
+  TCPWrap* wrap = static_cast<TCPWrap*>(handle->data);
+  assert(&wrap->handle_ == handle);
+  assert(wrap->object_.IsEmpty() == false);
+
+  if (count < 0) {
+    SetErrno(uv_last_error(uv_default_loop()));
+    Local<Value> argv[1] = { Local<Value>::New(Null()) };
+    MakeCallback(wrap->object_, onconnection_sym, ARRAY_SIZE(argv), argv);
+    return;
+  }
+
+  Local<Array> clients = Array::New(count);
+  int accepted = 0;
+
+  for (int i = 0; i < count; i++) {
+    Local<Object> client_obj = Instantiate();
+    assert(client_obj->InternalFieldCount() > 0);
+    TCPWrap* client_wrap = static_cast<TCPWrap*>(
+        client_obj->GetPointerFromInternalField(0));
+
+    if (uv_accept((uv_stream_t*)handle, (uv_stream_t*)&client_wrap->handle_))
+      break;
+
+    clients->Set(accepted++, client_obj);
+  }
+
+  if (accepted == 0) return;
+  if (accepted < count)
+    clients->Set(String::NewSymbol("length"), Integer::New(accepted));
+
+  // onconnection(clients, pending): pending is what is left in the kernel's
+  // accept queue after this batch, -1 when the platform can't tell.
+  Local<Value> argv[2] = { clients, Integer::New(pending) };
+  MakeCallback(wrap->object_, onconnection_sym, ARRAY_SIZE(argv), argv);
+}
+
+
 void TCPWrap::AfterConnect(uv_connect_t* req, int status) {
   ConnectWrap* req_wrap = (ConnectWrap*) req->data;
   TCPWrap* wrap = (TCPWrap*) req->handle->data;
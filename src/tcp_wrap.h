@@ -54,6 +54,7 @@ class TCPWrap : public StreamWrap {
 #endif
 
   static void OnConnection(uv_stream_t* handle, int status);
+  static void OnConnectionBatch(uv_tcp_t* handle, int count, int pending);
   static void AfterConnect(uv_connect_t* req, int status);
 
   uv_tcp_t handle_;
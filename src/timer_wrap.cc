@@ -21,6 +21,7 @@
 
 #include "node.h"
 #include "handle_wrap.h"
+#include "node_object_wrap.h"
 
 namespace node {
 
@@ -40,6 +41,13 @@ using v8::Integer;
 
 static Persistent<String> ontimeout_sym;
 
+// Tick length of the timing wheel that drives WheelTimer, in milliseconds.
+// The wheel only wakes up when a timer is due or a slot must be cascaded, so
+// a fine tick costs nothing while the wheel is quiet.
+static const uint64_t kWheelResolution = 1;
+
+static uv_timer_wheel_t* wheel;
+
 class TimerWrap : public HandleWrap {
  public:
   static void Initialize(Handle<Object> target) {
@@ -167,6 +175,103 @@ class TimerWrap : public HandleWrap {
 };
 
 
+// A timer on the loop's timing wheel. Starting and restarting is O(1) and
+// needs no libuv handle per timer, which makes it the right fit for the
+// idle timeouts of many sockets. Pending WheelTimers don't keep the event
+// loop alive.
+class WheelTimer : public ObjectWrap {
+ public:
+  static void Initialize(Handle<Object> target) {
+    HandleScope scope;
+
+    Local<FunctionTemplate> constructor = FunctionTemplate::New(New);
+    constructor->InstanceTemplate()->SetInternalFieldCount(1);
+    constructor->SetClassName(String::NewSymbol("WheelTimer"));
+
+    NODE_SET_PROTOTYPE_METHOD(constructor, "start", Start);
+    NODE_SET_PROTOTYPE_METHOD(constructor, "stop", Stop);
+
+    target->Set(String::NewSymbol("WheelTimer"), constructor->GetFunction());
+  }
+
+ private:
+  static Handle<Value> New(const Arguments& args) {
+    assert(args.IsConstructCall());
+
+    HandleScope scope;
+
+    if (wheel == NULL) {
+      wheel = new uv_timer_wheel_t;
+      int r = uv_timer_wheel_init(uv_default_loop(), wheel, kWheelResolution);
+      assert(r == 0);
+      uv_unref(reinterpret_cast<uv_handle_t*>(&wheel->timer));
+    }
+
+    WheelTimer* timer = new WheelTimer();
+    timer->Wrap(args.This());
+
+    return scope.Close(args.This());
+  }
+
+  WheelTimer() {
+    uv_wheel_timer_init(wheel, &timer_);
+    timer_.data = this;
+  }
+
+  ~WheelTimer() {
+    // An active timer holds a reference, it can't be collected.
+    assert(!uv_wheel_timer_is_active(&timer_));
+  }
+
+  // start(msecs), restarts the timer if it's already running.
+  static Handle<Value> Start(const Arguments& args) {
+    HandleScope scope;
+
+    WheelTimer* timer = ObjectWrap::Unwrap<WheelTimer>(args.This());
+    int64_t timeout = args[0]->IntegerValue();
+    if (timeout < 0) timeout = 0;
+
+    if (!uv_wheel_timer_is_active(&timer->timer_))
+      timer->Ref();
+
+    uv_wheel_timer_start(&timer->timer_, OnTimeout, timeout);
+
+    return scope.Close(Integer::New(0));
+  }
+
+  static Handle<Value> Stop(const Arguments& args) {
+    HandleScope scope;
+
+    WheelTimer* timer = ObjectWrap::Unwrap<WheelTimer>(args.This());
+
+    if (uv_wheel_timer_is_active(&timer->timer_)) {
+      uv_wheel_timer_stop(&timer->timer_);
+      timer->Unref();
+    }
+
+    return scope.Close(Integer::New(0));
+  }
+
+  static void OnTimeout(uv_wheel_timer_t* handle) {
+    HandleScope scope;
+
+    WheelTimer* timer = static_cast<WheelTimer*>(handle->data);
+    Local<Object> object = Local<Object>::New(timer->handle_);
+    timer->Unref();
+
+    MakeCallback(object, ontimeout_sym, 0, NULL);
+  }
+
+  uv_wheel_timer_t timer_;
+};
+
+
+static void InitializeTimerWrap(Handle<Object> target) {
+  TimerWrap::Initialize(target);
+  WheelTimer::Initialize(target);
+}
+
+
 }  // namespace node
 
-NODE_MODULE(node_timer_wrap, node::TimerWrap::Initialize)
+NODE_MODULE(node_timer_wrap, node::InitializeTimerWrap)
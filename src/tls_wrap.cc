@@ -0,0 +1,536 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "node.h"
+#include "node_buffer.h"
+#include "node_internals.h"
+#include "tls_wrap.h"
+#include "buffer_pool.h"
+#include "req_wrap.h"
+
+#include <string.h> // memcpy, memmove
+
+
+namespace node {
+
+using v8::Arguments;
+using v8::External;
+using v8::Handle;
+using v8::HandleScope;
+using v8::Integer;
+using v8::Local;
+using v8::Null;
+using v8::Object;
+using v8::Persistent;
+using v8::String;
+using v8::Undefined;
+using v8::Value;
+
+static Persistent<String> onread_sym;
+static Persistent<String> onsecure_sym;
+static Persistent<String> onerror_sym;
+static Persistent<String> error_sym;
+static Persistent<String> tls_callbacks_sym;
+static BufferPool* buffer_pool;
+
+
+TLSCallbacks::TLSCallbacks(StreamWrap* wrap,
+                           crypto::Connection* conn,
+                           Handle<Object> conn_obj)
+    : StreamWrapCallbacks(wrap),
+      conn_(conn),
+      enc_pending_(NULL),
+      enc_pending_len_(0),
+      pending_bytes_(0),
+      enc_writes_(0),
+      shutdown_req_(NULL),
+      shutdown_cb_(NULL),
+      established_(false),
+      eof_(false),
+      cycling_(false) {
+  conn_obj_ = Persistent<Object>::New(conn_obj);
+  ngx_queue_init(&pending_writes_);
+  ngx_queue_init(&written_);
+}
+
+
+TLSCallbacks::~TLSCallbacks() {
+  // The stream is gone. Writes that never made it to libuv are dropped
+  // without a callback, just like the JS side drops them on close.
+  while (!ngx_queue_empty(&pending_writes_)) {
+    ngx_queue_t* q = ngx_queue_head(&pending_writes_);
+    ngx_queue_remove(q);
+    ngx_queue_insert_tail(&written_, q);
+  }
+
+  while (!ngx_queue_empty(&written_)) {
+    ngx_queue_t* q = ngx_queue_head(&written_);
+    ngx_queue_remove(q);
+
+    WriteItem* item = ngx_queue_data(q, WriteItem, member);
+    item->w->~WriteWrap();
+    delete[] reinterpret_cast<char*>(item->w);
+    delete[] item->bufs;
+    delete item;
+  }
+
+  delete shutdown_req_;
+  shutdown_req_ = NULL;
+
+  delete[] enc_pending_;
+  enc_pending_ = NULL;
+
+  conn_obj_.Dispose();
+  conn_obj_.Clear();
+}
+
+
+bool TLSCallbacks::IsClosing() {
+  return wrap_->GetHandle() == NULL;
+}
+
+
+int TLSCallbacks::DoWrite(WriteWrap* w,
+                          uv_buf_t* bufs,
+                          size_t count,
+                          uv_stream_t* send_handle,
+                          uv_write_cb cb) {
+  assert(send_handle == NULL);
+
+  WriteItem* item = new WriteItem;
+  item->w = w;
+  item->cb = cb;
+  item->bufs = new uv_buf_t[count];
+  item->count = count;
+  item->index = 0;
+  item->bytes = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    item->bufs[i] = bufs[i];
+    item->bytes += bufs[i].len;
+  }
+
+  pending_bytes_ += item->bytes;
+  ngx_queue_insert_tail(&pending_writes_, &item->member);
+
+  // Errors are left on the Connection and reported by the next Cycle(),
+  // we are called from JS and must not call back into it here.
+  ClearIn();
+  if (enc_writes_ == 0) EncOut();
+
+  return 0;
+}
+
+
+void TLSCallbacks::DoRead(uv_stream_t* handle,
+                          ssize_t nread,
+                          uv_buf_t buf,
+                          uv_handle_type pending) {
+  if (nread < 0) {
+    if (eof_) {
+      buffer_pool->Release(buf);
+      return;
+    }
+    eof_ = true;
+
+    uv_err_t err = uv_last_error(uv_default_loop());
+    if (!established_ && err.code == UV_EOF) {
+      // The peer went away during the handshake. Report it as an SSL error
+      // so that it surfaces like it does for a SecurePair.
+      buffer_pool->Release(buf);
+
+      HandleScope scope;
+      MakeCallback(conn_obj_, onerror_sym, 0, NULL);
+      return;
+    }
+
+    StreamWrapCallbacks::DoRead(handle, nread, buf, pending);
+    return;
+  }
+
+  if (nread == 0 || eof_ || conn_->ssl_ == NULL) {
+    buffer_pool->Release(buf);
+    return;
+  }
+
+  char* data = buf.base;
+  size_t len = nread;
+
+  // Feeding the ClientHello parser may call into JS, which must not start
+  // another cycle underneath us.
+  cycling_ = true;
+
+  if (enc_pending_len_ == 0) {
+    while (len > 0) {
+      int written = conn_->DoEncIn(data, len);
+      if (written <= 0) break;
+      data += written;
+      len -= written;
+    }
+  }
+
+  // Whatever the parser did not take waits until the session is resumed.
+  if (len > 0) {
+    char* enc_pending = new char[enc_pending_len_ + len];
+    if (enc_pending_len_ > 0)
+      memcpy(enc_pending, enc_pending_, enc_pending_len_);
+    memcpy(enc_pending + enc_pending_len_, data, len);
+    delete[] enc_pending_;
+    enc_pending_ = enc_pending;
+    enc_pending_len_ += len;
+  }
+
+  cycling_ = false;
+
+  buffer_pool->Release(buf);
+
+  Cycle();
+}
+
+
+int TLSCallbacks::DoShutdown(ShutdownWrap* req_wrap, uv_shutdown_cb cb) {
+  assert(shutdown_req_ == NULL);
+
+  // close_notify must not overtake queued cleartext, so hold the shutdown
+  // back until everything has gone through SSL_write().
+  if (!ngx_queue_empty(&pending_writes_)) {
+    shutdown_req_ = req_wrap;
+    shutdown_cb_ = cb;
+    return 0;
+  }
+
+  if (established_) conn_->DoShutdown();
+  EncOut();
+
+  return uv_shutdown(&req_wrap->req_, wrap_->GetStream(), cb);
+}
+
+
+size_t TLSCallbacks::WriteQueueSize() {
+  return StreamWrapCallbacks::WriteQueueSize() + pending_bytes_;
+}
+
+
+void TLSCallbacks::Cycle() {
+  if (cycling_ || conn_->ssl_ == NULL) return;
+  cycling_ = true;
+
+  EncIn();
+  ClearOut();
+
+  if (!IsClosing()) {
+    ClearIn();
+    if (enc_writes_ == 0) EncOut();
+  }
+
+  cycling_ = false;
+}
+
+
+void TLSCallbacks::EncIn() {
+  while (enc_pending_len_ > 0) {
+    int written = conn_->DoEncIn(enc_pending_, enc_pending_len_);
+    if (written <= 0) return;
+
+    enc_pending_len_ -= written;
+    memmove(enc_pending_, enc_pending_ + written, enc_pending_len_);
+  }
+}
+
+
+void TLSCallbacks::ClearOut() {
+  if (eof_) return;
+
+  HandleScope scope;
+
+  for (;;) {
+    uv_buf_t buf = buffer_pool->Allocate(kClearOutChunkSize);
+    int read = conn_->DoClearOut(buf.base, buf.len);
+
+    if (!established_ && SSL_is_init_finished(conn_->ssl_)) {
+      established_ = true;
+      MakeCallback(conn_obj_, onsecure_sym, 0, NULL);
+      if (IsClosing()) {
+        buffer_pool->Release(buf);
+        return;
+      }
+    }
+
+    if (read <= 0) {
+      buffer_pool->Release(buf);
+      break;
+    }
+
+    Local<Value> argv[3] = {
+      buffer_pool->ToBuffer(buf, read),
+      Integer::NewFromUnsigned(0),
+      Integer::NewFromUnsigned(read)
+    };
+    MakeCallback(wrap_->GetObject(), onread_sym, ARRAY_SIZE(argv), argv);
+
+    if (IsClosing()) return;
+  }
+
+  if (CheckError()) return;
+
+  // close_notify from the peer ends the cleartext stream.
+  if (SSL_get_shutdown(conn_->ssl_) & SSL_RECEIVED_SHUTDOWN) {
+    eof_ = true;
+
+    uv_err_t err;
+    err.code = UV_EOF;
+    SetErrno(err);
+    MakeCallback(wrap_->GetObject(), onread_sym, 0, NULL);
+  }
+}
+
+
+void TLSCallbacks::ClearIn() {
+  // Cleartext is held back until the handshake is done.
+  if (!established_) return;
+
+  while (!ngx_queue_empty(&pending_writes_)) {
+    ngx_queue_t* q = ngx_queue_head(&pending_writes_);
+    WriteItem* item = ngx_queue_data(q, WriteItem, member);
+
+    for (; item->index < item->count; item->index++) {
+      uv_buf_t* buf = &item->bufs[item->index];
+      if (buf->len == 0) continue;
+
+      // The memory BIO grows as needed, so SSL_write() is all or nothing.
+      // It only fails while a renegotiation is waiting for the peer, the
+      // next Cycle() picks up where we left off.
+      int written = conn_->DoClearIn(buf->base, buf->len);
+      if (written <= 0) return;
+
+      assert(static_cast<size_t>(written) == buf->len);
+    }
+
+    ngx_queue_remove(q);
+    ngx_queue_insert_tail(&written_, q);
+  }
+
+  MaybeShutdown();
+}
+
+
+void TLSCallbacks::EncOut() {
+  if (IsClosing()) return;
+
+  int pending = BIO_pending(conn_->bio_write_);
+  if (pending <= 0 && ngx_queue_empty(&written_)) return;
+  if (pending < 0) pending = 0;
+
+  char* storage = new char[sizeof(EncWrite) + pending];
+  EncWrite* enc_write = reinterpret_cast<EncWrite*>(storage);
+  char* data = storage + sizeof(EncWrite);
+
+  enc_write->callbacks = this;
+  ngx_queue_init(&enc_write->items);
+
+  int bytes = 0;
+  if (pending > 0) {
+    bytes = conn_->DoEncOut(data, pending);
+    if (bytes < 0) bytes = 0;
+  }
+
+  // Writes whose records are in this chunk complete when it does. Writes
+  // that produced no output at all still go through uv_write(), so that
+  // their callbacks are never made synchronously.
+  if (!ngx_queue_empty(&written_)) {
+    ngx_queue_t* q;
+    ngx_queue_foreach(q, &written_) {
+      pending_bytes_ -= ngx_queue_data(q, WriteItem, member)->bytes;
+    }
+    ngx_queue_add(&enc_write->items, &written_);
+    ngx_queue_init(&written_);
+  }
+
+  uv_buf_t buf = uv_buf_init(data, bytes);
+  int r = uv_write(&enc_write->req,
+                   wrap_->GetStream(),
+                   &buf,
+                   1,
+                   AfterEncWrite);
+
+  if (r) {
+    // The stream is going away, the items are freed along with us.
+    if (!ngx_queue_empty(&enc_write->items)) {
+      ngx_queue_add(&written_, &enc_write->items);
+    }
+    delete[] storage;
+    return;
+  }
+
+  enc_writes_++;
+}
+
+
+void TLSCallbacks::AfterEncWrite(uv_write_t* req, int status) {
+  EncWrite* enc_write = reinterpret_cast<EncWrite*>(req);
+  TLSCallbacks* callbacks = enc_write->callbacks;
+
+  HandleScope scope;
+
+  callbacks->enc_writes_--;
+
+  while (!ngx_queue_empty(&enc_write->items)) {
+    ngx_queue_t* q = ngx_queue_head(&enc_write->items);
+    ngx_queue_remove(q);
+    callbacks->CompleteItem(ngx_queue_data(q, WriteItem, member), status);
+  }
+
+  delete[] reinterpret_cast<char*>(enc_write);
+
+  // Flush what accumulated while this write was in flight.
+  if (status == 0 && callbacks->enc_writes_ == 0) callbacks->EncOut();
+}
+
+
+void TLSCallbacks::CompleteItem(WriteItem* item, int status) {
+  WriteWrap* w = item->w;
+  uv_write_cb cb = item->cb;
+
+  delete[] item->bufs;
+  delete item;
+
+  w->req_.handle = wrap_->GetStream();
+  cb(&w->req_, status);
+}
+
+
+void TLSCallbacks::MaybeShutdown() {
+  if (shutdown_req_ == NULL || !ngx_queue_empty(&pending_writes_)) return;
+
+  ShutdownWrap* req_wrap = shutdown_req_;
+  shutdown_req_ = NULL;
+
+  if (established_) conn_->DoShutdown();
+  EncOut();
+
+  if (IsClosing() ||
+      uv_shutdown(&req_wrap->req_, wrap_->GetStream(), shutdown_cb_)) {
+    delete req_wrap;
+  }
+}
+
+
+bool TLSCallbacks::CheckError() {
+  HandleScope scope;
+
+  Local<Value> err = conn_obj_->Get(error_sym);
+  if (!err->BooleanValue()) return false;
+
+  // Nothing but the error reaches JS once SSL has failed.
+  conn_obj_->Set(error_sym, Null());
+  eof_ = true;
+
+  Local<Value> argv[1] = { err };
+  MakeCallback(conn_obj_, onerror_sym, ARRAY_SIZE(argv), argv);
+
+  return true;
+}
+
+
+Handle<Value> TLSCallbacks::Wrap(const Arguments& args) {
+  HandleScope scope;
+
+  if (args.Length() < 2 || !args[0]->IsObject())
+    return ThrowTypeError("First argument must be a stream handle");
+
+  Local<Object> handle_obj = args[0]->ToObject();
+  if (handle_obj->InternalFieldCount() == 0)
+    return ThrowTypeError("First argument must be a stream handle");
+
+  HandleWrap* handle_wrap = static_cast<HandleWrap*>(
+      handle_obj->GetPointerFromInternalField(0));
+  if (handle_wrap == NULL || handle_wrap->GetHandle() == NULL)
+    return ThrowTypeError("Stream handle is closed");
+
+  uv_handle_t* handle = handle_wrap->GetHandle();
+  if (handle->type != UV_TCP &&
+      handle->type != UV_NAMED_PIPE &&
+      handle->type != UV_TTY) {
+    return ThrowTypeError("First argument must be a stream handle");
+  }
+
+  // Replacing the callbacks would free the ones that in-flight encrypted
+  // writes still point to.
+  if (!handle_obj->GetHiddenValue(tls_callbacks_sym).IsEmpty())
+    return ThrowTypeError("Stream handle is already wrapped");
+
+  StreamWrap* wrap = static_cast<StreamWrap*>(handle_wrap);
+
+  crypto::Connection* conn = crypto::Connection::FromValue(args[1]);
+  if (conn == NULL || conn->ssl_ == NULL)
+    return ThrowTypeError("Second argument must be an open Connection");
+
+  TLSCallbacks* callbacks = new TLSCallbacks(wrap, conn, args[1]->ToObject());
+  wrap->OverrideCallbacks(callbacks);
+  handle_obj->SetHiddenValue(tls_callbacks_sym, External::New(callbacks));
+
+  // Clients send their ClientHello right away.
+  callbacks->Cycle();
+
+  return Undefined();
+}
+
+
+Handle<Value> TLSCallbacks::Cycle(const Arguments& args) {
+  HandleScope scope;
+
+  if (args.Length() < 1 || !args[0]->IsObject())
+    return ThrowTypeError("First argument must be a stream handle");
+
+  Local<Object> handle_obj = args[0]->ToObject();
+  Local<Value> callbacks = handle_obj->GetHiddenValue(tls_callbacks_sym);
+  if (callbacks.IsEmpty() || !callbacks->IsExternal())
+    return ThrowTypeError("Stream handle is not wrapped");
+
+  // The callbacks die with the handle.
+  if (handle_obj->GetPointerFromInternalField(0) == NULL)
+    return Undefined();
+
+  static_cast<TLSCallbacks*>(callbacks.As<External>()->Value())->Cycle();
+
+  return Undefined();
+}
+
+
+void TLSCallbacks::Initialize(Handle<Object> target) {
+  HandleScope scope;
+
+  buffer_pool = BufferPool::GetDefault();
+
+  onread_sym = NODE_PSYMBOL("onread");
+  onsecure_sym = NODE_PSYMBOL("onsecure");
+  onerror_sym = NODE_PSYMBOL("onerror");
+  error_sym = NODE_PSYMBOL("error");
+  tls_callbacks_sym = NODE_PSYMBOL("tlsCallbacks");
+
+  NODE_SET_METHOD(target, "wrap", Wrap);
+  NODE_SET_METHOD(target, "cycle", Cycle);
+}
+
+
+}  // namespace node
+
+NODE_MODULE(node_tls_wrap, node::TLSCallbacks::Initialize)
@@ -0,0 +1,127 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef TLS_WRAP_H_
+#define TLS_WRAP_H_
+
+#include "v8.h"
+#include "node.h"
+#include "stream_wrap.h"
+#include "node_crypto.h"
+#include "ngx-queue.h"
+
+namespace node {
+
+// Runs a crypto::Connection directly on the uv_stream_t of a StreamWrap.
+//
+// Encrypted data read from the socket goes straight into the SSL object and
+// only cleartext is handed to the onread callback of the wrap. Writes are
+// encrypted in place and coalesced into one uv_write() per flush, so JS
+// never sees the encrypted side of the connection. Handshake completion and
+// SSL errors are reported through the onsecure and onerror callbacks of the
+// Connection object.
+class TLSCallbacks : public StreamWrapCallbacks {
+ public:
+  TLSCallbacks(StreamWrap* wrap,
+               crypto::Connection* conn,
+               v8::Handle<v8::Object> conn_obj);
+  virtual ~TLSCallbacks();
+
+  int DoWrite(WriteWrap* w,
+              uv_buf_t* bufs,
+              size_t count,
+              uv_stream_t* send_handle,
+              uv_write_cb cb);
+  void DoRead(uv_stream_t* handle,
+              ssize_t nread,
+              uv_buf_t buf,
+              uv_handle_type pending);
+  int DoShutdown(ShutdownWrap* req_wrap, uv_shutdown_cb cb);
+  size_t WriteQueueSize();
+
+  // Moves data through the SSL object: pending encrypted input, cleartext
+  // output, queued cleartext writes and finally encrypted output.
+  void Cycle();
+
+  static void Initialize(v8::Handle<v8::Object> target);
+
+ private:
+  // Cleartext write that has not been completed yet.
+  struct WriteItem {
+    WriteWrap* w;
+    uv_write_cb cb;
+    uv_buf_t* bufs;
+    size_t count;
+    size_t index;
+    size_t bytes;
+    ngx_queue_t member;
+  };
+
+  // Encrypted write, completes the WriteItems that went into it.
+  struct EncWrite {
+    uv_write_t req;
+    TLSCallbacks* callbacks;
+    ngx_queue_t items;
+  };
+
+  static const size_t kClearOutChunkSize = 16384;
+
+  void EncIn();
+  void ClearOut();
+  void ClearIn();
+  void EncOut();
+  void MaybeShutdown();
+  bool CheckError();
+  bool IsClosing();
+  void CompleteItem(WriteItem* item, int status);
+
+  static void AfterEncWrite(uv_write_t* req, int status);
+  static v8::Handle<v8::Value> Wrap(const v8::Arguments& args);
+  static v8::Handle<v8::Value> Cycle(const v8::Arguments& args);
+
+  crypto::Connection* conn_;
+  v8::Persistent<v8::Object> conn_obj_;
+
+  // Encrypted input the ClientHello parser has not accepted yet.
+  char* enc_pending_;
+  size_t enc_pending_len_;
+
+  // Cleartext writes not yet passed through SSL_write().
+  ngx_queue_t pending_writes_;
+  // Encrypted but not yet flushed to the stream.
+  ngx_queue_t written_;
+  // Bytes of the writes in both queues.
+  size_t pending_bytes_;
+  // Encrypted writes in flight. While there are any, output accumulates in
+  // the BIO and goes out in one piece once they are done.
+  unsigned int enc_writes_;
+
+  ShutdownWrap* shutdown_req_;
+  uv_shutdown_cb shutdown_cb_;
+
+  bool established_;
+  bool eof_;
+  bool cycling_;
+};
+
+}  // namespace node
+
+#endif  // TLS_WRAP_H_
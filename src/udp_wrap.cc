@@ -21,20 +21,20 @@
 
 #include "node.h"
 #include "node_buffer.h"
-#include "slab_allocator.h"
+#include "buffer_pool.h"
 #include "req_wrap.h"
 #include "handle_wrap.h"
 #include "udp_wrap.h"
 
 #include <stdlib.h>
-
-#define SLAB_SIZE (1024 * 1024)
+#include <string.h>
 
 
 namespace node {
 
 using v8::AccessorInfo;
 using v8::Arguments;
+using v8::Array;
 using v8::False;
 using v8::Function;
 using v8::FunctionTemplate;
@@ -52,6 +52,31 @@ using v8::Value;
 
 typedef ReqWrap<uv_udp_send_t> SendWrap;
 
+// One request object for all datagrams of a sendBatch() call. oncomplete
+// fires once, after the last datagram has been handed to the kernel.
+struct SendBatchReq {
+  void* data;  // set by ReqWrap::Dispatched()
+  uv_udp_send_t* reqs;
+  unsigned int pending;
+  int status;
+  uv_err_t error;
+};
+
+typedef ReqWrap<SendBatchReq> SendBatchWrap;
+
+// Datagrams of a batched receive land in fixed-size slots of `slab` and are
+// packed into a single Buffer when libuv signals the end of the batch.
+struct UDPWrap::RecvBatch {
+  static const size_t kSlotSize = 65536;
+
+  char* slab;
+  unsigned int size;
+  unsigned int next_slot;
+  unsigned int count;
+  uv_buf_t bufs[UV_UDP_BATCH_MAX];
+  struct sockaddr_storage addrs[UV_UDP_BATCH_MAX];
+};
+
 // see tcp_wrap.cc
 Local<Object> AddressToJS(const sockaddr* addr);
 
@@ -59,17 +84,14 @@ static Persistent<Function> constructor;
 static Persistent<String> buffer_sym;
 static Persistent<String> oncomplete_sym;
 static Persistent<String> onmessage_sym;
-static SlabAllocator* slab_allocator;
-
-
-static void DeleteSlabAllocator(void*) {
-  delete slab_allocator;
-  slab_allocator = NULL;
-}
+static Persistent<String> onmessages_sym;
+static Persistent<String> size_sym;
+static BufferPool* buffer_pool;
 
 
 UDPWrap::UDPWrap(Handle<Object> object): HandleWrap(object,
-                                                    (uv_handle_t*)&handle_) {
+                                                    (uv_handle_t*)&handle_),
+                                     batch_(NULL) {
   int r = uv_udp_init(uv_default_loop(), &handle_);
   assert(r == 0); // can't fail anyway
   handle_.data = reinterpret_cast<void*>(this);
@@ -77,20 +99,25 @@ UDPWrap::UDPWrap(Handle<Object> object): HandleWrap(object,
 
 
 UDPWrap::~UDPWrap() {
+  if (batch_ != NULL) {
+    delete[] batch_->slab;
+    delete batch_;
+  }
 }
 
 
 void UDPWrap::Initialize(Handle<Object> target) {
   HandleWrap::Initialize(target);
 
-  slab_allocator = new SlabAllocator(SLAB_SIZE);
-  AtExit(DeleteSlabAllocator, NULL);
+  buffer_pool = BufferPool::GetDefault();
 
   HandleScope scope;
 
   buffer_sym = NODE_PSYMBOL("buffer");
   oncomplete_sym = NODE_PSYMBOL("oncomplete");
   onmessage_sym = NODE_PSYMBOL("onmessage");
+  onmessages_sym = NODE_PSYMBOL("onmessages");
+  size_sym = NODE_PSYMBOL("size");
 
   Local<FunctionTemplate> t = FunctionTemplate::New(New);
   t->InstanceTemplate()->SetInternalFieldCount(1);
@@ -109,6 +136,8 @@ void UDPWrap::Initialize(Handle<Object> target) {
   NODE_SET_PROTOTYPE_METHOD(t, "send", Send);
   NODE_SET_PROTOTYPE_METHOD(t, "bind6", Bind6);
   NODE_SET_PROTOTYPE_METHOD(t, "send6", Send6);
+  NODE_SET_PROTOTYPE_METHOD(t, "sendBatch", SendBatch);
+  NODE_SET_PROTOTYPE_METHOD(t, "sendBatch6", SendBatch6);
   NODE_SET_PROTOTYPE_METHOD(t, "close", Close);
   NODE_SET_PROTOTYPE_METHOD(t, "recvStart", RecvStart);
   NODE_SET_PROTOTYPE_METHOD(t, "recvStop", RecvStop);
@@ -310,13 +339,121 @@ Handle<Value> UDPWrap::Send6(const Arguments& args) {
 }
 
 
+Handle<Value> UDPWrap::DoSendBatch(const Arguments& args, int family) {
+  HandleScope scope;
+  int r = 0;
+
+  // sendBatch(buffers, port, address)
+  assert(args.Length() == 3);
+
+  UNWRAP(UDPWrap)
+
+  assert(args[0]->IsArray());
+  Local<Array> buffers = Local<Array>::Cast(args[0]);
+  const uint32_t count = buffers->Length();
+  assert(count > 0);
+
+  const unsigned short port = args[1]->Uint32Value();
+  String::Utf8Value address(args[2]);
+
+  SendBatchWrap* req_wrap = new SendBatchWrap();
+  SendBatchReq* batch = &req_wrap->req_;
+  req_wrap->object_->SetHiddenValue(buffer_sym, buffers);
+  batch->reqs = new uv_udp_send_t[count];
+  batch->pending = 0;
+  batch->status = 0;
+
+  for (uint32_t i = 0; i < count; i++) {
+    Local<Value> buffer_obj = buffers->Get(i);
+    assert(Buffer::HasInstance(buffer_obj));
+
+    uv_buf_t buf = uv_buf_init(Buffer::Data(buffer_obj),
+                               Buffer::Length(buffer_obj));
+    uv_udp_send_t* req = &batch->reqs[i];
+
+    switch (family) {
+    case AF_INET:
+      r = uv_udp_send(req, &wrap->handle_, &buf, 1,
+                      uv_ip4_addr(*address, port), OnSendBatch);
+      break;
+    case AF_INET6:
+      r = uv_udp_send6(req, &wrap->handle_, &buf, 1,
+                       uv_ip6_addr(*address, port), OnSendBatch);
+      break;
+    default:
+      assert(0 && "unexpected address family");
+      abort();
+    }
+
+    if (r)
+      break;
+
+    req->data = req_wrap;
+    batch->pending++;
+  }
+
+  req_wrap->Dispatched();
+
+  if (batch->pending == 0) {
+    SetErrno(uv_last_error(uv_default_loop()));
+    delete[] batch->reqs;
+    delete req_wrap;
+    return Null();
+  }
+
+  // The datagrams that were queued still go out, the error is reported
+  // when they're done.
+  if (r) {
+    batch->status = r;
+    batch->error = uv_last_error(uv_default_loop());
+  }
+
+  return scope.Close(req_wrap->object_);
+}
+
+
+Handle<Value> UDPWrap::SendBatch(const Arguments& args) {
+  return DoSendBatch(args, AF_INET);
+}
+
+
+Handle<Value> UDPWrap::SendBatch6(const Arguments& args) {
+  return DoSendBatch(args, AF_INET6);
+}
+
+
 Handle<Value> UDPWrap::RecvStart(const Arguments& args) {
   HandleScope scope;
+  int r;
 
   UNWRAP(UDPWrap)
 
+  // recvStart([count]), a count > 0 turns on batched receives
+  unsigned int count = args[0]->IsUndefined() ? 0 : args[0]->Uint32Value();
+  assert(count <= UV_UDP_BATCH_MAX);
+
+  if (count > 0) {
+    RecvBatch* batch = wrap->batch_;
+
+    if (batch == NULL || batch->size != count) {
+      if (batch == NULL)
+        batch = wrap->batch_ = new RecvBatch;
+      else
+        delete[] batch->slab;
+      batch->slab = new char[count * RecvBatch::kSlotSize];
+      batch->size = count;
+    }
+
+    batch->next_slot = 0;
+    batch->count = 0;
+  }
+
   // UV_EALREADY means that the socket is already bound but that's okay
-  int r = uv_udp_recv_start(&wrap->handle_, OnAlloc, OnRecv);
+  if (count > 0)
+    r = uv_udp_recv_batch_start(&wrap->handle_, count, OnAllocBatch,
+                                OnRecvBatch);
+  else
+    r = uv_udp_recv_start(&wrap->handle_, OnAlloc, OnRecv);
   if (r && uv_last_error(uv_default_loop()).code != UV_EALREADY) {
     SetErrno(uv_last_error(uv_default_loop()));
     return False();
@@ -387,9 +524,7 @@ void UDPWrap::OnSend(uv_udp_send_t* req, int status) {
 
 
 uv_buf_t UDPWrap::OnAlloc(uv_handle_t* handle, size_t suggested_size) {
-  UDPWrap* wrap = static_cast<UDPWrap*>(handle->data);
-  char* buf = slab_allocator->Allocate(wrap->object_, suggested_size);
-  return uv_buf_init(buf, suggested_size);
+  return buffer_pool->Allocate(suggested_size);
 }
 
 
@@ -401,12 +536,11 @@ void UDPWrap::OnRecv(uv_udp_t* handle,
   HandleScope scope;
 
   UDPWrap* wrap = reinterpret_cast<UDPWrap*>(handle->data);
-  Local<Object> slab = slab_allocator->Shrink(wrap->object_,
-                                              buf.base,
-                                              nread < 0 ? 0 : nread);
-  if (nread == 0) return;
 
-  if (nread < 0) {
+  if (nread <= 0) {
+    buffer_pool->Release(buf);
+    if (nread == 0) return;
+
     Local<Value> argv[] = { Local<Object>::New(wrap->object_) };
     SetErrno(uv_last_error(uv_default_loop()));
     MakeCallback(wrap->object_, onmessage_sym, ARRAY_SIZE(argv), argv);
@@ -415,8 +549,8 @@ void UDPWrap::OnRecv(uv_udp_t* handle,
 
   Local<Value> argv[] = {
     Local<Object>::New(wrap->object_),
-    slab,
-    Integer::NewFromUnsigned(buf.base - Buffer::Data(slab)),
+    buffer_pool->ToBuffer(buf, nread),
+    Integer::NewFromUnsigned(0),
     Integer::NewFromUnsigned(nread),
     AddressToJS(addr)
   };
@@ -424,6 +558,131 @@ void UDPWrap::OnRecv(uv_udp_t* handle,
 }
 
 
+void UDPWrap::OnSendBatch(uv_udp_send_t* req, int status) {
+  SendBatchWrap* req_wrap = reinterpret_cast<SendBatchWrap*>(req->data);
+  UDPWrap* wrap = reinterpret_cast<UDPWrap*>(req->handle->data);
+  SendBatchReq* batch = &req_wrap->req_;
+
+  if (status && batch->status == 0) {
+    batch->status = status;
+    batch->error = uv_last_error(uv_default_loop());
+  }
+
+  if (--batch->pending > 0)
+    return;
+
+  HandleScope scope;
+
+  assert(req_wrap->object_.IsEmpty() == false);
+  assert(wrap->object_.IsEmpty() == false);
+
+  if (batch->status) {
+    SetErrno(batch->error);
+  }
+
+  Local<Value> argv[4] = {
+    Integer::New(batch->status),
+    Local<Value>::New(wrap->object_),
+    Local<Value>::New(req_wrap->object_),
+    req_wrap->object_->GetHiddenValue(buffer_sym),
+  };
+
+  delete[] batch->reqs;
+  batch->reqs = NULL;
+
+  MakeCallback(req_wrap->object_, oncomplete_sym, ARRAY_SIZE(argv), argv);
+  delete req_wrap;
+}
+
+
+uv_buf_t UDPWrap::OnAllocBatch(uv_handle_t* handle, size_t suggested_size) {
+  UDPWrap* wrap = reinterpret_cast<UDPWrap*>(handle->data);
+  RecvBatch* batch = wrap->batch_;
+
+  assert(batch->next_slot < batch->size);
+  char* slot = batch->slab + batch->next_slot++ * RecvBatch::kSlotSize;
+
+  return uv_buf_init(slot, RecvBatch::kSlotSize);
+}
+
+
+void UDPWrap::OnRecvBatch(uv_udp_t* handle,
+                          ssize_t nread,
+                          uv_buf_t buf,
+                          struct sockaddr* addr,
+                          unsigned flags) {
+  UDPWrap* wrap = reinterpret_cast<UDPWrap*>(handle->data);
+  RecvBatch* batch = wrap->batch_;
+
+  // Unlike OnRecv, a non-NULL addr tells empty datagrams apart from
+  // unused slots.
+  if (nread >= 0 && addr != NULL) {
+    unsigned int i = batch->count++;
+    batch->bufs[i] = uv_buf_init(buf.base, nread);
+    memcpy(&batch->addrs[i],
+           addr,
+           addr->sa_family == AF_INET6 ? sizeof(struct sockaddr_in6)
+                                       : sizeof(struct sockaddr_in));
+  }
+  else if (nread < 0) {
+    HandleScope scope;
+    Local<Value> argv[] = { Local<Object>::New(wrap->object_) };
+    SetErrno(uv_last_error(uv_default_loop()));
+    MakeCallback(wrap->object_, onmessage_sym, ARRAY_SIZE(argv), argv);
+  }
+
+  if (flags & UV_UDP_BATCH_END) {
+    batch->next_slot = 0;
+    if (batch->count > 0)
+      wrap->FlushBatch();
+  }
+}
+
+
+void UDPWrap::FlushBatch() {
+  HandleScope scope;
+  RecvBatch* batch = batch_;
+  unsigned int count = batch->count;
+  size_t total = 0;
+
+  for (unsigned int i = 0; i < count; i++)
+    total += batch->bufs[i].len;
+
+  Buffer* buffer = Buffer::New(total);
+  char* data = Buffer::Data(buffer);
+  Local<Array> offsets = Array::New(count);
+  Local<Array> lengths = Array::New(count);
+  Local<Array> rinfos = Array::New(count);
+  size_t offset = 0;
+
+  for (unsigned int i = 0; i < count; i++) {
+    const uv_buf_t& buf = batch->bufs[i];
+    memcpy(data + offset, buf.base, buf.len);
+
+    Local<Object> rinfo =
+        AddressToJS(reinterpret_cast<const sockaddr*>(&batch->addrs[i]));
+    rinfo->Set(size_sym, Integer::NewFromUnsigned(buf.len));
+
+    offsets->Set(i, Integer::NewFromUnsigned(offset));
+    lengths->Set(i, Integer::NewFromUnsigned(buf.len));
+    rinfos->Set(i, rinfo);
+    offset += buf.len;
+  }
+
+  // The callback may restart receiving, reset first.
+  batch->count = 0;
+
+  Local<Value> argv[] = {
+    Local<Object>::New(object_),
+    Local<Object>::New(buffer->handle_),
+    offsets,
+    lengths,
+    rinfos
+  };
+  MakeCallback(object_, onmessages_sym, ARRAY_SIZE(argv), argv);
+}
+
+
 UDPWrap* UDPWrap::Unwrap(Local<Object> obj) {
   assert(!obj.IsEmpty());
   assert(obj->InternalFieldCount() > 0);
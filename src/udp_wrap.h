@@ -17,6 +17,8 @@ class UDPWrap: public HandleWrap {
   static v8::Handle<v8::Value> Send(const v8::Arguments& args);
   static v8::Handle<v8::Value> Bind6(const v8::Arguments& args);
   static v8::Handle<v8::Value> Send6(const v8::Arguments& args);
+  static v8::Handle<v8::Value> SendBatch(const v8::Arguments& args);
+  static v8::Handle<v8::Value> SendBatch6(const v8::Arguments& args);
   static v8::Handle<v8::Value> RecvStart(const v8::Arguments& args);
   static v8::Handle<v8::Value> RecvStop(const v8::Arguments& args);
   static v8::Handle<v8::Value> GetSockName(const v8::Arguments& args);
@@ -37,6 +39,8 @@ class UDPWrap: public HandleWrap {
 
   static v8::Handle<v8::Value> DoBind(const v8::Arguments& args, int family);
   static v8::Handle<v8::Value> DoSend(const v8::Arguments& args, int family);
+  static v8::Handle<v8::Value> DoSendBatch(const v8::Arguments& args,
+                                           int family);
   static v8::Handle<v8::Value> SetMembership(const v8::Arguments& args,
                                              uv_membership membership);
 
@@ -48,7 +52,19 @@ class UDPWrap: public HandleWrap {
                      struct sockaddr* addr,
                      unsigned flags);
 
+  // Batched receive, see uv_udp_recv_batch_start().
+  struct RecvBatch;
+  static uv_buf_t OnAllocBatch(uv_handle_t* handle, size_t suggested_size);
+  static void OnSendBatch(uv_udp_send_t* req, int status);
+  static void OnRecvBatch(uv_udp_t* handle,
+                          ssize_t nread,
+                          uv_buf_t buf,
+                          struct sockaddr* addr,
+                          unsigned flags);
+  void FlushBatch();
+
   uv_udp_t handle_;
+  RecvBatch* batch_;
 };
 
 } // namespace node
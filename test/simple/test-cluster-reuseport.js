@@ -0,0 +1,77 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+var common = require('../common');
+var assert = require('assert');
+var cluster = require('cluster');
+var net = require('net');
+
+var WORKERS = 2;
+var CONNECTIONS = 40;
+
+if (cluster.isWorker) {
+  assert.ok(cluster._reusePort);
+  net.createServer(function(conn) {
+    conn.end(String(cluster.worker.id));
+  }).listen(common.PORT);
+  return;
+}
+
+cluster.setupMaster({ reusePort: true });
+assert.strictEqual(cluster.settings.reusePort, true);
+
+var listening = 0;
+var served = {};
+var done = 0;
+
+for (var i = 0; i < WORKERS; i++)
+  cluster.fork();
+
+cluster.on('listening', function(worker, address) {
+  assert.equal(address.port, common.PORT);
+  if (++listening === WORKERS)
+    connectAll();
+});
+
+function connectAll() {
+  for (var i = 0; i < CONNECTIONS; i++) {
+    net.connect(common.PORT, function() {
+      var data = '';
+      this.setEncoding('utf8');
+      this.on('data', function(s) { data += s; });
+      this.on('end', function() {
+        served[data] = (served[data] || 0) + 1;
+        if (++done === CONNECTIONS)
+          cluster.disconnect();
+      });
+    });
+  }
+}
+
+process.on('exit', function() {
+  assert.equal(listening, WORKERS);
+  assert.equal(done, CONNECTIONS);
+  // Every connection was answered by one of the workers. How the kernel
+  // spreads them is up to the platform, so don't assert on the split.
+  Object.keys(served).forEach(function(id) {
+    assert.ok(id >= 1 && id <= WORKERS, 'unexpected worker id ' + id);
+  });
+});
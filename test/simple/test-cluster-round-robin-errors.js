@@ -0,0 +1,79 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// Bind errors reach the worker with the master's errno on both the shared
+// handle and the round-robin path, and a round-robin server can still be
+// closed once the IPC channel is gone.
+
+var common = require('../common');
+var assert = require('assert');
+var cluster = require('cluster');
+var net = require('net');
+var path = require('path');
+
+if (cluster.isWorker) {
+  // Pipes are never distributed round-robin, they go through the master's
+  // shared handle.
+  var pipe = path.join(common.tmpDir, 'nonexistent', 'cluster.sock');
+  net.createServer(assert.fail).listen(pipe).on('error', function(err) {
+    assert.equal(err.code, 'EACCES');  // libuv's mapping of ENOENT
+    assert.equal(err.syscall, 'bind');
+
+    // Not a local address, so the master's bind fails right away.
+    net.createServer(assert.fail).listen(common.PORT, '1.2.3.4')
+      .on('error', function(err) {
+        assert.equal(err.code, 'EADDRNOTAVAIL');
+        assert.equal(err.syscall, 'bind');
+        listenAndDisconnect();
+      });
+  });
+  return;
+}
+
+function listenAndDisconnect() {
+  var server = net.createServer(assert.fail).listen(common.PORT);
+  process.on('message', function(msg) {
+    if (msg !== 'close') return;
+    cluster.worker.suicide = true;
+    process.disconnect();
+    server.close(function() {
+      process.exit(42);
+    });
+  });
+}
+
+cluster.setupMaster({ roundRobin: true });
+
+var worker = cluster.fork();
+var exitCode;
+
+worker.on('listening', function() {
+  worker.send('close');
+});
+
+worker.on('exit', function(code) {
+  exitCode = code;
+});
+
+process.on('exit', function() {
+  assert.equal(exitCode, 42);
+});
@@ -0,0 +1,83 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+var common = require('../common');
+var assert = require('assert');
+var cluster = require('cluster');
+var net = require('net');
+
+var CONNECTIONS = 20;
+
+if (cluster.isWorker) {
+  // Worker 1 never finishes its connections, worker 2 ends them right away.
+  // The master should notice and steer new connections to worker 2.
+  var held = [];
+  net.createServer(function(conn) {
+    conn.write(String(cluster.worker.id));
+    if (cluster.worker.id === 1)
+      held.push(conn);
+    else
+      conn.end();
+  }).listen(common.PORT);
+  return;
+}
+
+cluster.setupMaster({ roundRobin: true });
+
+var listening = 0;
+var served = { 1: 0, 2: 0 };
+var done = 0;
+var sockets = [];
+
+cluster.fork();
+cluster.fork();
+
+cluster.on('listening', function(worker, address) {
+  assert.equal(address.port, common.PORT);
+  if (++listening === 2)
+    connect();
+});
+
+function connect() {
+  var conn = net.connect(common.PORT);
+  sockets.push(conn);
+  conn.setEncoding('utf8');
+  conn.once('data', function(id) {
+    served[id]++;
+    if (++done === CONNECTIONS)
+      return finish();
+    // Give the worker's release report a moment to reach the master.
+    setTimeout(connect, 10);
+  });
+}
+
+function finish() {
+  sockets.forEach(function(conn) { conn.destroy(); });
+  cluster.disconnect();
+}
+
+process.on('exit', function() {
+  assert.equal(done, CONNECTIONS);
+  assert.equal(served[1] + served[2], CONNECTIONS);
+  assert.ok(served[1] > 0, 'worker 1 got no connections');
+  assert.ok(served[1] < CONNECTIONS / 2,
+            'worker 1 got ' + served[1] + ' connections while busy');
+});
@@ -0,0 +1,83 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+var common = require('../common');
+var assert = require('assert');
+var vm = require('vm');
+
+var snapshot = process.binding('snapshot');
+var withSnapshot = process.config.variables.node_core_snapshot === true;
+
+if (!withSnapshot)
+  console.error('Not a --with-core-snapshot build, skipping the checks ' +
+                'of the compiled modules.');
+
+// The holder that the snapshot scripts fill in never reaches user code,
+// neither in the main context nor in the contexts that vm creates, which
+// are deserialized from the same snapshot.
+assert.equal(typeof __nodeSnapshot, 'undefined');
+assert.equal(vm.runInNewContext('typeof __nodeSnapshot'), 'undefined');
+
+var sandbox = {};
+vm.runInNewContext('var a = 1', sandbox);
+assert.deepEqual(Object.keys(sandbox), ['a']);
+
+var context = vm.createContext({ b: 2 });
+assert.equal(vm.runInContext('typeof __nodeSnapshot', context),
+             'undefined');
+vm.runInContext('var c = 3', context);
+assert.deepEqual(Object.keys(context).sort(), ['b', 'c']);
+
+assert.equal(vm.createScript('typeof __nodeSnapshot').runInNewContext(),
+             'undefined');
+
+assert.equal(typeof snapshot, 'object');
+assert(!snapshot.hasOwnProperty('node'));
+
+if (!withSnapshot)
+  assert.deepEqual(Object.keys(snapshot), []);
+
+// Modules that are loaded during startup are taken out of the binding.
+assert(!snapshot.hasOwnProperty('module'));
+assert(!snapshot.hasOwnProperty('path'));
+
+// The rest are compiled module wrappers, used once by require().
+var pending = Object.keys(snapshot);
+if (withSnapshot)
+  assert(pending.indexOf('zlib') !== -1);
+
+pending.forEach(function(id) {
+  // Already required as a dependency of an earlier one.
+  if (!snapshot.hasOwnProperty(id))
+    return;
+
+  assert.equal(typeof snapshot[id], 'function');
+  require(id);
+  assert(!snapshot.hasOwnProperty(id), id);
+});
+
+// Stack traces point at the module's file and name functions the same way
+// as when the module is compiled at runtime.
+assert.throws(function() {
+  require('fs').readFileSync('/nonexistent/' + process.pid);
+}, function(err) {
+  return /\n    at Object\.fs\.readFileSync \(fs\.js:\d+:\d+\)/.test(err.stack);
+});
@@ -0,0 +1,114 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+var common = require('../common');
+var assert = require('assert');
+var fs = require('fs');
+
+try {
+  var crypto = require('crypto');
+} catch (e) {
+  console.log('Not compiled with OPENSSL support.');
+  process.exit();
+}
+
+var certPem = fs.readFileSync(common.fixturesDir + '/test_cert.pem', 'ascii');
+var keyPem = fs.readFileSync(common.fixturesDir + '/test_key.pem', 'ascii');
+var rsaPubPem = fs.readFileSync(common.fixturesDir + '/test_rsa_pubkey.pem',
+    'ascii');
+var rsaKeyPem = fs.readFileSync(common.fixturesDir + '/test_rsa_privkey.pem',
+    'ascii');
+
+var callbacks = 0;
+var data = 'Test123';
+
+// Asynchronous signatures are identical to synchronous ones.
+var expected = crypto.createSign('RSA-SHA256').update(data).sign(rsaKeyPem,
+                                                                 'hex');
+var returned = crypto.createSign('RSA-SHA256').update(data).sign(
+    rsaKeyPem, 'hex', function(err, sig) {
+      assert.ifError(err);
+      assert.equal(sig, expected);
+      callbacks++;
+
+      crypto.createVerify('RSA-SHA256').update(data).verify(
+          rsaPubPem, sig, 'hex', function(err, result) {
+            assert.ifError(err);
+            assert.strictEqual(result, true);
+            callbacks++;
+          });
+
+      crypto.createVerify('RSA-SHA256').update('other').verify(
+          rsaPubPem, sig, 'hex', function(err, result) {
+            assert.ifError(err);
+            assert.strictEqual(result, false);
+            callbacks++;
+          });
+    });
+assert.strictEqual(returned, undefined);
+
+// A buffer result when no encoding is given, verified against a certificate.
+crypto.createSign('RSA-SHA1').update(data).sign(keyPem, function(err, sig) {
+  assert.ifError(err);
+  assert(Buffer.isBuffer(sig));
+  var verify = crypto.createVerify('RSA-SHA1').update(data);
+  verify.verify(certPem, sig, function(err, result) {
+    assert.ifError(err);
+    assert.strictEqual(result, true);
+    callbacks++;
+  });
+});
+
+// Signing with something that is not a key fails through the callback.
+crypto.createSign('RSA-SHA1').update(data).sign('junk', function(err, sig) {
+  assert(err instanceof Error);
+  callbacks++;
+});
+
+// Diffie-Hellman: keys generated and secrets computed on the thread pool
+// match what the other side computes synchronously.
+var dh1 = crypto.getDiffieHellman('modp2');
+var dh2 = crypto.getDiffieHellman('modp2');
+var key2 = dh2.generateKeys();
+
+dh1.generateKeys('hex', function(err, key1) {
+  assert.ifError(err);
+  assert.equal(key1, dh1.getPublicKey('hex'));
+  assert(dh1.getPrivateKey().length > 0);
+
+  var secret2 = dh2.computeSecret(key1, 'hex', 'hex');
+  dh1.computeSecret(key2, function(err, secret1) {
+    assert.ifError(err);
+    assert(Buffer.isBuffer(secret1));
+    assert.equal(secret1.toString('hex'), secret2);
+    callbacks++;
+  });
+
+  dh1.computeSecret(new Buffer([0]), function(err, secret) {
+    assert(err instanceof Error);
+    assert.equal(err.message, 'Supplied key is too small');
+    callbacks++;
+  });
+});
+
+process.on('exit', function() {
+  assert.equal(callbacks, 7);
+});
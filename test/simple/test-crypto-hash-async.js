@@ -0,0 +1,112 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+var common = require('../common');
+var assert = require('assert');
+
+try {
+  var crypto = require('crypto');
+} catch (e) {
+  console.log('Not compiled with OPENSSL support.');
+  process.exit();
+}
+
+var data = new Buffer(4 * 1024 * 1024);
+for (var i = 0; i < data.length; i++) data[i] = i % 253;
+
+function sync(algorithm, chunk, key) {
+  var h = key ? crypto.createHmac(algorithm, key) :
+                crypto.createHash(algorithm);
+  return h.update(chunk).digest('hex');
+}
+
+var callbacks = 0;
+
+// One-shot digests and HMACs.
+crypto.hash('sha256', data, function(err, digest) {
+  assert.ifError(err);
+  assert(Buffer.isBuffer(digest));
+  assert.equal(digest.toString('hex'), sync('sha256', data));
+  callbacks++;
+});
+
+crypto.hash('sha1', data, 'secret', function(err, digest) {
+  assert.ifError(err);
+  assert.equal(digest.toString('hex'), sync('sha1', data, 'secret'));
+  callbacks++;
+});
+
+crypto.hash('md5', 'a string', function(err, digest) {
+  assert.ifError(err);
+  assert.equal(digest.toString('hex'), sync('md5', 'a string'));
+  callbacks++;
+});
+
+assert.throws(function() {
+  crypto.hash('sha1', data);
+}, /callback/);
+assert.throws(function() {
+  crypto.hash('no-such-hash', data, function() {});
+}, /not supported/);
+
+// Updates with callbacks apply in call order.
+var hash = crypto.createHash('sha512');
+var order = [];
+for (var offset = 0; offset < data.length; offset += 1024 * 1024) {
+  hash.update(data.slice(offset, offset + 1024 * 1024), (function(n) {
+    return function(err) {
+      assert.ifError(err);
+      order.push(n);
+    };
+  })(offset));
+}
+assert.throws(function() {
+  hash.digest('hex');
+}, /pending/);
+hash.digest('hex', function(err, digest) {
+  assert.ifError(err);
+  assert.deepEqual(order, [0, 1, 2, 3].map(function(n) {
+    return n * 1024 * 1024;
+  }));
+  assert.equal(digest, sync('sha512', data));
+
+  hash.digest(function(err) {
+    assert(err instanceof Error);
+    callbacks++;
+  });
+});
+
+// The stream interface, hashing on the thread pool.
+var hmac = crypto.createHmac('sha256', 'key', { async: true });
+hmac.setEncoding('hex');
+hmac.on('readable', function() {
+  var digest = hmac.read();
+  if (digest === null) return;
+  assert.equal(digest, sync('sha256', data, 'key'));
+  callbacks++;
+});
+hmac.write(data.slice(0, 1000));
+hmac.write(data.slice(1000).toString('binary'), 'binary');
+hmac.end();
+
+process.on('exit', function() {
+  assert.equal(callbacks, 5);
+});
@@ -0,0 +1,111 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+var common = require('../common');
+var assert = require('assert');
+var dgram = require('dgram');
+
+var COUNT = 40;
+
+var source = dgram.createSocket('udp4');
+var target = dgram.createSocket('udp4');
+var datagrams = [];
+var batches = 0;
+var sendBytes = -1;
+
+var payload = [];
+for (var i = 0; i < COUNT; i++)
+  payload.push(new Buffer('datagram ' + i));
+
+assert.throws(function() { target.setRecvBatch(65); }, RangeError);
+assert.throws(function() { target.setRecvBatch(-1); }, RangeError);
+assert.throws(function() { source.sendBatch(payload[0], common.PORT); },
+              TypeError);
+assert.throws(function() { source.sendBatch(['abc'], common.PORT); },
+              TypeError);
+
+target.setRecvBatch(16);
+
+target.on('messages', function(buffer, offsets, lengths, rinfos) {
+  batches++;
+  assert.ok(Buffer.isBuffer(buffer));
+  assert.equal(offsets.length, lengths.length);
+  assert.equal(offsets.length, rinfos.length);
+  assert.ok(offsets.length <= 16);
+
+  var total = 0;
+  for (var i = 0; i < offsets.length; i++) {
+    assert.equal(offsets[i], total);
+    assert.equal(rinfos[i].address, '127.0.0.1');
+    assert.equal(rinfos[i].port, source.address().port);
+    assert.equal(rinfos[i].size, lengths[i]);
+    datagrams.push(buffer.slice(offsets[i], offsets[i] + lengths[i]));
+    total += lengths[i];
+  }
+  assert.equal(buffer.length, total);
+
+  if (datagrams.length === COUNT) {
+    target.close();
+    testFallback();
+  }
+});
+
+target.on('listening', function() {
+  source.sendBatch(payload, common.PORT, '127.0.0.1', function(err, bytes) {
+    assert.ifError(err);
+    sendBytes = bytes;
+  });
+});
+
+target.bind(common.PORT);
+
+// Without a 'messages' listener batches are split into 'message' events.
+function testFallback() {
+  var other = dgram.createSocket('udp4');
+  var received = [];
+
+  other.on('message', function(buf, rinfo) {
+    assert.equal(rinfo.size, buf.length);
+    received.push(buf.toString());
+    if (received.length === 3) {
+      assert.deepEqual(received.sort(), ['a', 'b', 'c']);
+      other.close();
+      source.close();
+    }
+  });
+
+  other.bind(common.PORT + 1, function() {
+    other.setRecvBatch(4);
+    source.sendBatch([new Buffer('a'), new Buffer('b'), new Buffer('c')],
+                     common.PORT + 1, '127.0.0.1');
+  });
+}
+
+process.on('exit', function() {
+  assert.equal(datagrams.length, COUNT);
+  assert.ok(batches > 0);
+  var expected = 0;
+  for (var i = 0; i < COUNT; i++) {
+    assert.equal(datagrams[i].toString(), payload[i].toString());
+    expected += payload[i].length;
+  }
+  assert.equal(sendBytes, expected);
+});
@@ -0,0 +1,115 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+// Flags: --expose-gc
+
+var common = require('../common');
+var assert = require('assert');
+var fs = require('fs');
+var path = require('path');
+var constants = require('constants');
+
+if (!fs.mmap) {
+  console.error('Skipping: fs.mmap is not available on this platform');
+  process.exit(0);
+}
+
+var file = path.join(common.tmpDir, 'mmap.bin');
+var data = new Buffer(3 * 4096 + 123);
+for (var i = 0; i < data.length; i++)
+  data[i] = i % 253;
+fs.writeFileSync(file, data);
+
+function mappings() {
+  if (!fs.existsSync('/proc/self/maps')) return -1;
+  return fs.readFileSync('/proc/self/maps', 'utf8').split('\n').filter(
+      function(line) {
+        return line.indexOf(file) !== -1;
+      }).length;
+}
+
+var fd = fs.openSync(file, 'r');
+
+// The whole file.
+var buf = fs.mmap(fd, 0, data.length);
+assert.ok(Buffer.isBuffer(buf));
+assert.equal(buf.length, data.length);
+assert.equal(buf.toString('hex'), data.toString('hex'));
+
+// An offset that isn't a multiple of the page size, with a hint.
+var part = fs.mmap(fd, 4097, 5000, constants.PROT_READ,
+                   constants.MADV_SEQUENTIAL);
+assert.equal(part.length, 5000);
+assert.equal(part.toString('hex'), data.slice(4097, 9097).toString('hex'));
+
+fs.madvise(part, constants.MADV_RANDOM);
+fs.madvise(part.slice(100, 200), constants.MADV_WILLNEED);
+assert.throws(function() {
+  fs.madvise(new Buffer(10), constants.MADV_NORMAL);
+}, TypeError);
+
+assert.throws(function() {
+  fs.mmap(fd, 0, 0);
+}, RangeError);
+
+// Mappings must end at or before the end of the file; touching pages past
+// it would raise SIGBUS.
+var tail = fs.mmap(fd, data.length - 10, 10);
+assert.equal(tail.toString('hex'), data.slice(-10).toString('hex'));
+assert.throws(function() {
+  fs.mmap(fd, 0, data.length + 1);
+}, RangeError);
+assert.throws(function() {
+  fs.mmap(fd, data.length - 10, 65536);
+}, RangeError);
+assert.throws(function() {
+  fs.mmap(fd, data.length + 4096, 1);
+}, RangeError);
+assert.throws(function() {
+  fs.mmap(fd, -1, 10);
+}, TypeError);
+assert.throws(function() {
+  fs.mmap(fd, 0, 10, constants.PROT_READ | constants.PROT_WRITE);
+}, /EACCES/);
+
+// A writable mapping writes through to the file.
+var rw = fs.openSync(file, 'r+');
+var writable = fs.mmap(rw, 0, 10, constants.PROT_READ | constants.PROT_WRITE);
+writable.write('hello');
+assert.equal(fs.readFileSync(file).toString('ascii', 0, 5), 'hello');
+assert.equal(buf.toString('ascii', 0, 5), 'hello');
+fs.closeSync(rw);
+
+// The mappings outlive the file descriptor.
+fs.closeSync(fd);
+assert.equal(buf[4097], data[4097]);
+
+// After an explicit release the buffer reads as zeros.
+fs.munmap(part);
+assert.equal(part[0], 0);
+assert.equal(part[4999], 0);
+
+// Garbage collection unmaps the rest.
+if (mappings() !== -1) {
+  assert.ok(mappings() > 0);
+  buf = part = writable = tail = null;
+  gc();
+  assert.equal(mappings(), 0);
+}
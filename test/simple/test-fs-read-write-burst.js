@@ -0,0 +1,149 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+var common = require('../common');
+var assert = require('assert');
+var fs = require('fs');
+var path = require('path');
+var spawn = require('child_process').spawn;
+
+// Bursts of asynchronous file system requests. On Linux these go through
+// the io_uring submission path; more requests are issued than fit in the
+// ring so that the threadpool fallback is exercised as well. The child run
+// repeats everything with io_uring turned off.
+
+var name = process.argv[2] === 'child' ? 'burst-child.bin' : 'burst.bin';
+var file = path.join(common.tmpDir, name);
+var missing = path.join(common.tmpDir, 'burst-missing', 'x');
+var COUNT = 1000;
+var BLOCK = 64;
+
+var data = new Buffer(COUNT * BLOCK);
+for (var i = 0; i < data.length; i++)
+  data[i] = i % 253;
+
+var reads = 0;
+var stats = 0;
+var sequential = null;
+var errors = [];
+
+try { fs.unlinkSync(file); } catch (e) {}
+
+fs.open(file, 'w+', function(err, fd) {
+  assert.ifError(err);
+
+  var pending = COUNT;
+  for (var i = 0; i < COUNT; i++) {
+    fs.write(fd, data, i * BLOCK, BLOCK, i * BLOCK, function(err, n) {
+      assert.ifError(err);
+      assert.equal(n, BLOCK);
+      if (--pending === 0)
+        fs.fsync(fd, readAll.bind(null, fd));
+    });
+  }
+});
+
+function readAll(fd, err) {
+  assert.ifError(err);
+
+  var pending = COUNT;
+  for (var i = 0; i < COUNT; i++) {
+    (function(i) {
+      var buf = new Buffer(BLOCK);
+      fs.read(fd, buf, 0, BLOCK, i * BLOCK, function(err, n) {
+        assert.ifError(err);
+        assert.equal(n, BLOCK);
+        assert.deepEqual(buf, data.slice(i * BLOCK, (i + 1) * BLOCK));
+        reads++;
+        if (--pending === 0)
+          fs.close(fd, readSequential);
+      });
+    })(i);
+  }
+
+  for (var j = 0; j < COUNT; j++) {
+    fs.stat(file, function(err, st) {
+      assert.ifError(err);
+      assert.equal(st.size, data.length);
+      assert.ok(st.isFile());
+      stats++;
+    });
+  }
+}
+
+// A null position reads from the current file position.
+function readSequential(err) {
+  assert.ifError(err);
+
+  fs.open(file, 'r', function(err, fd) {
+    assert.ifError(err);
+    var a = new Buffer(10);
+    var b = new Buffer(10);
+    fs.read(fd, a, 0, 10, null, function(err) {
+      assert.ifError(err);
+      fs.read(fd, b, 0, 10, null, function(err) {
+        assert.ifError(err);
+        fs.fstat(fd, function(err, st) {
+          assert.ifError(err);
+          var expected = fs.statSync(file);
+          assert.equal(st.ino, expected.ino);
+          assert.equal(st.mode, expected.mode);
+          assert.equal(st.mtime.getTime(), expected.mtime.getTime());
+          sequential = Buffer.concat([a, b]);
+          fs.close(fd, function(err) {
+            assert.ifError(err);
+            fs.close(fd, function(err) {
+              errors.push(err.code);
+            });
+          });
+        });
+      });
+    });
+  });
+
+  fs.open(missing, 'r', function(err) {
+    errors.push(err.code);
+  });
+  fs.lstat(missing, function(err) {
+    errors.push(err.code);
+  });
+}
+
+if (process.argv[2] !== 'child') {
+  var env = {};
+  for (var key in process.env)
+    env[key] = process.env[key];
+  env.UV_USE_IO_URING = '0';
+
+  var child = spawn(process.execPath, [__filename, 'child'], {
+    env: env,
+    stdio: 'inherit'
+  });
+  child.on('exit', function(code) {
+    assert.equal(code, 0);
+  });
+}
+
+process.on('exit', function() {
+  assert.equal(reads, COUNT);
+  assert.equal(stats, COUNT);
+  assert.deepEqual(sequential, data.slice(0, 20));
+  assert.deepEqual(errors.sort(), ['EBADF', 'ENOENT', 'ENOENT']);
+});
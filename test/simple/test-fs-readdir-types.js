@@ -0,0 +1,156 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+var common = require('../common');
+var assert = require('assert');
+var fs = require('fs');
+var path = require('path');
+
+if (process.platform === 'win32') {
+  console.error('Skipping: directory entry types are not available on Windows');
+  process.exit(0);
+}
+
+var dir = path.join(common.tmpDir, 'readdir-types');
+
+function rmrf(p) {
+  if (!fs.existsSync(p)) return;
+  fs.readdirSync(p).forEach(function(name) {
+    var child = path.join(p, name);
+    if (fs.lstatSync(child).isDirectory())
+      rmrf(child);
+    else
+      fs.unlinkSync(child);
+  });
+  fs.rmdirSync(p);
+}
+
+rmrf(dir);
+fs.mkdirSync(dir);
+fs.mkdirSync(path.join(dir, 'subdir'));
+fs.writeFileSync(path.join(dir, 'file'), 'x');
+fs.symlinkSync(path.join(dir, 'file'), path.join(dir, 'link'));
+for (var i = 0; i < 300; i++)
+  fs.writeFileSync(path.join(dir, 'f' + i), '');
+
+var names = fs.readdirSync(dir);
+
+function checkDirents(dirents) {
+  dirents.forEach(function(dirent) {
+    assert.ok(dirent instanceof fs.Dirent);
+    var st = fs.lstatSync(path.join(dir, dirent.name));
+    assert.equal(dirent.isFile(), st.isFile());
+    assert.equal(dirent.isDirectory(), st.isDirectory());
+    assert.equal(dirent.isSymbolicLink(), st.isSymbolicLink());
+  });
+}
+
+// Same names in the same order as a plain readdir.
+var dirents = fs.readdirSync(dir, { withFileTypes: true });
+assert.deepEqual(dirents.map(function(d) { return d.name; }), names);
+checkDirents(dirents);
+assert.ok(dirents[names.indexOf('subdir')].isDirectory());
+assert.ok(dirents[names.indexOf('link')].isSymbolicLink());
+assert.ok(dirents[names.indexOf('file')].isFile());
+
+// Without the option readdir still returns names.
+assert.deepEqual(fs.readdirSync(dir, {}), names);
+
+var calls = 0;
+
+fs.readdir(dir, { withFileTypes: true }, function(err, dirents) {
+  assert.ifError(err);
+  assert.deepEqual(dirents.map(function(d) { return d.name; }), names);
+  checkDirents(dirents);
+  calls++;
+});
+
+fs.readdir(path.join(dir, 'missing'), { withFileTypes: true }, function(err) {
+  assert.equal(err.code, 'ENOENT');
+  calls++;
+});
+
+// Sync iteration in batches.
+var handle = fs.opendirSync(dir);
+var seen = [];
+var batch;
+while ((batch = handle.readNextSync(50)) !== null) {
+  assert.ok(batch.length > 0 && batch.length <= 50);
+  checkDirents(batch);
+  seen = seen.concat(batch.map(function(d) { return d.name; }));
+}
+assert.deepEqual(seen.sort(), names.slice().sort());
+handle.closeSync();
+assert.throws(function() {
+  handle.readNextSync();
+}, /EBADF/);
+assert.throws(function() {
+  handle.readNextSync(0);
+}, TypeError);
+
+assert.throws(function() {
+  fs.opendirSync(path.join(dir, 'file'));
+}, /ENOTDIR/);
+
+// Async iteration, with the default batch size.
+fs.opendir(dir, function(err, handle) {
+  assert.ifError(err);
+  var seen = [];
+
+  function next() {
+    handle.readNext(function(err, batch) {
+      assert.ifError(err);
+      if (batch === null) {
+        assert.deepEqual(seen.sort(), names.slice().sort());
+        handle.close(function(err) {
+          assert.ifError(err);
+          handle.readNext(function(err) {
+            assert.equal(err.code, 'EBADF');
+            calls++;
+          });
+        });
+        return;
+      }
+      assert.ok(batch.length <= 128);
+      seen = seen.concat(batch.map(function(d) { return d.name; }));
+      next();
+    });
+
+    // Only one operation at a time.
+    handle.readNext(function(err) {
+      assert.ok(err instanceof Error);
+      calls++;
+    });
+  }
+
+  next();
+});
+
+fs.opendir(path.join(dir, 'missing'), function(err) {
+  assert.equal(err.code, 'ENOENT');
+  assert.equal(err.syscall, 'opendir');
+  calls++;
+});
+
+process.on('exit', function() {
+  // 300 files plus 3 entries make 3 batches of 128 and the final null read.
+  assert.equal(calls, 4 + 4);
+  rmrf(dir);
+});
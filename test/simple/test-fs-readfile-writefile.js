@@ -0,0 +1,115 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+var common = require('../common');
+var assert = require('assert');
+var fs = require('fs');
+var path = require('path');
+
+var file = path.join(common.tmpDir, 'readfile-writefile.txt');
+var big = new Buffer(1024 * 1024 + 17);
+for (var i = 0; i < big.length; i++)
+  big[i] = i % 251;
+
+var calls = 0;
+
+fs.writeFile(file, big, function(err) {
+  assert.ifError(err);
+  assert.equal(arguments.length, 1);
+  assert(this === global);
+
+  fs.readFile(file, function(err, data) {
+    assert.ifError(err);
+    assert(this === global);
+    assert.ok(Buffer.isBuffer(data));
+    assert.equal(data.length, big.length);
+    assert.equal(data.toString('hex'), big.toString('hex'));
+
+    // The result is a regular Buffer.
+    assert.equal(data.slice(1, 3).toString('hex'), '0102');
+
+    fs.writeFile(file, 'abc', { mode: 384 /*=0600*/ }, function(err) {
+      assert.ifError(err);
+      fs.appendFile(file, 'def', function(err) {
+        assert.ifError(err);
+        fs.readFile(file, 'utf8', function(err, data) {
+          assert.ifError(err);
+          assert.equal(data, 'abcdef');
+          calls++;
+        });
+      });
+    });
+  });
+});
+
+// Files with a size of zero that do have data.
+if (fs.existsSync('/proc/self/status')) {
+  fs.readFile('/proc/self/status', 'utf8', function(err, data) {
+    assert.ifError(err);
+    assert.ok(/Pid:/.test(data));
+    calls++;
+  });
+} else {
+  calls++;
+}
+
+fs.readFile(path.join(common.tmpDir, 'does-not-exist'), function(err, data) {
+  assert.equal(err.code, 'ENOENT');
+  assert.equal(err.syscall, 'open');
+  assert.equal(data, undefined);
+  calls++;
+});
+
+if (process.platform !== 'win32') {
+  fs.readFile(common.tmpDir, function(err) {
+    assert.equal(err.code, 'EISDIR');
+    calls++;
+  });
+} else {
+  calls++;
+}
+
+fs.writeFile(path.join(common.tmpDir, 'no-such-dir', 'file'), 'x',
+             function(err) {
+  assert.equal(err.code, 'ENOENT');
+  calls++;
+});
+
+fs.readFile('bad\u0000path', function(err) {
+  assert.ok(err instanceof Error);
+  calls++;
+});
+
+// A flag with O_CREAT creates the file with mode 0666, like fs.open().
+var created = path.join(common.tmpDir, 'readfile-created.txt');
+try { fs.unlinkSync(created); } catch (e) {}
+fs.readFile(created, { flag: 'a+' }, function(err, data) {
+  assert.ifError(err);
+  assert.equal(data.length, 0);
+  if (process.platform !== 'win32') {
+    var mode = fs.statSync(created).mode & 511 /*=0777*/;
+    assert.equal(mode, 438 /*=0666*/ & ~process.umask());
+  }
+  calls++;
+});
+
+process.on('exit', function() {
+  assert.equal(calls, 7);
+});
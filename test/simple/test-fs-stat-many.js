@@ -0,0 +1,107 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+var common = require('../common');
+var assert = require('assert');
+var fs = require('fs');
+var path = require('path');
+
+var FIELDS = 13;
+var SIZE = 7;
+var MODE = 2;
+var INO = 1;
+var MTIME = 11;
+
+var file = path.join(common.tmpDir, 'stat-many.txt');
+var link = path.join(common.tmpDir, 'stat-many-link');
+var missing = path.join(common.tmpDir, 'stat-many-missing');
+
+fs.writeFileSync(file, 'hello');
+try { fs.unlinkSync(link); } catch (e) {}
+fs.symlinkSync(file, link);
+
+// Enough paths for the work to be split over several jobs.
+var paths = [file, link, missing, common.fixturesDir];
+fs.readdirSync(common.fixturesDir).forEach(function(name) {
+  paths.push(path.join(common.fixturesDir, name));
+});
+
+function check(result, lstat) {
+  assert.ok(result.data instanceof Float64Array);
+  assert.equal(result.data.length, paths.length * FIELDS);
+  assert.equal(result.errors[2].code, 'ENOENT');
+  assert.equal(result.errors[2].path, missing);
+
+  paths.forEach(function(p, i) {
+    if (i === 2) {
+      assert.equal(result.data[i * FIELDS + MODE], 0);
+      return;
+    }
+    assert.ok(!result.errors[i]);
+    var st = lstat ? fs.lstatSync(p) : fs.statSync(p);
+    var values = result.data.subarray(i * FIELDS, (i + 1) * FIELDS);
+    assert.equal(values[INO], st.ino);
+    assert.equal(values[MODE], st.mode);
+    assert.equal(values[SIZE], st.size);
+    assert.equal(values[MTIME], st.mtime.getTime());
+  });
+}
+
+var calls = 0;
+
+fs.statMany(paths, function(err, result) {
+  assert.ifError(err);
+  check(result, false);
+  assert.equal(result.data[1 * FIELDS + SIZE], 5);
+  calls++;
+});
+
+fs.statMany(paths, true, function(err, result) {
+  assert.ifError(err);
+  check(result, true);
+  var mode = result.data[1 * FIELDS + MODE];
+  assert.equal(mode & process.binding('constants').S_IFMT,
+               process.binding('constants').S_IFLNK);
+  calls++;
+});
+
+fs.statMany([], function(err, result) {
+  assert.ifError(err);
+  assert.equal(result.data.length, 0);
+  assert.equal(result.errors, null);
+  calls++;
+});
+
+fs.statMany([file, 'bad\u0000path'], function(err) {
+  assert.ok(err instanceof Error);
+  calls++;
+});
+
+check(fs.statManySync(paths), false);
+check(fs.statManySync(paths, true), true);
+assert.equal(fs.statManySync([file]).errors, null);
+
+assert.throws(function() {
+  fs.statManySync('not an array');
+}, TypeError);
+
+process.on('exit', function() {
+  assert.equal(calls, 4);
+});
@@ -0,0 +1,128 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+var common = require('../common');
+var assert = require('assert');
+var fs = require('fs');
+var path = require('path');
+
+var INO = 1;
+var MODE = 2;
+var SIZE = 7;
+var ATIME = 10;
+var MTIME = 11;
+var CTIME = 12;
+
+var file = path.join(common.tmpDir, 'stat-values.txt');
+var link = path.join(common.tmpDir, 'stat-values-link');
+fs.writeFileSync(file, 'hello world');
+try { fs.unlinkSync(link); } catch (e) {}
+fs.symlinkSync(file, link);
+
+function check(values, st) {
+  assert.equal(values[INO], st.ino);
+  assert.equal(values[MODE], st.mode);
+  assert.equal(values[SIZE], st.size);
+  assert.equal(values[ATIME], st.atime.getTime());
+  assert.equal(values[MTIME], st.mtime.getTime());
+  assert.equal(values[CTIME], st.ctime.getTime());
+}
+
+// Sync forms fill in and return the array.
+var values = new Float64Array(13);
+assert.strictEqual(fs.statSync(file, values), values);
+check(values, fs.statSync(file));
+assert.equal(values[SIZE], 11);
+
+assert.strictEqual(fs.lstatSync(link, values), values);
+check(values, fs.lstatSync(link));
+
+var fd = fs.openSync(file, 'r');
+assert.strictEqual(fs.fstatSync(fd, values), values);
+check(values, fs.fstatSync(fd));
+
+// A view into a bigger array works too.
+var big = new Float64Array(26);
+fs.statSync(file, big.subarray(13));
+assert.equal(big[SIZE], 0);
+assert.equal(big[13 + SIZE], 11);
+
+assert.throws(function() {
+  fs.statSync(file, new Float64Array(12));
+}, TypeError);
+assert.throws(function() {
+  fs.statSync(file, new Float32Array(13));
+}, TypeError);
+assert.throws(function() {
+  fs.statSync(path.join(common.tmpDir, 'does-not-exist'), values);
+}, /ENOENT/);
+
+// The Dates of a Stats object are created on first access and then kept.
+var st = fs.statSync(file);
+assert.ok(st.mtime instanceof Date);
+assert.strictEqual(st.mtime, st.mtime);
+['atime', 'mtime', 'ctime'].forEach(function(key) {
+  assert.notEqual(Object.keys(st).indexOf(key), -1);
+});
+assert.equal(typeof JSON.parse(JSON.stringify(st)).ctime, 'string');
+var date = new Date(0);
+st.atime = date;
+assert.strictEqual(st.atime, date);
+
+var calls = 0;
+
+fs.stat(file, new Float64Array(13), function(err, values) {
+  assert.ifError(err);
+  assert.ok(values instanceof Float64Array);
+  check(values, fs.statSync(file));
+  calls++;
+});
+
+fs.lstat(link, new Float64Array(13), function(err, values) {
+  assert.ifError(err);
+  check(values, fs.lstatSync(link));
+  calls++;
+});
+
+fs.fstat(fd, new Float64Array(13), function(err, values) {
+  assert.ifError(err);
+  check(values, fs.fstatSync(fd));
+  fs.closeSync(fd);
+  calls++;
+});
+
+fs.stat(path.join(common.tmpDir, 'does-not-exist'), new Float64Array(13),
+        function(err, values) {
+  assert.equal(err.code, 'ENOENT');
+  assert.equal(values, undefined);
+  calls++;
+});
+
+fs.stat(file, function(err, st) {
+  assert.ifError(err);
+  assert.ok(st instanceof fs.Stats);
+  assert.ok(st.isFile());
+  check(fs.statSync(file, new Float64Array(13)), st);
+  calls++;
+});
+
+process.on('exit', function() {
+  assert.equal(calls, 5);
+});
@@ -0,0 +1,173 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+var common = require('../common');
+var assert = require('assert');
+
+var HTTPParser = process.binding('http_parser').HTTPParser;
+
+var CRLF = '\r\n';
+
+function mustNotCall() {
+  assert.ok(false, 'executeBatch() must not call back into JS');
+}
+
+function newParser() {
+  var parser = new HTTPParser(HTTPParser.REQUEST);
+  parser.onHeaders = mustNotCall;
+  parser.onHeadersComplete = mustNotCall;
+  parser.onBody = mustNotCall;
+  parser.onMessageComplete = mustNotCall;
+  return parser;
+}
+
+function bodyOf(buf, message) {
+  var body = '';
+  for (var i = 0; i < message.body.length; i += 2) {
+    var start = message.body[i];
+    body += buf.slice(start, start + message.body[i + 1]);
+  }
+  return body;
+}
+
+
+//
+// Pipelined requests in one buffer.
+//
+(function() {
+  var buf = new Buffer(
+      'GET /one HTTP/1.1' + CRLF +
+      'Host: example.com' + CRLF +
+      CRLF +
+      'POST /two HTTP/1.1' + CRLF +
+      'Content-Length: 4' + CRLF +
+      CRLF +
+      'ping' +
+      'GET /three HTTP/1.0' + CRLF +
+      CRLF);
+
+  var parser = newParser();
+  var result = parser.executeBatch(buf, 0, buf.length);
+
+  assert.equal(result.bytesParsed, buf.length);
+  assert.equal(result.error, undefined);
+  assert.equal(result.messages.length, 3);
+
+  var one = result.messages[0];
+  assert.equal(one.method, 'GET');
+  assert.equal(one.url, '/one');
+  assert.deepEqual(one.headers, ['Host', 'example.com']);
+  assert.equal(one.versionMajor, 1);
+  assert.equal(one.versionMinor, 1);
+  assert.equal(one.shouldKeepAlive, true);
+  assert.equal(one.upgrade, false);
+  assert.deepEqual(one.body, []);
+  assert.equal(one.complete, true);
+
+  var two = result.messages[1];
+  assert.equal(two.method, 'POST');
+  assert.equal(two.url, '/two');
+  assert.equal(bodyOf(buf, two), 'ping');
+  assert.equal(two.complete, true);
+
+  var three = result.messages[2];
+  assert.equal(three.url, '/three');
+  assert.equal(three.versionMinor, 0);
+  assert.equal(three.shouldKeepAlive, false);
+  assert.equal(three.complete, true);
+})();
+
+
+//
+// A body that spans two calls, with trailers.
+//
+(function() {
+  var first = new Buffer(
+      'POST /chunked HTTP/1.1' + CRLF +
+      'Transfer-Encoding: chunked' + CRLF +
+      CRLF +
+      '4' + CRLF + 'ping' + CRLF);
+  var second = new Buffer(
+      '4' + CRLF + 'pong' + CRLF +
+      '0' + CRLF +
+      'Vary: *' + CRLF +
+      CRLF);
+
+  var parser = newParser();
+  var result = parser.executeBatch(first, 0, first.length);
+  assert.equal(result.messages.length, 1);
+  assert.equal(result.messages[0].url, '/chunked');
+  assert.equal(bodyOf(first, result.messages[0]), 'ping');
+  assert.equal(result.messages[0].complete, false);
+
+  result = parser.executeBatch(second, 0, second.length);
+  assert.equal(result.messages.length, 1);
+  var rest = result.messages[0];
+  assert.equal(rest.continued, true);
+  assert.equal(rest.headers, undefined);
+  assert.equal(bodyOf(second, rest), 'pong');
+  assert.deepEqual(rest.trailers, ['Vary', '*']);
+  assert.equal(rest.complete, true);
+})();
+
+
+//
+// More headers than the parser holds at once.
+//
+(function() {
+  var expected = [];
+  var request = 'GET /many HTTP/1.1' + CRLF;
+  for (var i = 0; i < 40; i++) {
+    expected.push('X-Header-' + i, 'value' + i);
+    request += 'X-Header-' + i + ': value' + i + CRLF;
+  }
+  request += CRLF;
+
+  var parser = newParser();
+  var half = request.length >> 1;
+  var a = new Buffer(request.slice(0, half));
+  var b = new Buffer(request.slice(half));
+
+  var result = parser.executeBatch(a, 0, a.length);
+  assert.equal(result.messages.length, 0);
+  result = parser.executeBatch(b, 0, b.length);
+  assert.equal(result.messages.length, 1);
+  assert.equal(result.messages[0].url, '/many');
+  assert.deepEqual(result.messages[0].headers, expected);
+})();
+
+
+//
+// Messages before a parse error are still returned.
+//
+(function() {
+  var buf = new Buffer(
+      'GET /ok HTTP/1.1' + CRLF + CRLF +
+      'GARBAGE' + CRLF + CRLF);
+
+  var parser = newParser();
+  var result = parser.executeBatch(buf, 0, buf.length);
+  assert.equal(result.messages.length, 1);
+  assert.equal(result.messages[0].url, '/ok');
+  assert.ok(result.error instanceof Error);
+  assert.equal(result.error.code, 'HPE_INVALID_METHOD');
+  assert.equal(result.bytesParsed, result.error.bytesParsed);
+})();
@@ -0,0 +1,102 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+var common = require('../common');
+var assert = require('assert');
+
+var HTTPParser = process.binding('http_parser').HTTPParser;
+
+var CRLF = '\r\n';
+
+// Header names are shared between messages when they are common, but must
+// come out exactly as they were sent, whatever their case, and no matter
+// how the message is split across execute() calls.
+
+function parse(chunks) {
+  var parser = new HTTPParser(HTTPParser.REQUEST);
+  var result = { headers: [], url: '' };
+
+  parser.onHeaders = function(headers, url) {
+    result.headers = result.headers.concat(headers);
+    result.url += url;
+  };
+
+  parser.onHeadersComplete = function(info) {
+    if (info.headers) result.headers = info.headers;
+    if (info.url) result.url = info.url;
+  };
+
+  parser.onBody = function(b, start, len) {
+  };
+
+  parser.onMessageComplete = function() {
+    result.complete = true;
+  };
+
+  chunks.forEach(function(chunk) {
+    var buf = new Buffer(chunk);
+    var ret = parser.execute(buf, 0, buf.length);
+    assert.equal(ret, buf.length);
+  });
+
+  assert.ok(result.complete);
+  return result;
+}
+
+var expected = [
+  'Host', 'example.com',
+  'user-agent', 'curl/7.30.0',
+  'ACCEPT', '*/*',
+  'Content-length', '0',
+  'X-Custom', 'custom-value',
+  'connection', 'keep-alive'
+];
+
+var request = 'GET /interned HTTP/1.1' + CRLF;
+for (var i = 0; i < expected.length; i += 2)
+  request += expected[i] + ': ' + expected[i + 1] + CRLF;
+request += CRLF;
+
+// In one piece.
+var result = parse([request]);
+assert.equal(result.url, '/interned');
+assert.deepEqual(result.headers, expected);
+
+// Split at every possible offset, so names, values and the url get saved
+// and continued in the parser's arena.
+for (var i = 1; i < request.length; i++) {
+  result = parse([request.slice(0, i), request.slice(i)]);
+  assert.equal(result.url, '/interned');
+  assert.deepEqual(result.headers, expected);
+}
+
+// One byte at a time, with more headers than fit before a flush.
+var many = [];
+request = 'GET /many HTTP/1.1' + CRLF;
+for (var i = 0; i < 40; i++) {
+  many.push(i % 2 ? 'Accept-Encoding' : 'Accept-Language', 'value' + i);
+  request += many[many.length - 2] + ': ' + many[many.length - 1] + CRLF;
+}
+request += CRLF;
+
+result = parse(request.split(''));
+assert.equal(result.url, '/many');
+assert.deepEqual(result.headers, many);
@@ -0,0 +1,73 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+var common = require('../common');
+var assert = require('assert');
+var net = require('net');
+
+var CONNECTIONS = 50;
+
+var connections = 0;
+var batches = 0;
+var largest = 0;
+var closed = 0;
+
+var server = net.createServer({ acceptBatch: 16 }, function(conn) {
+  connections++;
+  conn.end();
+});
+
+assert.equal(server.acceptBatch, 16);
+assert.equal(server.acceptBacklog, -1);
+
+server.listen(common.PORT, function() {
+  // Count the native callbacks to see that connections arrive in batches.
+  var handle = server._handle;
+  var onconnection = handle.onconnection;
+  handle.onconnection = function(clients, pending) {
+    if (Array.isArray(clients)) {
+      batches++;
+      largest = Math.max(largest, clients.length);
+      assert.ok(clients.length <= 16);
+      assert.equal(typeof pending, 'number');
+    }
+    return onconnection.apply(this, arguments);
+  };
+
+  // Open the connections back to back so they pile up in the accept queue.
+  for (var i = 0; i < CONNECTIONS; i++) {
+    net.connect(common.PORT).on('close', function() {
+      if (++closed === CONNECTIONS)
+        server.close();
+    }).resume();
+  }
+});
+
+process.on('exit', function() {
+  assert.equal(connections, CONNECTIONS);
+  assert.equal(closed, CONNECTIONS);
+  if (process.platform !== 'win32') {
+    assert.ok(batches > 0);
+    assert.ok(batches < CONNECTIONS, 'every connection came alone');
+    assert.ok(largest > 1);
+    assert.equal(typeof server.acceptBacklog, 'number');
+  }
+});
@@ -0,0 +1,64 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// Flags: --expose-gc
+
+var common = require('../common');
+var assert = require('assert');
+var net = require('net');
+
+var pool = process.binding('buffer_pool');
+var before = pool.getStats();
+var chunks = [];
+
+assert.equal(before.classes.length, 3);
+
+var server = net.createServer(function(socket) {
+  socket.on('data', function(chunk) {
+    chunks.push(chunk);
+  });
+  socket.on('end', function() {
+    server.close();
+  });
+}).listen(common.PORT, function() {
+  var conn = net.connect(common.PORT, function() {
+    conn.end('small read');
+  });
+});
+
+process.on('exit', function() {
+  var stats = pool.getStats();
+  assert.equal(Buffer.concat(chunks).toString(), 'small read');
+
+  // A small read is copied into a chunk of the smallest size class, so it
+  // does not pin a whole read buffer.
+  assert.equal(chunks[0].parent.length, chunks[0].length);
+  assert.ok(stats.classes[0].pinned >= 1);
+  assert.ok(stats.pinnedBytes < stats.classes[2].size);
+  assert.ok(stats.hits + stats.misses > before.hits + before.misses);
+
+  // Once the Buffer is collected its chunk goes back on the free list.
+  chunks = null;
+  gc();
+  stats = pool.getStats();
+  assert.equal(stats.pinnedBytes, 0);
+  assert.ok(stats.classes[0].cached >= 1);
+});
@@ -0,0 +1,102 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// Streams without a zero-copy path have sendFile() segments read and written
+// in bounded pieces, in order with the writes around them. The file data
+// counts towards the Writable's buffered length either way.
+
+var common = require('../common');
+var assert = require('assert');
+var fs = require('fs');
+var net = require('net');
+var path = require('path');
+
+var SIZE = 1024 * 1024;
+var file = path.join(common.tmpDir, 'sendfile-fallback.bin');
+
+var data = new Buffer(SIZE);
+for (var i = 0; i < SIZE; i++)
+  data[i] = i % 251;
+fs.writeFileSync(file, data);
+
+var fd = fs.openSync(file, 'r');
+
+var expected = Buffer.concat([
+  new Buffer('head:'),
+  data.slice(7, 70007),
+  new Buffer(':middle:'),
+  data,
+  new Buffer(':tail')
+]);
+
+// Record how much each read asks for.
+var maxRead = 0;
+var read = fs.read;
+fs.read = function(fd, buffer, offset, length) {
+  maxRead = Math.max(maxRead, length);
+  return read.apply(fs, arguments);
+};
+
+var sendFileCalls = 0;
+var drained = false;
+
+var server = net.createServer(function(conn) {
+  // Act like a handle that can't send files itself, e.g. on Windows.
+  conn._handle.sendFile = function() {
+    process._errno = 'ENOSYS';
+    return null;
+  };
+
+  conn.write('head:');
+  conn.sendFile(fd, 7, 70000, function() { sendFileCalls++; });
+  conn.write(':middle:');
+  var ret = conn.sendFile(fd, 0, SIZE, function() { sendFileCalls++; });
+  assert.equal(ret, false);
+  assert.ok(conn._writableState.length >= SIZE);
+  conn.once('drain', function() {
+    drained = true;
+    assert.equal(conn._writableState.length, 0);
+    conn.end(':tail');
+  });
+});
+
+server.listen(common.PORT, function() {
+  var chunks = [];
+  var client = net.connect(common.PORT);
+  client.on('data', function(chunk) {
+    chunks.push(chunk);
+  });
+  client.on('end', function() {
+    var received = Buffer.concat(chunks);
+    assert.equal(received.length, expected.length);
+    assert.ok(received.toString('hex') === expected.toString('hex'),
+              'data mismatch');
+    server.close();
+  });
+});
+
+process.on('exit', function() {
+  fs.closeSync(fd);
+  assert.equal(sendFileCalls, 2);
+  assert.ok(drained);
+  assert.ok(maxRead > 0 && maxRead <= 64 * 1024, 'read ' + maxRead);
+});
@@ -0,0 +1,127 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+var common = require('../common');
+var assert = require('assert');
+var fs = require('fs');
+var net = require('net');
+var path = require('path');
+
+// Big enough that the socket fills up and sendfile() has to be resumed.
+var SIZE = 4 * 1024 * 1024;
+var file = path.join(common.tmpDir, 'sendfile.bin');
+
+var data = new Buffer(SIZE);
+for (var i = 0; i < SIZE; i++)
+  data[i] = i % 251;
+fs.writeFileSync(file, data);
+
+var fd = fs.openSync(file, 'r');
+var sendFileCalls = 0;
+
+var expected = Buffer.concat([
+  new Buffer('head:'),
+  data.slice(3, 1003),
+  new Buffer(':middle:'),
+  data,
+  new Buffer(':tail')
+]);
+
+var server = net.createServer(function(conn) {
+  // Several writes pile up behind the first one, so the file segments end
+  // up in the middle of a writev batch as well.
+  conn.write('head:');
+  conn.sendFile(fd, 3, 1000, function() { sendFileCalls++; });
+  conn.write(':middle:');
+  conn.sendFile(fd, 0, SIZE, function() { sendFileCalls++; });
+  conn.sendFile(fd, 0, 0, function() { sendFileCalls++; });
+  conn.end(':tail');
+});
+
+server.listen(common.PORT, function() {
+  var chunks = [];
+  var client = net.connect(common.PORT);
+  client.on('data', function(chunk) {
+    chunks.push(chunk);
+  });
+  client.on('end', function() {
+    var received = Buffer.concat(chunks);
+    assert.equal(received.length, expected.length);
+    assert.ok(received.toString('hex') === expected.toString('hex'),
+              'data mismatch');
+    server.close();
+  });
+});
+
+// A segment that runs past the end of the file is an error.
+var errServer = net.createServer(function(conn) {
+  conn.on('error', function(err) {
+    errorSeen = err;
+  });
+  conn.sendFile(fd, SIZE - 10, 20);
+});
+var errorSeen = null;
+
+errServer.listen(common.PORT + 1, function() {
+  net.connect(common.PORT + 1).on('close', function() {
+    errServer.close();
+  }).on('error', function() {}).resume();
+});
+
+// sendFile() after end() is refused, and must not keep the queued writes
+// from finishing.
+var afterEndError = null;
+var afterEndFinished = false;
+var afterEndReceived = 0;
+var afterEndServer = net.createServer(function(conn) {
+  conn.on('error', function(err) {
+    afterEndError = err;
+  });
+  conn.on('finish', function() {
+    afterEndFinished = true;
+  });
+  conn.write(data);
+  conn.end();
+  conn.sendFile(fd, 0, 10);
+});
+
+afterEndServer.listen(common.PORT + 2, function() {
+  var client = net.connect(common.PORT + 2);
+  client.on('data', function(chunk) {
+    afterEndReceived += chunk.length;
+  });
+  client.on('end', function() {
+    afterEndServer.close();
+  });
+});
+
+assert.throws(function() {
+  new net.Socket().sendFile(-1, 0, 10);
+}, TypeError);
+
+process.on('exit', function() {
+  fs.closeSync(fd);
+  assert.equal(sendFileCalls, 3);
+  assert.ok(errorSeen, 'short file did not fail');
+  assert.ok(afterEndError, 'sendFile after end did not fail');
+  assert.ok(afterEndFinished, 'finish not emitted after refused sendFile');
+  assert.equal(afterEndReceived, SIZE);
+});
@@ -0,0 +1,63 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+var common = require('../common');
+var assert = require('assert');
+var fs = require('fs');
+var net = require('net');
+var tty = require('tty');
+
+// splice() refuses destinations opened with O_APPEND. A pty master opened
+// with the 'a' flag is such a destination that can still be a stream, so
+// the data has to be written from a buffer instead.
+if (process.platform !== 'linux' || !fs.existsSync('/dev/ptmx')) {
+  console.error('Skipping: needs a Linux pty');
+  process.exit(0);
+}
+
+var fd = fs.openSync('/dev/ptmx', 'a');
+assert.ok(tty.isatty(fd));
+var dest = new tty.WriteStream(fd);
+var splicedBytes = -1;
+
+// Two chunks, so that both the chunk that was already in the splice pipe
+// and the ones read after the switch to the buffer get written.
+var server = net.createServer(function(conn) {
+  conn.splice(dest, function(err, bytes) {
+    assert.ifError(err);
+    splicedBytes = bytes;
+    dest.destroy();
+    server.close();
+  });
+});
+
+server.listen(common.PORT, function() {
+  var client = net.connect(common.PORT, function() {
+    client.write(new Buffer(500));
+    setTimeout(function() {
+      client.end(new Buffer(700));
+    }, 50);
+  });
+});
+
+process.on('exit', function() {
+  assert.equal(splicedBytes, 1200);
+});
@@ -0,0 +1,100 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+var common = require('../common');
+var assert = require('assert');
+var net = require('net');
+var Pipe = process.binding('pipe_wrap').Pipe;
+
+// A client talks to an echo server through a proxy that splices both
+// directions. The payload is big enough for backpressure to kick in.
+var SIZE = 4 * 1024 * 1024;
+
+var data = new Buffer(SIZE);
+for (var i = 0; i < SIZE; i++)
+  data[i] = i % 251;
+
+var upstreamBytes = 0;
+var downstreamBytes = 0;
+var received = [];
+
+var echo = net.createServer(function(conn) {
+  conn.pipe(conn);
+});
+
+// The proxy forwards each half-close on its own, so it must not end the
+// client as soon as the client is done sending.
+var proxy = net.createServer({ allowHalfOpen: true }, function(client) {
+  // Nothing is read in JS until the upstream connection is up, so the
+  // greeting the client sends first is buffered in the kernel.
+  var upstream = net.connect({ port: common.PORT, allowHalfOpen: true },
+                             function() {
+    // A chunk that is queued on the destination before the splice starts
+    // must come out first.
+    client.write('proxy:');
+
+    assert.throws(function() {
+      client.splice({});
+    }, TypeError);
+
+    // A handle that has been closed has nothing left to splice into.
+    var closed = new Pipe();
+    closed.close();
+    assert.throws(function() {
+      client._handle.pipe(closed);
+    }, TypeError);
+
+    client.splice(upstream, function(err, bytes) {
+      assert.ifError(err);
+      upstreamBytes = bytes;
+    });
+    upstream.splice(client, function(err, bytes) {
+      assert.ifError(err);
+      downstreamBytes = bytes;
+      proxy.close();
+      echo.close();
+    });
+
+    assert.throws(function() {
+      client.splice(upstream);
+    }, /already spliced/);
+  });
+});
+
+echo.listen(common.PORT, function() {
+  proxy.listen(common.PORT + 1, function() {
+    var conn = net.connect(common.PORT + 1, function() {
+      conn.write('hello:');
+      conn.end(data);
+    });
+    conn.on('data', function(chunk) {
+      received.push(chunk);
+    });
+  });
+});
+
+process.on('exit', function() {
+  var out = Buffer.concat(received);
+  assert.equal(upstreamBytes, SIZE + 6);
+  assert.equal(downstreamBytes, SIZE + 6);
+  assert.equal(out.length, SIZE + 12);
+  assert.equal(out.slice(0, 12).toString(), 'proxy:hello:');
+  assert.deepEqual(out.slice(12), data);
+});
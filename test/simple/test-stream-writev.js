@@ -0,0 +1,74 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+var common = require('../common');
+var assert = require('assert');
+
+var stream = require('stream');
+
+// Writes that pile up while another write is in progress are handed to
+// _writev() in one call, in order, with their encodings.
+
+var w = new stream.Writable({ decodeStrings: false });
+var pending = null;
+var writes = [];
+var callbacks = 0;
+
+w._write = function(chunk, encoding, cb) {
+  writes.push([[chunk, encoding]]);
+  pending = cb;
+};
+
+w._writev = function(chunks, cb) {
+  writes.push(chunks.map(function(entry) {
+    return [entry.chunk, entry.encoding];
+  }));
+  process.nextTick(cb);
+};
+
+function onwrite(er) {
+  assert.ifError(er);
+  callbacks++;
+}
+
+w.write('first', 'utf8', onwrite);
+w.write(new Buffer('second'), onwrite);
+w.write('7468697264', 'hex', onwrite);
+w.write('fourth', 'ascii', onwrite);
+
+assert.equal(writes.length, 1);
+pending();
+
+var finished = false;
+w.end(function() {
+  finished = true;
+});
+
+process.on('exit', function() {
+  assert.ok(finished);
+  assert.equal(callbacks, 4);
+  assert.equal(writes.length, 2);
+  assert.deepEqual(writes[0], [['first', 'utf8']]);
+  assert.equal(writes[1].length, 3);
+  assert.equal(writes[1][0][0].toString(), 'second');
+  assert.equal(writes[1][0][1], 'buffer');
+  assert.deepEqual(writes[1][1], ['7468697264', 'hex']);
+  assert.deepEqual(writes[1][2], ['fourth', 'ascii']);
+});
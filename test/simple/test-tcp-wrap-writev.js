@@ -0,0 +1,61 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+var common = require('../common');
+var assert = require('assert');
+var net = require('net');
+
+var expected = 'héllo' + 'world' + 'binary' + 'ucs2' + 'hex' +
+               new Array(20).join('x') + 'done';
+var received = '';
+var writevCalls = 0;
+
+var server = net.createServer(function(socket) {
+  socket.setEncoding('utf8');
+  socket.on('data', function(d) {
+    received += d;
+  });
+  socket.on('end', function() {
+    server.close();
+  });
+}).listen(common.PORT, function() {
+  var conn = net.connect(common.PORT);
+  var writev = conn._handle.writev;
+  conn._handle.writev = function(chunks) {
+    writevCalls++;
+    return writev.apply(this, arguments);
+  };
+
+  // The first write is held back until the socket connects, everything
+  // written in the meantime gets flushed with a single writev().
+  conn.write('héllo', 'utf8');
+  conn.write(new Buffer('world'));
+  conn.write('binary', 'binary');
+  conn.write(new Buffer('ucs2').toString('ucs2'), 'ucs2');
+  conn.write(new Buffer('hex').toString('hex'), 'hex');
+  for (var i = 0; i < 19; i++)
+    conn.write('x');
+  conn.end('done');
+});
+
+process.on('exit', function() {
+  assert.equal(writevCalls, 1);
+  assert.equal(received, expected);
+});
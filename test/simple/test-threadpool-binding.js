@@ -0,0 +1,111 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+var common = require('../common');
+var assert = require('assert');
+var fs = require('fs');
+var zlib = require('zlib');
+
+var binding = process.binding('threadpool');
+
+var stats = binding.getStats();
+assert.ok(stats.size >= 1);
+['fs', 'dns', 'cpu', 'user'].forEach(function(name) {
+  var c = stats.classes[name];
+  assert.equal(c.limit, 0);
+  assert.equal(c.waitHistogram.length, 24);
+  assert.equal(c.runHistogram.length, 24);
+});
+
+assert.throws(function() { binding.setLimit('bogus', 1); }, TypeError);
+assert.throws(function() { binding.setLimit('fs', -1); }, TypeError);
+assert.throws(function() { binding.resize(0); });
+assert.throws(function() { binding.resize(129); });
+
+binding.resize(6);
+assert.equal(binding.getStats().size, 6);
+
+var fsBefore = binding.getStats().classes.fs.submitted;
+var cpuBefore = binding.getStats().classes.cpu.completed;
+
+// With a limit of 1, no more than one compression job may run at a time even
+// though there are threads to spare.
+binding.setLimit('cpu', 1);
+assert.equal(binding.getStats().classes.cpu.limit, 1);
+
+var maxRunning = 0;
+var pending = 0;
+var data = new Buffer(256 * 1024);
+for (var i = 0; i < data.length; i++) data[i] = i * 7 % 251;
+
+function sample() {
+  var running = binding.getStats().classes.cpu.running;
+  if (running > maxRunning) maxRunning = running;
+  if (pending > 0) setImmediate(sample);
+}
+
+for (var i = 0; i < 8; i++) {
+  pending++;
+  zlib.deflate(data, function(err) {
+    assert.ifError(err);
+    if (--pending === 0) afterCompression();
+  });
+}
+setImmediate(sample);
+
+// fs jobs are not held up by the busy cpu class. readdir always runs on the
+// threadpool, unlike stat which may go through io_uring.
+var fsCalls = 0;
+for (var i = 0; i < 10; i++) {
+  pending++;
+  fs.readdir(__dirname, function(err) {
+    assert.ifError(err);
+    fsCalls++;
+    if (--pending === 0) afterCompression();
+  });
+}
+
+function afterCompression() {
+  var s = binding.getStats();
+  assert.equal(maxRunning, 1);
+  assert.equal(s.classes.cpu.running, 0);
+  assert.equal(s.classes.cpu.queued, 0);
+  assert.ok(s.classes.cpu.completed >= cpuBefore + 8);
+  assert.ok(s.classes.fs.submitted >= fsBefore + 10);
+  assert.equal(fsCalls, 10);
+
+  var runs = s.classes.cpu.runHistogram.reduce(function(a, b) {
+    return a + b;
+  });
+  assert.equal(runs, s.classes.cpu.completed);
+
+  // Shrink the pool and check that it still does work.
+  binding.setLimit('cpu', 0);
+  binding.resize(1);
+  assert.equal(binding.getStats().size, 1);
+  zlib.deflate(data, common.mustCall(function(err) {
+    assert.ifError(err);
+    binding.resize(4);
+    fs.stat(__filename, common.mustCall(function(err) {
+      assert.ifError(err);
+    }));
+  }));
+}
@@ -0,0 +1,95 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+var common = require('../common');
+var assert = require('assert');
+
+var WheelTimer = process.binding('timer_wrap').WheelTimer;
+
+// Loop time is cached per tick, allow for it lagging behind Date.now().
+var SLACK = 15;
+
+function startTimer(ms, cb) {
+  var timer = new WheelTimer();
+  var start = Date.now();
+  timer.ontimeout = function() {
+    cb(Date.now() - start);
+  };
+  timer.start(ms);
+  return timer;
+}
+
+// Fires once, not early.
+var fired = 0;
+startTimer(50, function(elapsed) {
+  fired++;
+  assert.ok(elapsed >= 50 - SLACK, 'fired early: ' + elapsed);
+});
+
+// Restarting pushes the deadline back.
+var pushed = startTimer(30, function(elapsed) {
+  fired++;
+  assert.ok(elapsed >= 100 - SLACK, 'fired before restart: ' + elapsed);
+});
+pushed.start(100);
+
+// And can pull it in.
+startTimer(5000, function(elapsed) {
+  fired++;
+  assert.ok(elapsed < 1000, 'fired late: ' + elapsed);
+}).start(20);
+
+// A stopped timer stays quiet.
+startTimer(20, function() {
+  assert.fail('stopped timer fired');
+}).stop();
+
+// Spans more than one level of the wheel.
+startTimer(900, function(elapsed) {
+  fired++;
+  assert.ok(elapsed >= 900 - SLACK, 'fired early: ' + elapsed);
+});
+
+// Lots of timers, each fires exactly once and never early.
+var N = 5000;
+var many = 0;
+for (var i = 0; i < N; i++) {
+  (function(ms) {
+    startTimer(ms, function(elapsed) {
+      many++;
+      assert.ok(elapsed >= ms - SLACK, ms + 'ms timer fired after ' + elapsed);
+    });
+  })(i % 400);
+}
+
+// Pending wheel timers don't keep the process alive; this one would fire
+// long after everything else is done.
+startTimer(60 * 1000, function() {
+  assert.fail('process should have exited');
+});
+
+// Keep the process alive long enough for the others.
+setTimeout(function() {}, 1200);
+
+process.on('exit', function() {
+  assert.equal(fired, 4);
+  assert.equal(many, N);
+});
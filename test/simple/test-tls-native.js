@@ -0,0 +1,185 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+if (!process.versions.openssl) {
+  console.error('Skipping because node compiled without OpenSSL.');
+  process.exit(0);
+}
+
+var common = require('../common');
+var assert = require('assert');
+var tls = require('tls');
+var fs = require('fs');
+var net = require('net');
+var crypto = require('crypto');
+var tls_wrap = process.binding('tls_wrap');
+var Connection = process.binding('crypto').Connection;
+
+var options = {
+  key: fs.readFileSync(common.fixturesDir + '/keys/agent1-key.pem'),
+  cert: fs.readFileSync(common.fixturesDir + '/keys/agent1-cert.pem')
+};
+
+// Large enough to span many TLS records and socket reads.
+var payload = new Buffer(1024 * 1024);
+for (var i = 0; i < payload.length; i++) payload[i] = i % 251;
+
+var tests = [
+  // [server native, client native]
+  [true, true],
+  [true, false],
+  [false, true]
+];
+var completed = 0;
+
+function runTest(index) {
+  if (index === tests.length) return;
+
+  var serverNative = tests[index][0];
+  var clientNative = tests[index][1];
+  var secured = false;
+
+  var serverOptions = {
+    key: options.key,
+    cert: options.cert,
+    nativeTLS: serverNative
+  };
+
+  var server = tls.createServer(serverOptions, function(cleartext) {
+    secured = true;
+    assert.equal(cleartext instanceof net.Socket, serverNative);
+    assert.ok(cleartext.getCipher().name);
+    // Echo everything back.
+    cleartext.pipe(cleartext);
+  });
+
+  server.listen(common.PORT, function() {
+    var client = tls.connect({
+      port: common.PORT,
+      rejectUnauthorized: false,
+      nativeTLS: clientNative
+    }, function() {
+      assert.equal(client.getPeerCertificate().subject.CN, 'agent1');
+      assert.equal(client.authorized, false);
+
+      // Buffers, strings and an empty write, most of them before the peer
+      // had a chance to drain anything.
+      client.write(payload.slice(0, 1000));
+      client.write('');
+      client.write(payload.slice(1000, 2000).toString('binary'), 'binary');
+      client.write(payload.slice(2000));
+    });
+
+    // The server is not half-open: ending early would let it close before
+    // the whole echo is out, so wait for all of it.
+    var received = [];
+    var length = 0;
+    client.on('data', function(chunk) {
+      received.push(chunk);
+      length += chunk.length;
+      if (length === payload.length) client.end();
+    });
+
+    client.on('end', function() {
+      assert.ok(secured);
+      assert.equal(length, payload.length);
+      assert.equal(Buffer.concat(received, length).toString('hex'),
+                   payload.toString('hex'));
+      completed++;
+      server.close();
+    });
+  });
+
+  server.on('close', function() {
+    runTest(index + 1);
+  });
+}
+
+// A native client writing before the socket is even connected.
+function testEarlyWrite() {
+  var server = tls.createServer(options, function(cleartext) {
+    cleartext.once('data', function(data) {
+      assert.equal(data.toString(), 'hello');
+      cleartext.end();
+      server.close();
+      completed++;
+    });
+  });
+
+  server.listen(common.PORT + 1, function() {
+    var client = tls.connect({
+      port: common.PORT + 1,
+      rejectUnauthorized: false,
+      nativeTLS: true
+    });
+    client.write('hello');
+    client.resume();
+
+    client.on('secureConnect', common.mustCall(function() {
+      // A handle carries one TLS connection at most.
+      assert.throws(function() {
+        tls_wrap.wrap(client._handle, client.pair.ssl);
+      }, /already wrapped/);
+    }));
+  });
+}
+
+// Only stream handles can carry a TLS connection.
+function testNonStream() {
+  var context = crypto.createCredentials().context;
+  var ssl = new Connection(context, false, false, false);
+  var udp = new (process.binding('udp_wrap').UDP)();
+  assert.throws(function() {
+    tls_wrap.wrap(udp, ssl);
+  }, TypeError);
+  udp.close();
+}
+
+// A handshake that never completes surfaces as ECONNRESET.
+function testHangup() {
+  var server = net.createServer(function(socket) {
+    socket.destroy();
+    server.close();
+  });
+
+  server.listen(common.PORT + 2, function() {
+    var client = tls.connect({
+      port: common.PORT + 2,
+      rejectUnauthorized: false,
+      nativeTLS: true
+    }, function() {
+      assert.fail('connected');
+    });
+    client.on('error', function(err) {
+      assert.equal(err.code, 'ECONNRESET');
+      completed++;
+    });
+  });
+}
+
+runTest(0);
+testEarlyWrite();
+testHangup();
+testNonStream();
+
+process.on('exit', function() {
+  assert.equal(completed, tests.length + 2);
+});
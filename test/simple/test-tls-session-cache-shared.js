@@ -0,0 +1,104 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+if (!process.versions.openssl) {
+  console.error('Skipping because node compiled without OpenSSL.');
+  process.exit(0);
+}
+
+var common = require('../common');
+var assert = require('assert');
+var constants = require('constants');
+var tls = require('tls');
+var fs = require('fs');
+
+var name = 'node-test-session-cache-' + process.pid;
+
+assert.throws(function() { tls.createSessionCache(); }, TypeError);
+assert.throws(function() { tls.createSessionCache({ name: '' }); },
+              TypeError);
+assert.throws(function() { tls.createSessionCache({ name: name, size: 0 }); },
+              RangeError);
+assert.throws(function() { tls.createServer({ sessionCache: {} }); },
+              TypeError);
+
+// Two caches opened under the same name map the same segment, just like
+// they would in two cluster workers.
+var caches = [
+  tls.createSessionCache({ name: name, size: 64 }),
+  tls.createSessionCache({ name: name, size: 4096 })
+];
+caches[0].unlink();
+
+assert.equal(caches[0].getStats().capacity, 64);
+assert.equal(caches[1].getStats().capacity, 64);
+
+var options = {
+  key: fs.readFileSync(common.fixturesDir + '/keys/agent1-key.pem'),
+  cert: fs.readFileSync(common.fixturesDir + '/keys/agent1-cert.pem'),
+  secureOptions: constants.SSL_OP_NO_TICKET
+};
+
+var servers = caches.map(function(cache) {
+  options.sessionCache = cache;
+  return tls.createServer(options, function(cleartext) {
+    cleartext.end('hello');
+  });
+});
+
+var reused = [];
+
+function connect(i, session, cb) {
+  var client = tls.connect({
+    port: common.PORT + i,
+    rejectUnauthorized: false,
+    session: session
+  }, function() {
+    reused.push(client.isSessionReused());
+    session = client.getSession();
+  });
+  client.on('data', function() {});
+  client.on('end', function() {
+    cb(session);
+  });
+}
+
+servers[0].listen(common.PORT, function() {
+  servers[1].listen(common.PORT + 1, function() {
+    connect(0, null, function(session) {
+      connect(1, session, function() {
+        servers[0].close();
+        servers[1].close();
+      });
+    });
+  });
+});
+
+process.on('exit', function() {
+  assert.deepEqual(reused, [false, true]);
+
+  var stats = caches[0].getStats();
+  assert.equal(stats.stores, 1);
+  assert.equal(stats.hits, 1);
+  assert.equal(stats.misses, 0);
+  assert.equal(stats.evictions, 0);
+  assert.deepEqual(caches[1].getStats(), stats);
+});
@@ -0,0 +1,111 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+if (!process.versions.openssl) {
+  console.error('Skipping because node compiled without OpenSSL.');
+  process.exit(0);
+}
+
+var common = require('../common');
+var assert = require('assert');
+var crypto = require('crypto');
+var tls = require('tls');
+var fs = require('fs');
+
+var oldKey = crypto.randomBytes(48);
+var newKey = crypto.randomBytes(48);
+
+var options = {
+  key: fs.readFileSync(common.fixturesDir + '/keys/agent1-key.pem'),
+  cert: fs.readFileSync(common.fixturesDir + '/keys/agent1-cert.pem')
+};
+
+assert.throws(function() {
+  options.ticketKeys = new Buffer(47);
+  tls.createServer(options);
+}, TypeError);
+
+// Two servers with their own contexts but the same keys, like two workers.
+options.ticketKeys = oldKey;
+var servers = [0, 1].map(function() {
+  return tls.createServer(options, function(cleartext) {
+    cleartext.end();
+  });
+});
+
+assert.equal(servers[1].getTicketKeys().toString('hex'),
+             oldKey.toString('hex'));
+assert.throws(function() {
+  servers[1].setTicketKeys(new Buffer(50));
+}, TypeError);
+
+function connect(i, session, cb) {
+  var client = tls.connect({
+    port: common.PORT + i,
+    rejectUnauthorized: false,
+    session: session
+  }, function() {
+    var reused = client.isSessionReused();
+    var session = client.getSession();
+    client.on('close', function() {
+      cb(reused, session);
+    });
+  });
+  client.resume();
+}
+
+var steps = 0;
+
+servers[0].listen(common.PORT, function() {
+  servers[1].listen(common.PORT + 1, function() {
+    connect(0, null, function(reused, session) {
+      assert(!reused);
+
+      connect(1, session, function(reused) {
+        assert(reused);
+        steps++;
+
+        // Rotated: tickets made with the old key still work.
+        servers[1].setTicketKeys(Buffer.concat([newKey, oldKey]));
+        connect(1, session, function(reused, renewed) {
+          assert(reused);
+          steps++;
+
+          // Retired: only the renewed ticket is accepted.
+          servers[1].setTicketKeys(newKey);
+          connect(1, session, function(reused) {
+            assert(!reused);
+            connect(1, renewed, function(reused) {
+              assert(reused);
+              steps++;
+              servers[0].close();
+              servers[1].close();
+            });
+          });
+        });
+      });
+    });
+  });
+});
+
+process.on('exit', function() {
+  assert.equal(steps, 3);
+});
@@ -0,0 +1,141 @@
+// Copyright Joyent, Inc. and other Node contributors.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+var common = require('../common');
+var assert = require('assert');
+var fs = require('fs');
+var path = require('path');
+var execFile = require('child_process').execFile;
+
+var cacheDir = path.join(common.tmpDir, 'compile-cache');
+
+if (fs.existsSync(cacheDir)) {
+  fs.readdirSync(cacheDir).forEach(function(name) {
+    fs.unlinkSync(path.join(cacheDir, name));
+  });
+  fs.rmdirSync(cacheDir);
+}
+
+// A script with enough top-level functions for V8 to preparse it.
+var source = [];
+for (var i = 0; i < 200; i++)
+  source.push('function f' + i + '(x) { return x + ' + i + '; }');
+source.push('f199(1)');
+
+var child = [
+  'var vm = require("vm");',
+  'var result = vm.runInThisContext(' + JSON.stringify(source.join('\n')) +
+      ', "cached.js");',
+  'var script = vm.createScript(' + JSON.stringify(source.join(';\n')) +
+      ', "cached2.js");',
+  'console.log(result + script.runInNewContext());',
+  'try {',
+  '  vm.runInThisContext("var x = ;" + Array(2000).join(" "), "bad.js");',
+  '} catch (e) {',
+  '  console.log(e.name);',
+  '}'
+].join('\n');
+
+var env = {};
+for (var key in process.env)
+  env[key] = process.env[key];
+env.NODE_COMPILE_CACHE = cacheDir;
+
+function run(callback) {
+  execFile(process.execPath, ['-e', child], { env: env },
+           function(err, stdout, stderr) {
+    assert.ifError(err);
+    assert.equal(stdout, '400\nSyntaxError\n');
+    callback();
+  });
+}
+
+function entries() {
+  return fs.readdirSync(cacheDir).filter(function(name) {
+    return !/\.tmp$/.test(name);
+  });
+}
+
+function snapshot(names) {
+  var result = {};
+  names.forEach(function(name) {
+    var file = path.join(cacheDir, name);
+    result[name] = { ino: fs.statSync(file).ino, data: fs.readFileSync(file) };
+  });
+  return result;
+}
+
+var done = false;
+
+run(function() {
+  // One entry per script, nothing for the one that doesn't parse.
+  var names = entries();
+  assert.ok(names.length >= 2);
+  var first = snapshot(names);
+
+  run(function() {
+    // Every entry was a hit: a miss writes a new file and renames it over
+    // the old one, which would change the inode.
+    assert.deepEqual(entries(), names);
+    names.forEach(function(name) {
+      var file = path.join(cacheDir, name);
+      assert.equal(fs.statSync(file).ino, first[name].ino, name);
+    });
+
+    // Damage the preparse data of each entry but leave the header alone.
+    // The entry must not reach V8, and is regenerated.
+    names.forEach(function(name) {
+      var data = new Buffer(first[name].data);
+      for (var i = data.length - 8; i < data.length; i++)
+        data[i] ^= 0xff;
+      fs.writeFileSync(path.join(cacheDir, name), data);
+    });
+
+    run(function() {
+      assert.deepEqual(entries(), names);
+      var regenerated = snapshot(names);
+      names.forEach(function(name) {
+        assert.notEqual(regenerated[name].ino, first[name].ino, name);
+        assert.equal(regenerated[name].data.toString('hex'),
+                     first[name].data.toString('hex'),
+                     name);
+      });
+
+      // Entries that aren't even complete are replaced too.
+      names.forEach(function(name) {
+        fs.writeFileSync(path.join(cacheDir, name), 'garbage');
+      });
+
+      run(function() {
+        var replaced = snapshot(names);
+        names.forEach(function(name) {
+          assert.equal(replaced[name].data.toString('hex'),
+                       first[name].data.toString('hex'),
+                       name);
+        });
+        done = true;
+      });
+    });
+  });
+});
+
+process.on('exit', function() {
+  assert.ok(done);
+});
@@ -0,0 +1,102 @@
+#!/usr/bin/env python
+#
+# Builds the V8 startup snapshot for node binaries configured with
+# --with-core-snapshot.
+#
+# Usage: mksnapshot.py <mksnapshot> <scripts dir> <snapshot.cc>
+#                      [--mksnapshot-flag ...] <source files and macros>
+#
+# Every JavaScript library file is macro-expanded exactly like tools/js2c.py
+# does for node_natives.h, wrapped the way NativeModule.wrap() wraps it, and
+# written to <scripts dir> as a script that hands the wrapper function to
+# the global __nodeSnapshot() function. mksnapshot runs all of those scripts
+# before it serializes the heap, so the compiled functions end up in the
+# snapshot. node::Load() and NativeModule take them from there at startup.
+#
+# The wrapper is parenthesized so that V8 compiles it eagerly instead of
+# only preparsing it. It is passed as a call argument rather than assigned
+# to a property, which would show up in the names V8 infers for the
+# functions inside. Line numbers are preserved: the prefix goes on the first
+# line of each script, just like the NativeModule wrapper.
+
+import os
+import subprocess
+import sys
+
+import js2c
+
+
+PROLOGUE = """\
+this.__nodeSnapshot = function(id, fn) { __nodeSnapshot.modules[id] = fn; };
+__nodeSnapshot.modules = {};
+"""
+
+MAIN_TEMPLATE = "__nodeSnapshot('%(id)s', %(source)s);\n"
+
+MODULE_TEMPLATE = "__nodeSnapshot('%(id)s', " \
+    "(function (exports, require, module, __filename, __dirname) { " \
+    "%(source)s\n}));\n"
+
+
+def WriteScript(filename, contents):
+  output = open(filename, "w")
+  try:
+    output.write(contents)
+  finally:
+    output.close()
+
+
+def MakeScripts(sources, outdir):
+  macro_lines = []
+  modules = []
+  for s in sources:
+    if os.path.basename(s).endswith('macros.py'):
+      macro_lines.extend(js2c.ReadLines(s))
+    elif s.endswith('.js'):
+      modules.append(s)
+
+  (consts, macros) = js2c.ReadMacros(macro_lines)
+
+  if not os.path.isdir(outdir):
+    os.makedirs(outdir)
+
+  prologue = os.path.join(outdir, '_snapshot_prologue.js')
+  WriteScript(prologue, PROLOGUE)
+  scripts = [prologue]
+
+  for s in modules:
+    lines = js2c.ReadFile(s)
+    lines = js2c.ExpandConstants(lines, consts)
+    lines = js2c.ExpandMacros(lines, macros)
+    id = os.path.basename(s).split('.')[0]
+
+    # src/node.js is a single function expression, not a module body.
+    if id == 'node':
+      template = MAIN_TEMPLATE
+      lines = lines.rstrip().rstrip(';')
+    else:
+      template = MODULE_TEMPLATE
+
+    # mksnapshot names each script after its file, so stack traces keep
+    # pointing at fs.js rather than at a generated name.
+    script = os.path.join(outdir, id + '.js')
+    WriteScript(script, template % { 'id': id, 'source': lines })
+    scripts.append(script)
+
+  return scripts
+
+
+def main():
+  mksnapshot = sys.argv[1]
+  outdir = sys.argv[2]
+  target = sys.argv[3]
+  flags = [arg for arg in sys.argv[4:] if arg.startswith('--')]
+  sources = [arg for arg in sys.argv[4:] if not arg.startswith('--')]
+
+  scripts = MakeScripts(sources, outdir)
+  args = [mksnapshot] + flags + ['--extra_code', ','.join(scripts), target]
+  sys.exit(subprocess.call(args))
+
+
+if __name__ == "__main__":
+  main()